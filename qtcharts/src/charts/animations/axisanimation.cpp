@@ -30,6 +30,7 @@
 #include <private/axisanimation_p.h>
 #include <private/chartaxiselement_p.h>
 #include <private/qabstractaxis_p.h>
+#include <private/chartpresenter_p.h>
 
 Q_DECLARE_METATYPE(QVector<qreal>)
 
@@ -136,11 +137,22 @@ QVariant AxisAnimation::interpolated(const QVariant &start, const QVariant &end,
 void AxisAnimation::updateCurrentValue(const QVariant &value)
 {
     if (state() != QAbstractAnimation::Stopped) { //workaround
-        QVector<qreal> vector = qvariant_cast<QVector<qreal> >(value);
-        m_axis->setLayout(vector);
-        m_axis->updateGeometry();
+        m_frameLayout = qvariant_cast<QVector<qreal> >(value);
+        requestFrame(m_axis->presenter());
     }
 
 }
 
+void AxisAnimation::updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState)
+{
+    if (oldState == QAbstractAnimation::Running && newState == QAbstractAnimation::Stopped)
+        updateFrame();
+}
+
+void AxisAnimation::applyFrame()
+{
+    m_axis->setLayout(m_frameLayout);
+    m_axis->updateGeometry();
+}
+
 QT_CHARTS_END_NAMESPACE
@@ -59,10 +59,13 @@ public:
 protected:
     QVariant interpolated(const QVariant &from, const QVariant &to, qreal progress) const;
     void updateCurrentValue(const QVariant &value);
+    void updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState);
+    void applyFrame();
 private:
     ChartAxisElement *m_axis;
     Animation m_type;
     QPointF m_point;
+    QVector<qreal> m_frameLayout;
 };
 
 QT_CHARTS_END_NAMESPACE
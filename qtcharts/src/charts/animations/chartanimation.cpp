@@ -28,12 +28,14 @@
 ****************************************************************************/
 
 #include <private/chartanimation_p.h>
+#include <private/chartpresenter_p.h>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
 ChartAnimation::ChartAnimation(QObject *parent) :
     QVariantAnimation(parent),
-    m_destructing(false)
+    m_destructing(false),
+    m_framePending(false)
 {
 }
 
@@ -50,6 +52,31 @@ void ChartAnimation::startChartAnimation()
         start();
 }
 
+/*!
+  Marks the current value as not yet applied and asks \a presenter to apply it in its next
+  frame update, together with the other animations of the chart advanced by the same timer
+  tick. Without a presenter the value is applied immediately.
+  */
+void ChartAnimation::requestFrame(ChartPresenter *presenter)
+{
+    m_framePending = true;
+    if (presenter)
+        presenter->requestAnimationFrame(this);
+    else
+        updateFrame();
+}
+
+/*!
+  Applies the value recorded by the last requestFrame() call, if it has not been applied yet.
+  */
+void ChartAnimation::updateFrame()
+{
+    if (!m_framePending || m_destructing)
+        return;
+    m_framePending = false;
+    applyFrame();
+}
+
 QT_CHARTS_END_NAMESPACE
 
 
@@ -45,6 +45,8 @@
 
 QT_CHARTS_BEGIN_NAMESPACE
 
+class ChartPresenter;
+
 const static int ChartAnimationDuration = 1000;
 
 class QT_CHARTS_PRIVATE_EXPORT ChartAnimation: public QVariantAnimation
@@ -54,12 +56,18 @@ public:
     ChartAnimation(QObject *parent = 0);
 
     void stopAndDestroyLater();
+    void updateFrame();
 
 public Q_SLOTS:
     void startChartAnimation();
 
+protected:
+    void requestFrame(ChartPresenter *presenter);
+    virtual void applyFrame() {}
+
 protected:
     bool m_destructing;
+    bool m_framePending;
 };
 
 QT_CHARTS_END_NAMESPACE
@@ -30,9 +30,7 @@
 #include <private/splineanimation_p.h>
 #include <private/splinechartitem_p.h>
 #include <QtCore/QDebug>
-
-Q_DECLARE_METATYPE(QVector<QPointF>)
-Q_DECLARE_METATYPE(SplineVector)
+#include <algorithm>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
@@ -94,16 +92,15 @@ void SplineAnimation::setup(QVector<QPointF> &oldPoints, QVector<QPointF> &newPo
         m_type = RemovePointAnimation;
     }
 
-    if (x - y == -1 && index >= 0) {
-        //add point
+    if (x - y < 0 && x > 0 && index >= 0 && index <= x) {
+        //add point(s), a block of points added at once is animated as a single insertion
+        const int added = y - x;
         if (index > 0) {
-            m_oldSpline.first.insert(index, newPoints[index - 1]);
-            m_oldSpline.second.insert((index - 1) * 2, newPoints[index - 1]);
-            m_oldSpline.second.insert((index - 1) * 2 + 1, newPoints[index - 1]);
+            m_oldSpline.first.insert(index, added, newPoints[index - 1]);
+            m_oldSpline.second.insert((index - 1) * 2, 2 * added, newPoints[index - 1]);
         } else {
-            m_oldSpline.first.insert(0, newPoints[index]);
-            m_oldSpline.second.insert(0, newPoints[index]);
-            m_oldSpline.second.insert(1, newPoints[index]);
+            m_oldSpline.first.insert(0, added, newPoints[index]);
+            m_oldSpline.second.insert(0, 2 * added, newPoints[index]);
         }
         m_index = index;
         m_type = AddPointAnimation;
@@ -119,73 +116,59 @@ void SplineAnimation::setup(QVector<QPointF> &oldPoints, QVector<QPointF> &newPo
     }
 
 
-    setKeyValueAt(0.0, qVariantFromValue(m_oldSpline));
-    setKeyValueAt(1.0, qVariantFromValue(m_newSpline));
+    // As in XYAnimation, only the progress is animated as a value
+    setKeyValueAt(0.0, qreal(0));
+    setKeyValueAt(1.0, qreal(1));
 
     m_valid = true;
 
 }
 
-QVariant SplineAnimation::interpolated(const QVariant &start, const QVariant &end, qreal progress) const
+/*!
+  Writes the frame at \a progress to the reused point and control point buffers. Returns false
+  if the stored splines do not fit the animation type.
+  */
+bool SplineAnimation::interpolateSpline(qreal progress)
 {
-
-    SplineVector startPair = qvariant_cast< SplineVector >(start);
-    SplineVector endPair = qvariant_cast< SplineVector >(end);
-    SplineVector result;
-
-    switch (animationType()) {
-    case RemovePointAnimation:
-    case AddPointAnimation:
-    case ReplacePointAnimation: {
-        if (startPair.first.count() != endPair.first.count())
-            break;
-        Q_ASSERT(startPair.first.count() * 2 - 2 == startPair.second.count());
-        Q_ASSERT(endPair.first.count() * 2 - 2 == endPair.second.count());
-        for (int i = 0; i < endPair.first.count(); i++) {
-            qreal x = startPair.first[i].x() + ((endPair.first[i].x() - startPair.first[i].x()) * progress);
-            qreal y = startPair.first[i].y() + ((endPair.first[i].y() - startPair.first[i].y()) * progress);
-            result.first << QPointF(x, y);
-            if (i + 1 >= endPair.first.count())
-                continue;
-            x = startPair.second[i * 2].x() + ((endPair.second[i * 2].x() - startPair.second[i * 2].x()) * progress);
-            y = startPair.second[i * 2].y() + ((endPair.second[i * 2].y() - startPair.second[i * 2].y()) * progress);
-            result.second << QPointF(x, y);
-            x = startPair.second[i * 2 + 1].x() + ((endPair.second[i * 2 + 1].x() - startPair.second[i * 2 + 1].x()) * progress);
-            y = startPair.second[i * 2 + 1].y() + ((endPair.second[i * 2 + 1].y() - startPair.second[i * 2 + 1].y()) * progress);
-            result.second << QPointF(x, y);
-        }
-    }
-    break;
-    case NewAnimation: {
-        Q_ASSERT(endPair.first.count() * 2 - 2 == endPair.second.count());
-        int count = endPair.first.count() * qBound(qreal(0), progress, qreal(1));
-        for (int i = 0; i < count; i++) {
-            result.first << endPair.first[i];
-            if (i + 1 == count)
-                break;
-            result.second << endPair.second[2 * i];
-            result.second << endPair.second[2 * i + 1];
-        }
-    }
-    break;
-    default:
-        qWarning() << "Unknown type of animation";
-        break;
+    if (animationType() == NewAnimation) {
+        if (!interpolatePoints(m_oldSpline.first, m_newSpline.first, progress, m_framePoints))
+            return false;
+        // Each point after the first adds the two control points of the segment leading to it
+        const int controlCount = qMax(2 * m_framePoints.count() - 2, 0);
+        if (controlCount > m_newSpline.second.count())
+            return false;
+        m_frameControlPoints.resize(controlCount);
+        std::copy(m_newSpline.second.constBegin(), m_newSpline.second.constBegin() + controlCount,
+                  m_frameControlPoints.begin());
+        return true;
     }
 
-    return qVariantFromValue(result);
+    return interpolatePoints(m_oldSpline.first, m_newSpline.first, progress, m_framePoints)
+            && interpolatePoints(m_oldSpline.second, m_newSpline.second, progress,
+                                 m_frameControlPoints);
 }
 
 void SplineAnimation::updateCurrentValue(const QVariant &value)
 {
     if (state() != QAbstractAnimation::Stopped && m_valid) { //workaround
-        QPair<QVector<QPointF >, QVector<QPointF > > pair = qvariant_cast< QPair< QVector<QPointF>, QVector<QPointF> > >(value);
-        m_item->setGeometryPoints(pair.first);
-        m_item->setControlGeometryPoints(pair.second);
-        m_item->updateGeometry();
-        m_item->setDirty(true);
-        m_dirty = false;
+        m_frameProgress = value.toReal();
+        requestFrame(m_item->presenter());
+    }
+}
+
+void SplineAnimation::applyFrame()
+{
+    if (!m_valid)
+        return;
+    if (!interpolateSpline(m_frameProgress)) {
+        m_framePoints.clear();
+        m_frameControlPoints.clear();
     }
+    m_item->swapGeometryPoints(m_framePoints);
+    m_item->swapControlGeometryPoints(m_frameControlPoints);
+    m_item->updateGeometry();
+    m_item->setDirty(true);
+    m_dirty = false;
 }
 
 void SplineAnimation::updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState)
@@ -57,13 +57,16 @@ public:
     void setup(QVector<QPointF> &oldPoints, QVector<QPointF> &newPoints, QVector<QPointF> &oldContorlPoints, QVector<QPointF> &newControlPoints, int index = -1);
 
 protected:
-    QVariant interpolated(const QVariant &start, const QVariant &end, qreal progress) const;
     void updateCurrentValue(const QVariant &value);
     void updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState);
+    void applyFrame();
 
 private:
+    bool interpolateSpline(qreal progress);
+
     SplineVector m_oldSpline;
     SplineVector m_newSpline;
+    QVector<QPointF> m_frameControlPoints;
     SplineChartItem *m_item;
     bool m_valid;
 };
@@ -29,17 +29,70 @@
 
 #include <private/xyanimation_p.h>
 #include <private/xychart_p.h>
+#include <private/chartpresenter_p.h>
 #include <QtCore/QDebug>
-
-Q_DECLARE_METATYPE(QVector<QPointF>)
+#include <QtCore/QtMath>
+#include <QtCore/private/qsimd_p.h>
+#include <algorithm>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
+// There are no vector implementations for a float qreal
+#if !defined(QT_QREAL_IS_FLOAT) && defined(__SSE2__)
+#  define XYANIMATION_SSE2
+#endif
+#if !defined(QT_QREAL_IS_FLOAT) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+#  define XYANIMATION_AVX2
+#endif
+
+namespace {
+
+void interpolateScalar(const qreal *start, const qreal *end, int count, qreal progress,
+                       qreal *result, int i = 0)
+{
+    for (; i < count; ++i)
+        result[i] = start[i] + ((end[i] - start[i]) * progress);
+}
+
+#ifdef XYANIMATION_SSE2
+void interpolateSse2(const qreal *start, const qreal *end, int count, qreal progress,
+                     qreal *result)
+{
+    const __m128d t = _mm_set1_pd(progress);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d s = _mm_loadu_pd(start + i);
+        const __m128d e = _mm_loadu_pd(end + i);
+        _mm_storeu_pd(result + i, _mm_add_pd(s, _mm_mul_pd(_mm_sub_pd(e, s), t)));
+    }
+    interpolateScalar(start, end, count, progress, result, i);
+}
+#endif
+
+#ifdef XYANIMATION_AVX2
+QT_FUNCTION_TARGET(AVX2)
+void interpolateAvx2(const qreal *start, const qreal *end, int count, qreal progress,
+                     qreal *result)
+{
+    const __m256d t = _mm256_set1_pd(progress);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d s = _mm256_loadu_pd(start + i);
+        const __m256d e = _mm256_loadu_pd(end + i);
+        _mm256_storeu_pd(result + i, _mm256_add_pd(s, _mm256_mul_pd(_mm256_sub_pd(e, s), t)));
+    }
+    interpolateScalar(start, end, count, progress, result, i);
+}
+#endif
+
+} // namespace
+
 XYAnimation::XYAnimation(XYChart *item, int duration, QEasingCurve &curve)
     : ChartAnimation(item),
       m_type(NewAnimation),
       m_dirty(false),
       m_index(-1),
+      m_frameProgress(0),
       m_item(item)
 {
     setDuration(duration);
@@ -82,9 +135,9 @@ void XYAnimation::setup(const QVector<QPointF> &oldPoints, const QVector<QPointF
         m_type = RemovePointAnimation;
     }
 
-    if (diff == -1 && requestedDiff == -1 && index >= 0 && index <= x) {
-        //add point
-        m_oldPoints.insert(index, index > 0 ? newPoints[index - 1] : newPoints[index]);
+    if (diff < 0 && requestedDiff == diff && index >= 0 && index <= x) {
+        //add point(s), a block of points added at once is animated as a single insertion
+        m_oldPoints.insert(index, -diff, index > 0 ? newPoints[index - 1] : newPoints[index]);
         m_index = index;
         m_type = AddPointAnimation;
     }
@@ -97,61 +150,92 @@ void XYAnimation::setup(const QVector<QPointF> &oldPoints, const QVector<QPointF
     else if (m_type == NewAnimation)
         m_type = ReplacePointAnimation;
 
-    setKeyValueAt(0.0, qVariantFromValue(m_oldPoints));
-    setKeyValueAt(1.0, qVariantFromValue(m_newPoints));
+    // The animated value is the eased progress only; the points are interpolated from the
+    // stored vectors into a reused frame buffer instead of going through QVariant.
+    setKeyValueAt(0.0, qreal(0));
+    setKeyValueAt(1.0, qreal(1));
 }
 
-QVariant XYAnimation::interpolated(const QVariant &start, const QVariant &end, qreal progress) const
+/*!
+  Writes \a count points linearly interpolated between \a start and \a end at \a progress to
+  \a result, using vector instructions where available.
+  */
+void XYAnimation::interpolate(const QPointF *start, const QPointF *end, int count, qreal progress,
+                              QPointF *result)
 {
-    QVector<QPointF> startVector = qvariant_cast<QVector<QPointF> >(start);
-    QVector<QPointF> endVector = qvariant_cast<QVector<QPointF> >(end);
-    QVector<QPointF> result;
+    const qreal *s = reinterpret_cast<const qreal *>(start);
+    const qreal *e = reinterpret_cast<const qreal *>(end);
+    qreal *r = reinterpret_cast<qreal *>(result);
+#ifdef XYANIMATION_AVX2
+    if (qCpuHasFeature(AVX2)) {
+        interpolateAvx2(s, e, 2 * count, progress, r);
+        return;
+    }
+#endif
+#ifdef XYANIMATION_SSE2
+    interpolateSse2(s, e, 2 * count, progress, r);
+#else
+    interpolateScalar(s, e, 2 * count, progress, r);
+#endif
+}
 
+/*!
+  Writes the frame of \a start and \a end at \a progress to \a result. The storage of \a result
+  is reused when it is not shared. Returns false if the vectors do not fit the animation type.
+  */
+bool XYAnimation::interpolatePoints(const QVector<QPointF> &start, const QVector<QPointF> &end,
+                                    qreal progress, QVector<QPointF> &result) const
+{
     switch (m_type) {
-
     case ReplacePointAnimation:
     case AddPointAnimation:
-    case RemovePointAnimation: {
-        if (startVector.count() != endVector.count())
-            break;
-
-        for (int i = 0; i < startVector.count(); i++) {
-            qreal x = startVector[i].x() + ((endVector[i].x() - startVector[i].x()) * progress);
-            qreal y = startVector[i].y() + ((endVector[i].y() - startVector[i].y()) * progress);
-            result << QPointF(x, y);
-        }
-
-    }
-    break;
+    case RemovePointAnimation:
+        if (start.count() != end.count())
+            return false;
+        result.resize(end.count());
+        interpolate(start.constData(), end.constData(), end.count(), progress, result.data());
+        return true;
     case NewAnimation: {
-        for (int i = 0; i < endVector.count() * qBound(qreal(0), progress, qreal(1)); i++)
-            result << endVector[i];
+        const int count = qCeil(end.count() * qBound(qreal(0), progress, qreal(1)));
+        result.resize(count);
+        std::copy(end.constBegin(), end.constBegin() + count, result.begin());
+        return true;
     }
-    break;
     default:
         qWarning() << "Unknown type of animation";
-        break;
+        return false;
     }
-
-    return qVariantFromValue(result);
 }
 
 void XYAnimation::updateCurrentValue(const QVariant &value)
 {
     if (state() != QAbstractAnimation::Stopped) { //workaround
-
-        QVector<QPointF> vector = qvariant_cast<QVector<QPointF> >(value);
-        m_item->setGeometryPoints(vector);
-        m_item->updateGeometry();
-        m_item->setDirty(true);
-        m_dirty = false;
-
+        // Only the progress is recorded here; the frame is interpolated when the presenter
+        // applies the frames of all animations advanced by this timer tick.
+        m_frameProgress = value.toReal();
+        requestFrame(m_item->presenter());
     }
 }
 
+void XYAnimation::applyFrame()
+{
+    if (!interpolatePoints(m_oldPoints, m_newPoints, m_frameProgress, m_framePoints))
+        m_framePoints.clear();
+    // Hand the frame to the item and take back its previous points; once the item has
+    // updated its geometry nothing else refers to them, so the next frame is written
+    // into the same storage.
+    m_item->swapGeometryPoints(m_framePoints);
+    m_item->updateGeometry();
+    m_item->setDirty(true);
+    m_dirty = false;
+}
+
 void XYAnimation::updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState)
 {
     if (oldState == QAbstractAnimation::Running && newState == QAbstractAnimation::Stopped) {
+        // The last value, or the one current when the animation is interrupted, is applied
+        // before anything else looks at the item's points.
+        updateFrame();
         if (m_item->isDirty() && m_type == RemovePointAnimation) {
             if (!m_newPoints.isEmpty())
                 m_newPoints.remove(m_index);
@@ -58,14 +58,20 @@ public:
     Animation animationType() const { return m_type; };
 
 protected:
-    QVariant interpolated(const QVariant &start, const QVariant &end, qreal progress) const;
     void updateCurrentValue(const QVariant &value);
     void updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState);
+    void applyFrame();
     XYChart *chartItem() { return m_item; }
+    bool interpolatePoints(const QVector<QPointF> &start, const QVector<QPointF> &end,
+                           qreal progress, QVector<QPointF> &result) const;
+    static void interpolate(const QPointF *start, const QPointF *end, int count, qreal progress,
+                            QPointF *result);
 protected:
     Animation m_type;
     bool m_dirty;
     int m_index;
+    qreal m_frameProgress;
+    QVector<QPointF> m_framePoints;
 private:
     XYChart *m_item;
     QVector<QPointF> m_oldPoints;
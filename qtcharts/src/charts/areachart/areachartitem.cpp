@@ -34,9 +34,11 @@
 #include <private/chartpresenter_p.h>
 #include <private/abstractdomain_p.h>
 #include <private/chartdataset_p.h>
+#include <private/charthelpers_p.h>
 #include <QtGui/QPainter>
 #include <QtWidgets/QGraphicsSceneMouseEvent>
 #include <QtCore/QDebug>
+#include <algorithm>
 
 
 QT_CHARTS_BEGIN_NAMESPACE
@@ -47,6 +49,8 @@ AreaChartItem::AreaChartItem(QAreaSeries *areaSeries, QGraphicsItem* item)
       m_series(areaSeries), // 所属序列
       m_upper(0), // 上限图表项
       m_lower(0), // 下限图表项
+      m_pathValid(true), // 路径是否有效
+      m_fillPolygon(false), // 是否以多边形填充
       m_pointsVisible(false), // 点集是否可见
       m_pointLabelsVisible(false), // 点标签是否可见
       m_pointLabelsFormat(areaSeries->pointLabelsFormat()), // 点标签格式
@@ -144,12 +148,27 @@ QRectF AreaChartItem::boundingRect() const
 // 获取形状
 QPainterPath AreaChartItem::shape() const
 {
+    if (!m_pathValid) {
+        m_path = QPainterPath();
+        m_path.addPolygon(QPolygonF(m_fillPoints));
+        m_path.closeSubpath();
+        m_pathValid = true;
+    }
     return m_path;
 }
 
 // 更新路径
 void AreaChartItem::updatePath()
 {
+    // 直角坐标中由边界点集直接构建填充多边形
+    if (presenter() && presenter()->chartType() == QChart::ChartTypeCartesian && updateFillPolygon())
+        return;
+
+    m_fillPolygon = false;
+    m_fillPoints.clear();
+    m_upperPoints.clear();
+    m_lowerPoints.clear();
+
     QPainterPath path;
     QRectF rect(QPointF(0,0),domain()->size());
 
@@ -188,11 +207,126 @@ void AreaChartItem::updatePath()
             && path.boundingRect().width() <= INT_MAX) {
         prepareGeometryChange();
         m_path = path;
+        m_pathValid = true;
         m_rect = path.boundingRect();
         update();
     }
 }
 
+// 比较边界点集与上次记录的点集，unchanged返回未变的前缀长度，并记录新点集。只在尾部追加点时
+// 合并原外接矩形与新增点，否则重新计算。有断点时返回false
+bool AreaChartItem::updateEdge(const QVector<QPointF> &points, QVector<QPointF> &edge,
+                               QRectF &rect, int &unchanged)
+{
+    // 边界图形项未更新时点集共享数据
+    if (points.constData() == edge.constData() && points.count() == edge.count()) {
+        unchanged = points.count();
+        return true;
+    }
+
+    const int common = qMin(points.count(), edge.count());
+    unchanged = 0;
+    while (unchanged < common && points.at(unchanged).x() == edge.at(unchanged).x()
+           && points.at(unchanged).y() == edge.at(unchanged).y()) {
+        unchanged++;
+    }
+
+    int first = 0;
+    qreal left = 0, top = 0, right = 0, bottom = 0;
+    if (unchanged > 0 && unchanged == edge.count()) {
+        first = unchanged;
+        left = rect.left();
+        top = rect.top();
+        right = rect.right();
+        bottom = rect.bottom();
+    } else if (!points.isEmpty()) {
+        left = right = points.first().x();
+        top = bottom = points.first().y();
+    }
+    // 前缀与上次的点集相同，其中没有断点
+    for (int i = first; i < points.count(); ++i) {
+        const QPointF &point = points.at(i);
+        if (isGapPoint(point))
+            return false;
+        left = qMin(left, point.x());
+        right = qMax(right, point.x());
+        top = qMin(top, point.y());
+        bottom = qMax(bottom, point.y());
+    }
+
+    edge = points;
+    rect = points.isEmpty() ? QRectF() : QRectF(QPointF(left, top), QPointF(right, bottom));
+    return true;
+}
+
+// 由上、下界图形项的（抽稀后）几何点集一次构建填充多边形，代替复制、反转、连接路径。
+// 上界点集只重写变化的部分；下界点集逆序接在上界之后，在下界变化或者上界点数变化时重写
+bool AreaChartItem::updateFillPolygon()
+{
+    QVector<QPointF> upperPoints = m_upperPoints;
+    QVector<QPointF> lowerPoints = m_lowerPoints;
+    QRectF upperRect = m_upperRect;
+    QRectF lowerRect = m_lowerRect;
+    int upperUnchanged = 0;
+    int lowerUnchanged = 0;
+    if (m_upper && !updateEdge(m_upper->pathPoints(), upperPoints, upperRect, upperUnchanged))
+        return false;
+    if (m_lower && !updateEdge(m_lower->pathPoints(), lowerPoints, lowerRect, lowerUnchanged))
+        return false;
+    if (!m_upper)
+        upperPoints.clear();
+    if (!m_upper || !m_lower)
+        lowerPoints.clear();
+
+    const int upperCount = upperPoints.count();
+    const int lowerCount = lowerPoints.count();
+    QRectF rect = upperCount > 0 ? upperRect : (lowerCount > 0 ? lowerRect : QRectF());
+    if (upperCount > 0 && lowerCount > 0) {
+        rect = QRectF(QPointF(qMin(rect.left(), lowerRect.left()), qMin(rect.top(), lowerRect.top())),
+                      QPointF(qMax(rect.right(), lowerRect.right()),
+                              qMax(rect.bottom(), lowerRect.bottom())));
+    }
+    const qreal baseline = domain()->size().height();
+    if (upperCount > 0 && !m_lower) {
+        rect = QRectF(QPointF(rect.left(), qMin(rect.top(), baseline)),
+                      QPointF(rect.right(), qMax(rect.bottom(), baseline)));
+    }
+
+    // Only zoom in if the bounding rect of the path fits inside int limits. QWidget::update() uses
+    // a region that has to be compatible with QRect.
+    if (rect.height() > INT_MAX || rect.width() > INT_MAX)
+        return true;
+
+    const bool rebuild = !m_fillPolygon;
+    const bool lowerMoved = rebuild || upperCount != m_upperPoints.count()
+            || lowerCount != m_lowerPoints.count() || lowerUnchanged != lowerCount;
+    const int tailCount = m_lower ? lowerCount : (upperCount > 0 ? 2 : 0);
+    m_fillPoints.resize(upperCount + tailCount);
+    QPointF *fill = m_fillPoints.data();
+    std::copy(upperPoints.cbegin() + (rebuild ? 0 : qMin(upperUnchanged, upperCount)),
+              upperPoints.cend(), fill + (rebuild ? 0 : qMin(upperUnchanged, upperCount)));
+    if (m_lower) {
+        if (lowerMoved)
+            std::reverse_copy(lowerPoints.cbegin(), lowerPoints.cend(), fill + upperCount);
+    } else if (upperCount > 0) {
+        fill[upperCount] = QPointF(upperPoints.last().x(), baseline);
+        fill[upperCount + 1] = QPointF(upperPoints.first().x(), baseline);
+    }
+
+    m_upperPoints = upperPoints;
+    m_lowerPoints = lowerPoints;
+    m_upperRect = upperRect;
+    m_lowerRect = lowerRect;
+
+    prepareGeometryChange();
+    m_fillPolygon = true;
+    m_path = QPainterPath();
+    m_pathValid = false;
+    m_rect = rect;
+    update();
+    return true;
+}
+
 // 更新信号响应槽
 void AreaChartItem::handleUpdated()
 {
@@ -253,7 +387,10 @@ void AreaChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *opt
     else
         painter->setClipRect(clipRect);
 
-    painter->drawPath(m_path);
+    if (m_fillPolygon)
+        painter->drawPolygon(m_fillPoints.constData(), m_fillPoints.count());
+    else
+        painter->drawPath(m_path);
     if (m_pointsVisible) {
         painter->setPen(m_pointPen);
         if (m_upper)
@@ -280,16 +417,19 @@ void AreaChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *opt
         QString pointLabel;
 
         if (m_series->upperSeries()) {
-            for (int i(0); i < m_series->upperSeries()->count(); i++) {
+            const QVector<QPointF> points = m_upper->geometryPoints();
+            const int firstIndex = m_upper->firstIndex();
+            const XYSeriesBuffer &buffer = m_upper->geometrySource();
+            const int count = qMin(points.size(), buffer.count() - firstIndex);
+            for (int i(0); i < count; i++) {
+                const QPointF value = buffer.at(firstIndex + i);
                 pointLabel = m_pointLabelsFormat;
-                pointLabel.replace(xPointTag,
-                                   presenter()->numberToString(m_series->upperSeries()->at(i).x()));
-                pointLabel.replace(yPointTag,
-                                   presenter()->numberToString(m_series->upperSeries()->at(i).y()));
+                pointLabel.replace(xPointTag, presenter()->numberToString(value.x()));
+                pointLabel.replace(yPointTag, presenter()->numberToString(value.y()));
 
                 // Position text in relation to the point
                 int pointLabelWidth = fm.width(pointLabel);
-                QPointF position(m_upper->geometryPoints().at(i));
+                QPointF position(points.at(i));
                 position.setX(position.x() - pointLabelWidth / 2);
                 position.setY(position.y() - m_series->upperSeries()->pen().width() / 2
                               - labelOffset);
@@ -298,16 +438,19 @@ void AreaChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *opt
         }
 
         if (m_series->lowerSeries()) {
-            for (int i(0); i < m_series->lowerSeries()->count(); i++) {
+            const QVector<QPointF> points = m_lower->geometryPoints();
+            const int firstIndex = m_lower->firstIndex();
+            const XYSeriesBuffer &buffer = m_lower->geometrySource();
+            const int count = qMin(points.size(), buffer.count() - firstIndex);
+            for (int i(0); i < count; i++) {
+                const QPointF value = buffer.at(firstIndex + i);
                 pointLabel = m_pointLabelsFormat;
-                pointLabel.replace(xPointTag,
-                                   presenter()->numberToString(m_series->lowerSeries()->at(i).x()));
-                pointLabel.replace(yPointTag,
-                                   presenter()->numberToString(m_series->lowerSeries()->at(i).y()));
+                pointLabel.replace(xPointTag, presenter()->numberToString(value.x()));
+                pointLabel.replace(yPointTag, presenter()->numberToString(value.y()));
 
                 // Position text in relation to the point
                 int pointLabelWidth = fm.width(pointLabel);
-                QPointF position(m_lower->geometryPoints().at(i));
+                QPointF position(points.at(i));
                 position.setX(position.x() - pointLabelWidth / 2);
                 position.setY(position.y() - m_series->lowerSeries()->pen().width() / 2
                               - labelOffset);
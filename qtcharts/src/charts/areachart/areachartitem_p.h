@@ -64,6 +64,7 @@ public:
 
     LineChartItem *upperLineItem() const { return m_upper; } // 上限图形项
     LineChartItem *lowerLineItem() const { return m_lower; } // 下限图形项
+    const QVector<QPointF> &fillPoints() const { return m_fillPoints; } // 填充多边形，不以多边形填充时为空
 
     void updatePath(); // 更新路径
 
@@ -93,11 +94,21 @@ public Q_SLOTS:
 
 private:
     void fixEdgeSeriesDomain(LineChartItem *edgeSeries); // 修复边界序列区域
+    static bool updateEdge(const QVector<QPointF> &points, QVector<QPointF> &edge,
+                           QRectF &rect, int &unchanged); // 比较并记录边界点集，更新其外接矩形
+    bool updateFillPolygon(); // 由边界点集增量构建填充多边形，有断点时返回false
 
     QAreaSeries *m_series; // 所属序列
     LineChartItem *m_upper; // 上限图表项
     LineChartItem *m_lower; // 下限图表项
-    QPainterPath m_path; // 路径
+    mutable QPainterPath m_path; // 路径，以多边形填充时在首次调用 shape() 时生成
+    mutable bool m_pathValid; // 路径是否有效
+    bool m_fillPolygon; // 是否以多边形填充（直角坐标且边界无断点）
+    QVector<QPointF> m_fillPoints; // 填充多边形：上界点集正序，接下界点集逆序或基线两端
+    QVector<QPointF> m_upperPoints; // 构建多边形所用的上界点集
+    QVector<QPointF> m_lowerPoints; // 构建多边形所用的下界点集
+    QRectF m_upperRect; // 上界点集的外接矩形
+    QRectF m_lowerRect; // 下界点集的外接矩形
     QRectF m_rect; // 尺寸
     QPen m_linePen; // 线画笔
     QPen m_pointPen; // 电画笔
@@ -148,6 +159,10 @@ public:
         }
     }
 
+protected:
+    // 区域路径由边界线的几何点集生成，不能只变换边界线本身
+    bool acceptsGeometryTransform() const { return false; }
+
 private:
     AreaChartItem *m_item; // 所属图表区域项
 };
@@ -32,6 +32,7 @@
 #include <QtCharts/QLineSeries>
 #include <private/areachartitem_p.h>
 #include <private/abstractdomain_p.h>
+#include <private/qxyseries_p.h>
 #include <private/chartdataset_p.h>
 #include <private/charttheme_p.h>
 #include <QtCharts/QValueAxis>
@@ -800,63 +801,31 @@ void QAreaSeriesPrivate::initializeDomain()
     qreal maxY(1.0);
 
     // 取上、下限
-    QLineSeries *upperSeries = q->upperSeries();
-    QLineSeries *lowerSeries = q->lowerSeries();
+    const QXYSeries *upperSeries = q->upperSeries();
+    const QXYSeries *lowerSeries = q->lowerSeries();
 
-    // 上限存在
-    if (upperSeries) {
-
-        // 获取上限点集
-        const QVector<QPointF> &points = upperSeries->pointsVector();
-
-        // 点集非空
-        if (!points.isEmpty()) {
-
-            // 计算上限最大、最小x、y
-            minX = points[0].x();
-            minY = points[0].y();
-            maxX = minX;
-            maxY = minY;
-
-            for (int i = 0; i < points.count(); i++) {
-                qreal x = points[i].x();
-                qreal y = points[i].y();
-                minX = qMin(minX, x);
-                minY = qMin(minY, y);
-                maxX = qMax(maxX, x);
-                maxY = qMax(maxY, y);
-            }
-        }
-    }
+    // 上限存在，由上限点集的范围初始化，点集为空时保持默认值
+    if (upperSeries)
+        upperSeries->d_func()->pointBuffer().extents(minX, maxX, minY, maxY);
 
     // 下限存在
     if (lowerSeries) {
 
-        // 下限点集
-        const QVector<QPointF> &points = lowerSeries->pointsVector();
+        // 计算下限点集范围
+        qreal lowerMinX, lowerMaxX, lowerMinY, lowerMaxY;
+        if (lowerSeries->d_func()->pointBuffer().extents(lowerMinX, lowerMaxX, lowerMinY, lowerMaxY)) {
 
-        // 点集为空
-        if (!points.isEmpty()) {
-
-            // 上限为空
+            // 上限为空时直接使用下限范围，否则与之合并
             if (!upperSeries) {
-
-                // 初始化最大、最小x、y
-                minX = points[0].x();
-                minY = points[0].y();
-                maxX = minX;
-                maxY = minY;
-
-            }
-
-            // 计算最大、最小x、y
-            for (int i = 0; i < points.count(); i++) {
-                qreal x = points[i].x();
-                qreal y = points[i].y();
-                minX = qMin(minX, x);
-                minY = qMin(minY, y);
-                maxX = qMax(maxX, x);
-                maxY = qMax(maxY, y);
+                minX = lowerMinX;
+                maxX = lowerMaxX;
+                minY = lowerMinY;
+                maxY = lowerMaxY;
+            } else {
+                minX = qMin(minX, lowerMinX);
+                maxX = qMax(maxX, lowerMaxX);
+                minY = qMin(minY, lowerMinY);
+                maxY = qMax(maxY, lowerMaxY);
             }
         }
     }
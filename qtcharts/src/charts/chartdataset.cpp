@@ -446,6 +446,7 @@ void ChartDataSet::zoomInDomain(const QRectF &rect)
     foreach(QAbstractSeries *s, m_seriesList) {
         AbstractDomain* domain = s->d_ptr->domain();
         s->d_ptr->m_domain->blockRangeSignals(true);
+        domain->setInteractive(true);
         domains<<domain;
     }
 
@@ -454,6 +455,9 @@ void ChartDataSet::zoomInDomain(const QRectF &rect)
 
     foreach(AbstractDomain *domain, domains)
         domain->blockRangeSignals(false);
+
+    foreach(AbstractDomain *domain, domains)
+        domain->setInteractive(false);
 }
 
 void ChartDataSet::zoomOutDomain(const QRectF &rect)
@@ -462,6 +466,7 @@ void ChartDataSet::zoomOutDomain(const QRectF &rect)
     foreach(QAbstractSeries *s, m_seriesList) {
         AbstractDomain* domain = s->d_ptr->domain();
         s->d_ptr->m_domain->blockRangeSignals(true);
+        domain->setInteractive(true);
         domains<<domain;
     }
 
@@ -470,6 +475,9 @@ void ChartDataSet::zoomOutDomain(const QRectF &rect)
 
     foreach(AbstractDomain *domain, domains)
         domain->blockRangeSignals(false);
+
+    foreach(AbstractDomain *domain, domains)
+        domain->setInteractive(false);
 }
 
 void ChartDataSet::zoomResetDomain()
@@ -503,6 +511,7 @@ void ChartDataSet::scrollDomain(qreal dx, qreal dy)
     foreach(QAbstractSeries *s, m_seriesList) {
         AbstractDomain* domain = s->d_ptr->domain();
         s->d_ptr->m_domain->blockRangeSignals(true);
+        domain->setInteractive(true);
         domains<<domain;
     }
 
@@ -511,6 +520,9 @@ void ChartDataSet::scrollDomain(qreal dx, qreal dy)
 
     foreach(AbstractDomain *domain, domains)
         domain->blockRangeSignals(false);
+
+    foreach(AbstractDomain *domain, domains)
+        domain->setInteractive(false);
 }
 
 QPointF ChartDataSet::mapToValue(const QPointF &position, QAbstractSeries *series)
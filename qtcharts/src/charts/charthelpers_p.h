@@ -61,4 +61,11 @@ static inline bool isValidValue(const QPointF point)
     return (isValidValue(point.x()) && isValidValue(point.y()));
 }
 
+// Geometry points that could not be mapped, e.g. non-positive values on a log axis,
+// are NaN and mark a gap in the series.
+static inline bool isGapPoint(const QPointF &point)
+{
+    return qIsNaN(point.x()) || qIsNaN(point.y());
+}
+
 #endif // CHARTHELPERS_P_H
@@ -59,7 +59,9 @@ ChartPresenter::ChartPresenter(QChart *chart, QChart::ChartType type)
       m_background(0), // 背景
       m_plotAreaBackground(0), // 绘图背景
       m_title(0), // 标题
-      m_localizeNumbers(false) // ???
+      m_localizeNumbers(false), // ???
+      m_animationStartPending(false), // 是否已排队启动动画
+      m_animationFramePending(false) // 是否已排队本帧的统一更新
 #ifndef QT_NO_OPENGL
       , m_glWidget(0) // OpenGL 部件
       , m_glUseWidget(true) // 是否使用OpenGL 部件
@@ -246,10 +248,55 @@ void ChartPresenter::createTitleItem()
     }
 }
 
+// 启动动画
+// 一次数据或区域变化往往同时启动多个序列和坐标轴的动画，这里只排队一次调用把它们一起启动，
+// 使它们从同一时刻开始，由动画计时器在同一次触发中推进
 void ChartPresenter::startAnimation(ChartAnimation *animation)
 {
     animation->stop();
-    QTimer::singleShot(0, animation, SLOT(startChartAnimation()));
+    if (!m_pendingAnimations.contains(animation))
+        m_pendingAnimations.append(animation);
+    if (!m_animationStartPending) {
+        m_animationStartPending = true;
+        QMetaObject::invokeMethod(this, "startPendingAnimations", Qt::QueuedConnection);
+    }
+}
+
+// 启动等待中的动画，期间已被删除的动画被跳过
+void ChartPresenter::startPendingAnimations()
+{
+    m_animationStartPending = false;
+    const QVector<QPointer<ChartAnimation> > animations = m_pendingAnimations;
+    m_pendingAnimations.clear();
+    for (const QPointer<ChartAnimation> &animation : animations) {
+        if (animation)
+            animation->startChartAnimation();
+    }
+}
+
+// 请求在本帧的统一更新中应用动画的当前值
+// 动画计时器每次触发时各动画只记录各自的当前值，之后的一次排队调用再依次把它们应用到图表项，
+// 因此一帧中的几何更新集中在一起完成，且每个动画每帧至多应用一次
+void ChartPresenter::requestAnimationFrame(ChartAnimation *animation)
+{
+    if (!m_frameAnimations.contains(animation))
+        m_frameAnimations.append(animation);
+    if (!m_animationFramePending) {
+        m_animationFramePending = true;
+        QMetaObject::invokeMethod(this, "updateAnimationFrame", Qt::QueuedConnection);
+    }
+}
+
+// 依次应用本帧各动画的当前值
+void ChartPresenter::updateAnimationFrame()
+{
+    m_animationFramePending = false;
+    const QVector<QPointer<ChartAnimation> > animations = m_frameAnimations;
+    m_frameAnimations.clear();
+    for (const QPointer<ChartAnimation> &animation : animations) {
+        if (animation)
+            animation->updateFrame();
+    }
 }
 
 void ChartPresenter::setBackgroundBrush(const QBrush &brush)
@@ -47,6 +47,7 @@
 #include <QtCore/QMargins>
 #include <QtCore/QLocale>
 #include <QtCore/QPointer>
+#include <QtCore/QVector>
 #include <QtCore/QEasingCurve>
 
 QT_CHARTS_BEGIN_NAMESPACE
@@ -161,7 +162,8 @@ public:
     void setAnimationEasingCurve(const QEasingCurve &curve);
     QEasingCurve animationEasingCurve() const { return m_animationCurve; }
 
-    void startAnimation(ChartAnimation *animation);
+    void startAnimation(ChartAnimation *animation); // 启动动画，同一轮事件循环中启动的动画合并到一次调用中同时开始
+    void requestAnimationFrame(ChartAnimation *animation); // 请求在本帧的统一更新中应用动画的当前值
 
     void setState(State state,QPointF point);
     State state() const { return m_state; }
@@ -193,6 +195,10 @@ public Q_SLOTS:
     void handleAxisAdded(QAbstractAxis *axis);
     void handleAxisRemoved(QAbstractAxis *axis);
 
+private Q_SLOTS:
+    void startPendingAnimations(); // 启动等待中的动画
+    void updateAnimationFrame(); // 依次应用本帧各动画的当前值
+
 Q_SIGNALS:
     void plotAreaChanged(const QRectF &plotArea);
 
@@ -214,6 +220,10 @@ private:
     QRectF m_rect; // 矩形空间
     bool m_localizeNumbers; // ???
     QLocale m_locale; // ???
+    QVector<QPointer<ChartAnimation> > m_pendingAnimations; // 等待启动的动画
+    QVector<QPointer<ChartAnimation> > m_frameAnimations; // 本帧等待应用当前值的动画
+    bool m_animationStartPending; // 是否已排队启动动画
+    bool m_animationFramePending; // 是否已排队本帧的统一更新
 #ifndef QT_NO_OPENGL
     QPointer<GLWidget> m_glWidget; // OpenGL 部件
 #endif
@@ -3,6 +3,7 @@
 TARGET = QtCharts
 
 QT = core gui widgets
+QT_PRIVATE += core-private
 contains(QT_COORD_TYPE, float): DEFINES += QT_QREAL_IS_FLOAT
 
 QMAKE_DOCS = $$PWD/doc/qtcharts.qdocconf
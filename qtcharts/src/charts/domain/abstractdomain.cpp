@@ -31,6 +31,7 @@
 #include <private/qabstractaxis_p.h>
 #include <QtCore/QtMath>
 #include <cmath>
+#include <algorithm>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
@@ -43,6 +44,7 @@ AbstractDomain::AbstractDomain(QObject *parent)
       m_maxY(0),
       m_signalsBlocked(false),
       m_zoomed(false),
+      m_interactive(false),
       m_zoomResetMinX(0),
       m_zoomResetMaxX(0),
       m_zoomResetMinY(0),
@@ -230,6 +232,58 @@ qreal AbstractDomain::niceNumber(qreal x, bool ceiling)
     return q * z;
 }
 
+// 计算几何点集，默认经由向量接口换算，换算失败时返回false
+bool AbstractDomain::calculatePointsGeometry(const QPointF *points, int count, QPointF *result) const
+{
+    QVector<QPointF> vector(count);
+    std::copy(points, points + count, vector.begin());
+    const QVector<QPointF> geometry = calculateGeometryPoints(vector);
+    if (geometry.count() != count)
+        return false;
+    std::copy(geometry.cbegin(), geometry.cend(), result);
+    return true;
+}
+
+// 计算x、y列的几何点集，默认组装为点集后原地换算
+bool AbstractDomain::calculateColumnsGeometry(const qreal *x, const qreal *y, int count, QPointF *result) const
+{
+    for (int i = 0; i < count; i++)
+        result[i] = QPointF(x[i], y[i]);
+    return calculatePointsGeometry(result, count, result);
+}
+
+// 计算均匀采样的几何点集，第i个点的x为 x0 + (index + i) * dx，默认组装为点集后原地换算
+bool AbstractDomain::calculateUniformGeometry(qreal x0, qreal dx, int index, const qreal *y, int count, QPointF *result) const
+{
+    for (int i = 0; i < count; i++)
+        result[i] = QPointF(x0 + (index + i) * dx, y[i]);
+    return calculatePointsGeometry(result, count, result);
+}
+
+// 获取区域坐标到几何坐标的线性变换，默认不是线性区域
+bool AbstractDomain::geometryTransform(DomainTransform &transform) const
+{
+    Q_UNUSED(transform);
+    return false;
+}
+
+// 获取对数轴的底，默认不是对数直角坐标区域
+bool AbstractDomain::logBases(qreal &logBaseX, qreal &logBaseY) const
+{
+    Q_UNUSED(logBaseX);
+    Q_UNUSED(logBaseY);
+    return false;
+}
+
+// 由对数坐标点集计算几何点集，默认不支持
+bool AbstractDomain::calculateLogPointsGeometry(const QPointF *logPoints, int count, QPointF *result) const
+{
+    Q_UNUSED(logPoints);
+    Q_UNUSED(count);
+    Q_UNUSED(result);
+    return false;
+}
+
 // 捆绑坐标轴
 bool AbstractDomain::attachAxis(QAbstractAxis *axis)
 {
@@ -47,6 +47,7 @@
 QT_CHARTS_BEGIN_NAMESPACE
 
 class QAbstractAxis;
+class DomainTransform;
 
 class QT_CHARTS_PRIVATE_EXPORT AbstractDomain: public QObject
 {
@@ -93,6 +94,8 @@ public:
     void zoomReset(); // 缩放重置
     void storeZoomReset(); // 存储缩放重置信息
     bool isZoomed() { return m_zoomed; } // 返回是否缩放
+    void setInteractive(bool interactive) { m_interactive = interactive; } // 设置是否正在交互平移、缩放
+    bool isInteractive() const { return m_interactive; } // 是否正在交互平移、缩放
 
     friend bool Q_AUTOTEST_EXPORT operator== (const AbstractDomain &domain1, const AbstractDomain &domain2); // 判断区域是否相同
     friend bool Q_AUTOTEST_EXPORT operator!= (const AbstractDomain &domain1, const AbstractDomain &domain2); // 判断区域是否不同
@@ -105,6 +108,12 @@ public:
     virtual QPointF calculateGeometryPoint(const QPointF &point, bool &ok) const = 0; // 计算几何点
     virtual QPointF calculateDomainPoint(const QPointF &point) const = 0; // 计算区域点
     virtual QVector<QPointF> calculateGeometryPoints(const QVector<QPointF> &vector) const = 0; // 计算几何点集
+    virtual bool calculatePointsGeometry(const QPointF *points, int count, QPointF *result) const; // 计算几何点集，写入result，可原地换算
+    virtual bool calculateColumnsGeometry(const qreal *x, const qreal *y, int count, QPointF *result) const; // 计算x、y列的几何点集，写入result
+    virtual bool calculateUniformGeometry(qreal x0, qreal dx, int index, const qreal *y, int count, QPointF *result) const; // 计算均匀采样的几何点集，写入result
+    virtual bool geometryTransform(DomainTransform &transform) const; // 获取（对数轴上为对数坐标的）区域坐标到几何坐标的线性变换，非线性区域返回false
+    virtual bool logBases(qreal &logBaseX, qreal &logBaseY) const; // 获取对数轴的底，线性轴为0，非对数直角坐标区域返回false
+    virtual bool calculateLogPointsGeometry(const QPointF *logPoints, int count, QPointF *result) const; // 由对数坐标点集计算几何点集，写入result
 
     virtual bool attachAxis(QAbstractAxis *axis); // 捆绑坐标轴
     virtual bool detachAxis(QAbstractAxis *axis); // 松绑坐标轴
@@ -140,6 +149,7 @@ protected:
     QSizeF m_size; // 尺寸
     bool m_signalsBlocked; // ???
     bool m_zoomed; // 缩放标志
+    bool m_interactive; // 交互标志
     qreal m_zoomResetMinX; // 缩放重置最小X
     qreal m_zoomResetMaxX; // 缩放重置最大X
     qreal m_zoomResetMinY; // 缩放重置最小Y
@@ -4,6 +4,7 @@ INCLUDEPATH += $$PWD
 
 SOURCES += \
     $$PWD/abstractdomain.cpp \
+    $$PWD/domaintransform.cpp \
     $$PWD/polardomain.cpp \
     $$PWD/xydomain.cpp \
     $$PWD/xypolardomain.cpp \
@@ -16,6 +17,7 @@ SOURCES += \
 
 PRIVATE_HEADERS += \
     $$PWD/abstractdomain_p.h \
+    $$PWD/domaintransform_p.h \
     $$PWD/polardomain_p.h \
     $$PWD/xydomain_p.h \
     $$PWD/xypolardomain_p.h \
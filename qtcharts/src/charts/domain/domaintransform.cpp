@@ -0,0 +1,304 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/domaintransform_p.h>
+#include <QtCore/private/qsimd_p.h>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// qreal为float时没有双精度向量实现
+#if !defined(QT_QREAL_IS_FLOAT) && defined(__SSE2__)
+#  define DOMAINTRANSFORM_SSE2
+#endif
+#if !defined(QT_QREAL_IS_FLOAT) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+#  define DOMAINTRANSFORM_AVX2
+#endif
+
+namespace {
+
+// 换算系数
+struct Coefficients {
+    qreal originX;
+    qreal scaleX;
+    qreal offsetX;
+    qreal originY;
+    qreal scaleY;
+    qreal offsetY;
+};
+
+// 标量实现
+void mapPointsScalar(const Coefficients &c, const QPointF *points, int count, QPointF *result, int i = 0)
+{
+    for (; i < count; ++i) {
+        result[i] = QPointF((points[i].x() - c.originX) * c.scaleX + c.offsetX,
+                            (points[i].y() - c.originY) * c.scaleY + c.offsetY);
+    }
+}
+
+void mapColumnsScalar(const Coefficients &c, const qreal *x, const qreal *y, int count, QPointF *result, int i = 0)
+{
+    for (; i < count; ++i) {
+        result[i] = QPointF((x[i] - c.originX) * c.scaleX + c.offsetX,
+                            (y[i] - c.originY) * c.scaleY + c.offsetY);
+    }
+}
+
+void mapUniformScalar(const Coefficients &c, qreal x0, qreal dx, int index, const qreal *y, int count, QPointF *result, int i = 0)
+{
+    for (; i < count; ++i) {
+        result[i] = QPointF((x0 + (index + i) * dx - c.originX) * c.scaleX + c.offsetX,
+                            (y[i] - c.originY) * c.scaleY + c.offsetY);
+    }
+}
+
+#ifdef DOMAINTRANSFORM_SSE2
+// SSE2实现，每次换算一个点或两个y值
+void mapPointsSse2(const Coefficients &c, const QPointF *points, int count, QPointF *result)
+{
+    const __m128d origin = _mm_set_pd(c.originY, c.originX);
+    const __m128d scale = _mm_set_pd(c.scaleY, c.scaleX);
+    const __m128d offset = _mm_set_pd(c.offsetY, c.offsetX);
+    const double *in = reinterpret_cast<const double *>(points);
+    double *out = reinterpret_cast<double *>(result);
+    for (int i = 0; i < count; ++i) {
+        const __m128d p = _mm_loadu_pd(in + 2 * i);
+        _mm_storeu_pd(out + 2 * i, _mm_add_pd(_mm_mul_pd(_mm_sub_pd(p, origin), scale), offset));
+    }
+}
+
+void mapColumnsSse2(const Coefficients &c, const qreal *x, const qreal *y, int count, QPointF *result)
+{
+    const __m128d originX = _mm_set1_pd(c.originX);
+    const __m128d scaleX = _mm_set1_pd(c.scaleX);
+    const __m128d offsetX = _mm_set1_pd(c.offsetX);
+    const __m128d originY = _mm_set1_pd(c.originY);
+    const __m128d scaleY = _mm_set1_pd(c.scaleY);
+    const __m128d offsetY = _mm_set1_pd(c.offsetY);
+    double *out = reinterpret_cast<double *>(result);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d gx = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(x + i), originX), scaleX), offsetX);
+        const __m128d gy = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(y + i), originY), scaleY), offsetY);
+        _mm_storeu_pd(out + 2 * i, _mm_unpacklo_pd(gx, gy));
+        _mm_storeu_pd(out + 2 * i + 2, _mm_unpackhi_pd(gx, gy));
+    }
+    mapColumnsScalar(c, x, y, count, result, i);
+}
+
+void mapUniformSse2(const Coefficients &c, qreal x0, qreal dx, int index, const qreal *y, int count, QPointF *result)
+{
+    const __m128d originX = _mm_set1_pd(c.originX);
+    const __m128d scaleX = _mm_set1_pd(c.scaleX);
+    const __m128d offsetX = _mm_set1_pd(c.offsetX);
+    const __m128d originY = _mm_set1_pd(c.originY);
+    const __m128d scaleY = _mm_set1_pd(c.scaleY);
+    const __m128d offsetY = _mm_set1_pd(c.offsetY);
+    const __m128d start = _mm_set1_pd(x0);
+    const __m128d step = _mm_set1_pd(dx);
+    const __m128d lanes = _mm_set_pd(1.0, 0.0);
+    double *out = reinterpret_cast<double *>(result);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d n = _mm_add_pd(_mm_set1_pd(double(index + i)), lanes);
+        const __m128d x = _mm_add_pd(start, _mm_mul_pd(n, step));
+        const __m128d gx = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(x, originX), scaleX), offsetX);
+        const __m128d gy = _mm_add_pd(_mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(y + i), originY), scaleY), offsetY);
+        _mm_storeu_pd(out + 2 * i, _mm_unpacklo_pd(gx, gy));
+        _mm_storeu_pd(out + 2 * i + 2, _mm_unpackhi_pd(gx, gy));
+    }
+    mapUniformScalar(c, x0, dx, index, y, count, result, i);
+}
+#endif
+
+#ifdef DOMAINTRANSFORM_AVX2
+// AVX2实现，每次换算两个点或四个y值
+QT_FUNCTION_TARGET(AVX2)
+void mapPointsAvx2(const Coefficients &c, const QPointF *points, int count, QPointF *result)
+{
+    const __m256d origin = _mm256_set_pd(c.originY, c.originX, c.originY, c.originX);
+    const __m256d scale = _mm256_set_pd(c.scaleY, c.scaleX, c.scaleY, c.scaleX);
+    const __m256d offset = _mm256_set_pd(c.offsetY, c.offsetX, c.offsetY, c.offsetX);
+    const double *in = reinterpret_cast<const double *>(points);
+    double *out = reinterpret_cast<double *>(result);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m256d p = _mm256_loadu_pd(in + 2 * i);
+        _mm256_storeu_pd(out + 2 * i, _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(p, origin), scale), offset));
+    }
+    mapPointsScalar(c, points, count, result, i);
+}
+
+// 把四个x和四个y交错为四个点写出
+QT_FUNCTION_TARGET(AVX2)
+inline void storeInterleavedAvx2(double *out, __m256d gx, __m256d gy)
+{
+    const __m256d low = _mm256_unpacklo_pd(gx, gy); // x0 y0 x2 y2
+    const __m256d high = _mm256_unpackhi_pd(gx, gy); // x1 y1 x3 y3
+    _mm256_storeu_pd(out, _mm256_permute2f128_pd(low, high, 0x20));
+    _mm256_storeu_pd(out + 4, _mm256_permute2f128_pd(low, high, 0x31));
+}
+
+QT_FUNCTION_TARGET(AVX2)
+void mapColumnsAvx2(const Coefficients &c, const qreal *x, const qreal *y, int count, QPointF *result)
+{
+    const __m256d originX = _mm256_set1_pd(c.originX);
+    const __m256d scaleX = _mm256_set1_pd(c.scaleX);
+    const __m256d offsetX = _mm256_set1_pd(c.offsetX);
+    const __m256d originY = _mm256_set1_pd(c.originY);
+    const __m256d scaleY = _mm256_set1_pd(c.scaleY);
+    const __m256d offsetY = _mm256_set1_pd(c.offsetY);
+    double *out = reinterpret_cast<double *>(result);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d gx = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(x + i), originX), scaleX), offsetX);
+        const __m256d gy = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(y + i), originY), scaleY), offsetY);
+        storeInterleavedAvx2(out + 2 * i, gx, gy);
+    }
+    mapColumnsScalar(c, x, y, count, result, i);
+}
+
+QT_FUNCTION_TARGET(AVX2)
+void mapUniformAvx2(const Coefficients &c, qreal x0, qreal dx, int index, const qreal *y, int count, QPointF *result)
+{
+    const __m256d originX = _mm256_set1_pd(c.originX);
+    const __m256d scaleX = _mm256_set1_pd(c.scaleX);
+    const __m256d offsetX = _mm256_set1_pd(c.offsetX);
+    const __m256d originY = _mm256_set1_pd(c.originY);
+    const __m256d scaleY = _mm256_set1_pd(c.scaleY);
+    const __m256d offsetY = _mm256_set1_pd(c.offsetY);
+    const __m256d start = _mm256_set1_pd(x0);
+    const __m256d step = _mm256_set1_pd(dx);
+    const __m256d lanes = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    double *out = reinterpret_cast<double *>(result);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d n = _mm256_add_pd(_mm256_set1_pd(double(index + i)), lanes);
+        const __m256d x = _mm256_add_pd(start, _mm256_mul_pd(n, step));
+        const __m256d gx = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(x, originX), scaleX), offsetX);
+        const __m256d gy = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(y + i), originY), scaleY), offsetY);
+        storeInterleavedAvx2(out + 2 * i, gx, gy);
+    }
+    mapUniformScalar(c, x0, dx, index, y, count, result, i);
+}
+#endif
+
+} // namespace
+
+// 构造恒等变换
+DomainTransform::DomainTransform()
+    : m_originX(0),
+      m_scaleX(1),
+      m_offsetX(0),
+      m_originY(0),
+      m_scaleY(1),
+      m_offsetY(0)
+{
+}
+
+// 构造，由区域范围、尺寸和逆向标志得出换算系数
+DomainTransform::DomainTransform(const QSizeF &size, qreal minX, qreal maxX, qreal minY, qreal maxY,
+                                 bool reverseX, bool reverseY)
+{
+    const qreal deltaX = size.width() / (maxX - minX);
+    const qreal deltaY = size.height() / (maxY - minY);
+
+    // 几何y轴向下，y未逆向时需要翻转
+    m_originX = minX;
+    m_scaleX = reverseX ? -deltaX : deltaX;
+    m_offsetX = reverseX ? size.width() : 0;
+    m_originY = minY;
+    m_scaleY = reverseY ? deltaY : -deltaY;
+    m_offsetY = reverseY ? 0 : size.height();
+}
+
+// 换算点集
+void DomainTransform::mapPoints(const QPointF *points, int count, QPointF *result) const
+{
+    const Coefficients c = { m_originX, m_scaleX, m_offsetX, m_originY, m_scaleY, m_offsetY };
+#ifdef DOMAINTRANSFORM_AVX2
+    if (qCpuHasFeature(AVX2)) {
+        mapPointsAvx2(c, points, count, result);
+        return;
+    }
+#endif
+#ifdef DOMAINTRANSFORM_SSE2
+    mapPointsSse2(c, points, count, result);
+#else
+    mapPointsScalar(c, points, count, result);
+#endif
+}
+
+// 换算x、y列
+void DomainTransform::mapColumns(const qreal *x, const qreal *y, int count, QPointF *result) const
+{
+    const Coefficients c = { m_originX, m_scaleX, m_offsetX, m_originY, m_scaleY, m_offsetY };
+#ifdef DOMAINTRANSFORM_AVX2
+    if (qCpuHasFeature(AVX2)) {
+        mapColumnsAvx2(c, x, y, count, result);
+        return;
+    }
+#endif
+#ifdef DOMAINTRANSFORM_SSE2
+    mapColumnsSse2(c, x, y, count, result);
+#else
+    mapColumnsScalar(c, x, y, count, result);
+#endif
+}
+
+// 换算均匀采样的y列
+// 第i个点的x为 x0 + (index + i) * dx，与均匀采样布局的 xAt() 算法相同，再逐点换算。
+// 不换算首项和公差后累加，累加的舍入与逐点换算不同。
+void DomainTransform::mapUniform(qreal x0, qreal dx, int index, const qreal *y, int count, QPointF *result) const
+{
+    const Coefficients c = { m_originX, m_scaleX, m_offsetX, m_originY, m_scaleY, m_offsetY };
+#ifdef DOMAINTRANSFORM_AVX2
+    if (qCpuHasFeature(AVX2)) {
+        mapUniformAvx2(c, x0, dx, index, y, count, result);
+        return;
+    }
+#endif
+#ifdef DOMAINTRANSFORM_SSE2
+    mapUniformSse2(c, x0, dx, index, y, count, result);
+#else
+    mapUniformScalar(c, x0, dx, index, y, count, result);
+#endif
+}
+
+// 由previous下的几何坐标到本变换下几何坐标的变换
+// 两者都是各轴独立的线性变换，先按previous逆变换回区域坐标再按本变换换算，合成后仍是线性变换
+QTransform DomainTransform::transformFrom(const DomainTransform &previous) const
+{
+    const qreal scaleX = m_scaleX / previous.m_scaleX;
+    const qreal scaleY = m_scaleY / previous.m_scaleY;
+    const qreal dx = (previous.m_originX - m_originX) * m_scaleX + m_offsetX - previous.m_offsetX * scaleX;
+    const qreal dy = (previous.m_originY - m_originY) * m_scaleY + m_offsetY - previous.m_offsetY * scaleY;
+    return QTransform(scaleX, 0, 0, scaleY, dx, dy);
+}
+
+QT_CHARTS_END_NAMESPACE
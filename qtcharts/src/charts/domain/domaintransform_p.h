@@ -0,0 +1,83 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef DOMAINTRANSFORM_P_H
+#define DOMAINTRANSFORM_P_H
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <QtCore/QPointF>
+#include <QtCore/QSizeF>
+#include <QtGui/QTransform>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 区域坐标到几何坐标的线性变换
+// 几何坐标 = (区域坐标 - 原点) * 比例 + 偏移，逆向标志折算进比例和偏移，换算时没有分支。
+// 批量换算写入调用者提供的缓冲，在支持的处理器上使用SSE2或AVX2指令，每个点的换算算式与逐点换算相同。
+class QT_CHARTS_PRIVATE_EXPORT DomainTransform
+{
+public:
+    DomainTransform(); // 构造恒等变换
+    DomainTransform(const QSizeF &size, qreal minX, qreal maxX, qreal minY, qreal maxY,
+                    bool reverseX, bool reverseY); // 构造
+
+    inline QPointF map(const QPointF &point) const // 换算点
+    {
+        return QPointF((point.x() - m_originX) * m_scaleX + m_offsetX,
+                       (point.y() - m_originY) * m_scaleY + m_offsetY);
+    }
+
+    void mapPoints(const QPointF *points, int count, QPointF *result) const; // 换算点集，可原地换算
+    void mapColumns(const qreal *x, const qreal *y, int count, QPointF *result) const; // 换算x、y列
+    void mapUniform(qreal x0, qreal dx, int index, const qreal *y, int count,
+                    QPointF *result) const; // 换算均匀采样的y列，第i个点的x为 x0 + (index + i) * dx
+
+    QTransform transformFrom(const DomainTransform &previous) const; // 由previous下的几何坐标到本变换下几何坐标的变换
+
+private:
+    qreal m_originX; // x原点
+    qreal m_scaleX; // x比例
+    qreal m_offsetX; // x偏移
+    qreal m_originY; // y原点
+    qreal m_scaleY; // y比例
+    qreal m_offsetY; // y偏移
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // DOMAINTRANSFORM_P_H
@@ -29,8 +29,10 @@
 
 #include <private/logxlogydomain_p.h>
 #include <private/qabstractaxis_p.h>
+#include <private/domaintransform_p.h>
 #include <QtCharts/QLogValueAxis>
 #include <QtCore/QtMath>
+#include <QtCore/QtNumeric>
 #include <cmath>
 
 QT_CHARTS_BEGIN_NAMESPACE
@@ -217,28 +219,48 @@ QPointF LogXLogYDomain::calculateGeometryPoint(const QPointF &point, bool &ok) c
 // 计算几何点集
 QVector<QPointF> LogXLogYDomain::calculateGeometryPoints(const QVector<QPointF> &vector) const
 {
-    const qreal deltaX = m_size.width() / qAbs(m_logRightX - m_logLeftX);
-    const qreal deltaY = m_size.height() / qAbs(m_logRightY - m_logLeftY);
+    QVector<QPointF> result(vector.count());
+    calculatePointsGeometry(vector.constData(), vector.count(), result.data());
+    return result;
+}
 
-    QVector<QPointF> result;
-    result.resize(vector.count());
-
-    for (int i = 0; i < vector.count(); ++i) {
-        if (vector[i].x() > 0 && vector[i].y() > 0) {
-            qreal x = ((std::log10(vector[i].x()) / std::log10(m_logBaseX)) - m_logLeftX) * deltaX;
-            if (m_reverseX)
-                x = m_size.width() - x;
-            qreal y = ((std::log10(vector[i].y()) / std::log10(m_logBaseY)) - m_logLeftY) * deltaY;
-            if (!m_reverseY)
-                y = m_size.height() - y;
-            result[i].setX(x);
-            result[i].setY(y);
-        } else {
-            qWarning() << "Logarithms of zero and negative values are undefined.";
-            return QVector<QPointF>();
-        }
+// 计算几何点集，写入result，先逐点取对数，非正值记为断点
+bool LogXLogYDomain::calculatePointsGeometry(const QPointF *points, int count, QPointF *result) const
+{
+    const qreal logBaseX = std::log10(m_logBaseX);
+    const qreal logBaseY = std::log10(m_logBaseY);
+    for (int i = 0; i < count; ++i) {
+        const QPointF &point = points[i];
+        if (point.x() > 0 && point.y() > 0)
+            result[i] = QPointF(std::log10(point.x()) / logBaseX, std::log10(point.y()) / logBaseY);
+        else
+            result[i] = QPointF(qQNaN(), qQNaN());
     }
-    return result;
+    return calculateLogPointsGeometry(result, count, result);
+}
+
+// 获取对数轴的底
+bool LogXLogYDomain::logBases(qreal &logBaseX, qreal &logBaseY) const
+{
+    logBaseX = m_logBaseX;
+    logBaseY = m_logBaseY;
+    return true;
+}
+
+// 获取对数坐标到几何坐标的线性变换
+bool LogXLogYDomain::geometryTransform(DomainTransform &transform) const
+{
+    transform = DomainTransform(m_size, m_logLeftX, m_logRightX, m_logLeftY, m_logRightY, m_reverseX, m_reverseY);
+    return true;
+}
+
+// 由对数坐标点集计算几何点集，对数空间内为线性变换，断点保持为NaN
+bool LogXLogYDomain::calculateLogPointsGeometry(const QPointF *logPoints, int count, QPointF *result) const
+{
+    DomainTransform transform;
+    geometryTransform(transform);
+    transform.mapPoints(logPoints, count, result);
+    return true;
 }
 
 // 计算区域点
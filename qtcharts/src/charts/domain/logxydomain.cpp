@@ -29,8 +29,10 @@
 
 #include <private/logxydomain_p.h>
 #include <private/qabstractaxis_p.h>
+#include <private/domaintransform_p.h>
 #include <QtCharts/QLogValueAxis>
 #include <QtCore/QtMath>
+#include <QtCore/QtNumeric>
 #include <cmath>
 
 QT_CHARTS_BEGIN_NAMESPACE
@@ -178,29 +180,47 @@ QPointF LogXYDomain::calculateGeometryPoint(const QPointF &point, bool &ok) cons
 // 计算几何点集
 QVector<QPointF> LogXYDomain::calculateGeometryPoints(const QVector<QPointF> &vector) const
 {
-    const qreal deltaX = m_size.width() / (m_logRightX - m_logLeftX);
-    const qreal deltaY = m_size.height() / (m_maxY - m_minY);
-
-    QVector<QPointF> result;
-    result.resize(vector.count());
-
-    for (int i = 0; i < vector.count(); ++i) {
-        if (vector[i].x() > 0) {
-            qreal x = ((std::log10(vector[i].x()) / std::log10(m_logBaseX)) - m_logLeftX) * deltaX;
-            if (m_reverseX)
-                x = m_size.width() - x;
-            qreal y = (vector[i].y() - m_minY) * deltaY;
-            if (!m_reverseY)
-                y = m_size.height() - y;
-            result[i].setX(x);
-            result[i].setY(y);
-        } else {
-            qWarning() << "Logarithms of zero and negative values are undefined.";
-            return QVector<QPointF>();
-        }
+    QVector<QPointF> result(vector.count());
+    calculatePointsGeometry(vector.constData(), vector.count(), result.data());
+    return result;
+}
 
+// 计算几何点集，写入result，先逐点取对数，非正值记为断点
+bool LogXYDomain::calculatePointsGeometry(const QPointF *points, int count, QPointF *result) const
+{
+    const qreal logBaseX = std::log10(m_logBaseX);
+    for (int i = 0; i < count; ++i) {
+        const QPointF &point = points[i];
+        if (point.x() > 0)
+            result[i] = QPointF(std::log10(point.x()) / logBaseX, point.y());
+        else
+            result[i] = QPointF(qQNaN(), qQNaN());
     }
-    return result;
+    return calculateLogPointsGeometry(result, count, result);
+}
+
+// 获取对数轴的底
+bool LogXYDomain::logBases(qreal &logBaseX, qreal &logBaseY) const
+{
+    logBaseX = m_logBaseX;
+    logBaseY = 0;
+    return true;
+}
+
+// 获取对数坐标到几何坐标的线性变换
+bool LogXYDomain::geometryTransform(DomainTransform &transform) const
+{
+    transform = DomainTransform(m_size, m_logLeftX, m_logRightX, m_minY, m_maxY, m_reverseX, m_reverseY);
+    return true;
+}
+
+// 由对数坐标点集计算几何点集，对数空间内为线性变换，断点保持为NaN
+bool LogXYDomain::calculateLogPointsGeometry(const QPointF *logPoints, int count, QPointF *result) const
+{
+    DomainTransform transform;
+    geometryTransform(transform);
+    transform.mapPoints(logPoints, count, result);
+    return true;
 }
 
 // 计算区域点
@@ -67,6 +67,10 @@ public:
     QPointF calculateGeometryPoint(const QPointF &point, bool &ok) const; // 计算几何点
     QPointF calculateDomainPoint(const QPointF &point) const; // 计算区域点
     QVector<QPointF> calculateGeometryPoints(const QVector<QPointF> &vector) const; // 计算几何点集
+    bool calculatePointsGeometry(const QPointF *points, int count, QPointF *result) const; // 计算几何点集，写入result
+    bool geometryTransform(DomainTransform &transform) const; // 获取对数坐标到几何坐标的线性变换
+    bool logBases(qreal &logBaseX, qreal &logBaseY) const; // 获取对数轴的底
+    bool calculateLogPointsGeometry(const QPointF *logPoints, int count, QPointF *result) const; // 由对数坐标点集计算几何点集
 
     bool attachAxis(QAbstractAxis *axis); // 捆绑坐标轴
     bool detachAxis(QAbstractAxis *axis); // 松绑坐标轴
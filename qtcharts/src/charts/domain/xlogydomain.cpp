@@ -29,8 +29,10 @@
 
 #include <private/xlogydomain_p.h>
 #include <private/qabstractaxis_p.h>
+#include <private/domaintransform_p.h>
 #include <QtCharts/QLogValueAxis>
 #include <QtCore/QtMath>
+#include <QtCore/QtNumeric>
 #include <cmath>
 
 QT_CHARTS_BEGIN_NAMESPACE
@@ -178,28 +180,47 @@ QPointF XLogYDomain::calculateGeometryPoint(const QPointF &point, bool &ok) cons
 // 计算几何点集
 QVector<QPointF> XLogYDomain::calculateGeometryPoints(const QVector<QPointF> &vector) const
 {
-    const qreal deltaX = m_size.width() / (m_maxX - m_minX);
-    const qreal deltaY = m_size.height() / qAbs(m_logRightY - m_logLeftY);
+    QVector<QPointF> result(vector.count());
+    calculatePointsGeometry(vector.constData(), vector.count(), result.data());
+    return result;
+}
 
-    QVector<QPointF> result;
-    result.resize(vector.count());
-
-    for (int i = 0; i < vector.count(); ++i) {
-        if (vector[i].y() > 0) {
-            qreal x = (vector[i].x() - m_minX) * deltaX;
-            if (m_reverseX)
-                x = m_size.width() - x;
-            qreal y = ((std::log10(vector[i].y()) / std::log10(m_logBaseY)) - m_logLeftY) * deltaY;
-            if (!m_reverseY)
-                y = m_size.height() - y;
-            result[i].setX(x);
-            result[i].setY(y);
-        } else {
-            qWarning() << "Logarithms of zero and negative values are undefined.";
-            return QVector<QPointF>();
-        }
+// 计算几何点集，写入result，先逐点取对数，非正值记为断点
+bool XLogYDomain::calculatePointsGeometry(const QPointF *points, int count, QPointF *result) const
+{
+    const qreal logBaseY = std::log10(m_logBaseY);
+    for (int i = 0; i < count; ++i) {
+        const QPointF &point = points[i];
+        if (point.y() > 0)
+            result[i] = QPointF(point.x(), std::log10(point.y()) / logBaseY);
+        else
+            result[i] = QPointF(qQNaN(), qQNaN());
     }
-    return result;
+    return calculateLogPointsGeometry(result, count, result);
+}
+
+// 获取对数轴的底
+bool XLogYDomain::logBases(qreal &logBaseX, qreal &logBaseY) const
+{
+    logBaseX = 0;
+    logBaseY = m_logBaseY;
+    return true;
+}
+
+// 获取对数坐标到几何坐标的线性变换
+bool XLogYDomain::geometryTransform(DomainTransform &transform) const
+{
+    transform = DomainTransform(m_size, m_minX, m_maxX, m_logLeftY, m_logRightY, m_reverseX, m_reverseY);
+    return true;
+}
+
+// 由对数坐标点集计算几何点集，对数空间内为线性变换，断点保持为NaN
+bool XLogYDomain::calculateLogPointsGeometry(const QPointF *logPoints, int count, QPointF *result) const
+{
+    DomainTransform transform;
+    geometryTransform(transform);
+    transform.mapPoints(logPoints, count, result);
+    return true;
 }
 
 // 计算区域点
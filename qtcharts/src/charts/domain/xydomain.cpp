@@ -172,28 +172,48 @@ QPointF XYDomain::calculateGeometryPoint(const QPointF &point, bool &ok) const
     return QPointF(x, y);
 }
 
+// 当前范围的线性变换
+DomainTransform XYDomain::transform() const
+{
+    return DomainTransform(m_size, m_minX, m_maxX, m_minY, m_maxY, m_reverseX, m_reverseY);
+}
+
+// 获取区域坐标到几何坐标的线性变换
+bool XYDomain::geometryTransform(DomainTransform &transform) const
+{
+    transform = this->transform();
+    return true;
+}
+
 // 计算几何点集
 QVector<QPointF> XYDomain::calculateGeometryPoints(const QVector<QPointF> &vector) const
 {
-    const qreal deltaX = m_size.width() / (m_maxX - m_minX);
-    const qreal deltaY = m_size.height() / (m_maxY - m_minY);
-
-    QVector<QPointF> result;
-    result.resize(vector.count());
-
-    for (int i = 0; i < vector.count(); ++i) {
-        qreal x = (vector[i].x() - m_minX) * deltaX;
-        if (m_reverseX)
-            x = m_size.width() - x;
-        qreal y = (vector[i].y() - m_minY) * deltaY;
-        if (!m_reverseY)
-            y = m_size.height() - y;
-        result[i].setX(x);
-        result[i].setY(y);
-    }
+    QVector<QPointF> result(vector.count());
+    transform().mapPoints(vector.constData(), vector.count(), result.data());
     return result;
 }
 
+// 计算几何点集，写入result
+bool XYDomain::calculatePointsGeometry(const QPointF *points, int count, QPointF *result) const
+{
+    transform().mapPoints(points, count, result);
+    return true;
+}
+
+// 计算x、y列的几何点集，写入result
+bool XYDomain::calculateColumnsGeometry(const qreal *x, const qreal *y, int count, QPointF *result) const
+{
+    transform().mapColumns(x, y, count, result);
+    return true;
+}
+
+// 计算均匀采样的几何点集，写入result
+bool XYDomain::calculateUniformGeometry(qreal x0, qreal dx, int index, const qreal *y, int count, QPointF *result) const
+{
+    transform().mapUniform(x0, dx, index, y, count, result);
+    return true;
+}
+
 // 计算区域点
 QPointF XYDomain::calculateDomainPoint(const QPointF &point) const
 {
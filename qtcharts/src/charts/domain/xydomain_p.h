@@ -39,6 +39,7 @@
 #ifndef XYDOMAIN_H
 #define XYDOMAIN_H
 #include <private/abstractdomain_p.h>
+#include <private/domaintransform_p.h>
 #include <QtCharts/private/qchartglobal_p.h>
 #include <QtCore/QRectF>
 #include <QtCore/QSizeF>
@@ -68,6 +69,13 @@ public:
     QPointF calculateGeometryPoint(const QPointF &point, bool &ok) const; // 计算几何点
     QPointF calculateDomainPoint(const QPointF &point) const; // 计算区域点
     QVector<QPointF> calculateGeometryPoints(const QVector<QPointF> &vector) const; // 计算几何点集
+    bool calculatePointsGeometry(const QPointF *points, int count, QPointF *result) const; // 计算几何点集，写入result
+    bool calculateColumnsGeometry(const qreal *x, const qreal *y, int count, QPointF *result) const; // 计算x、y列的几何点集，写入result
+    bool calculateUniformGeometry(qreal x0, qreal dx, int index, const qreal *y, int count, QPointF *result) const; // 计算均匀采样的几何点集，写入result
+    bool geometryTransform(DomainTransform &transform) const; // 获取区域坐标到几何坐标的线性变换
+
+private:
+    DomainTransform transform() const; // 当前范围的线性变换
 };
 
 QT_CHARTS_END_NAMESPACE
@@ -32,25 +32,59 @@
 #include <private/qlineseries_p.h>
 #include <private/chartpresenter_p.h>
 #include <private/polardomain_p.h>
+#include <private/xydecimator_p.h>
+#include <private/xygeometryworkers_p.h>
+#include <private/charthelpers_p.h>
 #include <private/chartthememanager_p.h>
 #include <private/charttheme_p.h>
 #include <QtGui/QPainter>
+#include <QtCore/QtMath>
 #include <QtWidgets/QGraphicsSceneMouseEvent>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
+// 分批绘制折线时每批的最多点数
+static const int PolylineBatchSize = 2048;
+
+// 求点集中非断点的外接矩形，没有这样的点时返回false
+static bool pointsBoundingRect(const QVector<QPointF> &points, QRectF &rect)
+{
+    qreal minX = qInf();
+    qreal maxX = -qInf();
+    qreal minY = qInf();
+    qreal maxY = -qInf();
+    for (int i = 0; i < points.size(); i++) {
+        const QPointF &point = points.at(i);
+        if (isGapPoint(point))
+            continue;
+        minX = qMin(minX, point.x());
+        maxX = qMax(maxX, point.x());
+        minY = qMin(minY, point.y());
+        maxY = qMax(maxY, point.y());
+    }
+    if (minX > maxX)
+        return false;
+    rect = QRectF(minX, minY, maxX - minX, maxY - minY);
+    return true;
+}
+
 // 构造
 LineChartItem::LineChartItem(QLineSeries *series, QGraphicsItem *item)
     : XYChart(series,item), // 基类构造函数
       m_series(series), // 所属序列
       m_pointsVisible(false), // 点集是否可见
+      m_decimation(false), // 是否抽稀绘制
       m_chartType(QChart::ChartTypeUndefined), // 图表类型
       m_pointLabelsVisible(false), // 点标签是否可见
       m_pointLabelsFormat(series->pointLabelsFormat()), // 点标签格式
       m_pointLabelsFont(series->pointLabelsFont()), // 点标签字体
       m_pointLabelsColor(series->pointLabelsColor()), // 点标签颜色
       m_pointLabelsClipping(true), // 点标签裁剪
-      m_mousePressed(false) // 鼠标是否按下
+      m_mousePressed(false), // 鼠标是否按下
+      m_pathValid(true), // 线路径和填充路径是否有效
+      m_shapeValid(false), // 形状路径是否有效
+      m_shapeWidth(0), // 形状路径的描边宽度
+      m_shapeFromPathPoints(false) // 形状路径能否由路径点集分块生成
 {
     // 接收鼠标在其上事件
     setAcceptHoverEvents(true);
@@ -80,8 +114,27 @@ QRectF LineChartItem::boundingRect() const
 }
 
 // 形状路径
+// 序列的点击、悬停等信号没有接收者时不参与命中检测；否则在首次调用时生成描边轮廓，
+// 点数较多的非极坐标折线分块并行生成。
 QPainterPath LineChartItem::shape() const
 {
+    if (!m_series->d_func()->hasInteractionReceivers())
+        return QPainterPath();
+
+    if (!m_shapeValid) {
+        if (m_shapeFromPathPoints && XYGeometryWorkers::isParallel(m_pathPoints.size())) {
+            m_shapePath = createShapePath(m_shapeWidth);
+        } else {
+            QPainterPathStroker stroker;
+            stroker.setWidth(m_shapeWidth);
+            stroker.setJoinStyle(Qt::MiterJoin);
+            stroker.setCapStyle(Qt::SquareCap);
+            stroker.setMiterLimit(m_linePen.miterLimit());
+            updatePath();
+            m_shapePath = stroker.createStroke(m_fullPath);
+        }
+        m_shapeValid = true;
+    }
     return m_shapePath;
 }
 
@@ -108,6 +161,8 @@ void LineChartItem::updateGeometry()
     // when animation starts.
     // 获取线的几何点集
     m_linePoints = geometryPoints();
+    // 构成线路径的点集
+    m_pathPoints = m_linePoints;
     // 存储线的几何点集
     const QVector<QPointF> &points = m_linePoints;
 
@@ -116,6 +171,9 @@ void LineChartItem::updateGeometry()
         prepareGeometryChange(); // 准备几何变更
         m_fullPath = QPainterPath(); // 全部路径
         m_linePath = QPainterPath(); // 线路径
+        m_pathValid = true; // 路径有效
+        m_shapePath = QPainterPath(); // 形状路径
+        m_shapeValid = true; // 形状路径有效
         m_rect = QRect(); // 矩形
         return;
     }
@@ -329,59 +387,55 @@ void LineChartItem::updateGeometry()
     }
     // 非极坐标
     else { // not polar
-        // 开启新路径
-        linePath.moveTo(points.at(0));
-        // 如果点可见
-        if (m_pointsVisible) {
-            int size = m_linePen.width(); // 记录点的宽度
-            linePath.addEllipse(points.at(0), size, size); // 增加一个圆
-            linePath.moveTo(points.at(0)); // 增加一个路径
-            for (int i = 1; i < points.size(); i++) { // 遍历点，更新路径
-                linePath.lineTo(points.at(i));
-                linePath.addEllipse(points.at(i), size, size);
-                linePath.moveTo(points.at(i));
-            }
-        }
-        // 如果点不可见
-        else {
-            for (int i = 1; i < points.size(); i++)
-                linePath.lineTo(points.at(i)); // 增加路径
-        }
-        // 存储路径
-        fullPath = linePath;
+        // 抽稀时同一像素列中的点只保留首、末、最低、最高点，断点原样保留
+        if (!m_pointsVisible && m_decimation)
+            m_pathPoints = XYDecimator::decimate(points);
     }
 
-    // 创建可填充轮廓
-    QPainterPathStroker stroker;
+    // 描边轮廓只用于命中检测，推迟到首次调用 shape() 时生成；外接矩形由路径按描边宽度估算。
+    // 非极坐标的路径也推迟到绘制或命中检测需要时生成，外接矩形由路径点集求出，因此实线逐帧
+    // 动画等只按点集绘制折线时不必每帧生成路径。
     // QPainter::drawLine does not respect join styles, for example BevelJoin becomes MiterJoin.
     // This is why we are prepared for the "worst case" scenario, i.e. use always MiterJoin and
     // multiply line width with square root of two when defining shape and bounding rectangle.
-    stroker.setWidth(margin);
-    stroker.setJoinStyle(Qt::MiterJoin);
-    stroker.setCapStyle(Qt::SquareCap);
-    stroker.setMiterLimit(m_linePen.miterLimit());
-    // 生成新的可填充路径
-    QPainterPath checkShapePath = stroker.createStroke(fullPath);
+    const bool polar = chartType == QChart::ChartTypePolar;
+    QRectF rect;
+    QRectF lineRect;
+    if (polar) {
+        rect = strokeBoundingRect(fullPath, margin, m_linePen.miterLimit());
+        lineRect = linePath.boundingRect();
+    } else if (pointsBoundingRect(m_pathPoints, lineRect)) {
+        if (m_pointsVisible) {
+            const int size = m_linePen.width();
+            lineRect.adjust(-size, -size, size, size);
+        }
+        const qreal extent = margin * qMax(qreal(1), m_linePen.miterLimit());
+        rect = lineRect.adjusted(-extent, -extent, extent, extent);
+    }
 
     // Only zoom in if the bounding rects of the paths fit inside int limits. QWidget::update() uses
     // a region that has to be compatible with QRect.
     // 路径无效
-    if (checkShapePath.boundingRect().height() <= INT_MAX
-            && checkShapePath.boundingRect().width() <= INT_MAX
-            && linePath.boundingRect().height() <= INT_MAX
-            && linePath.boundingRect().width() <= INT_MAX
-            && fullPath.boundingRect().height() <= INT_MAX
-            && fullPath.boundingRect().width() <= INT_MAX) {
+    if (rect.height() <= INT_MAX
+            && rect.width() <= INT_MAX
+            && lineRect.height() <= INT_MAX
+            && lineRect.width() <= INT_MAX) {
         // 准备变更
         prepareGeometryChange();
 
-        // 存储路径
+        // 存储路径，非极坐标时置为无效
         m_linePath = linePath;
         m_fullPath = fullPath;
-        m_shapePath = checkShapePath;
+        m_pathValid = polar;
+
+        // 形状路径失效
+        m_shapePath = QPainterPath();
+        m_shapeValid = false;
+        m_shapeWidth = margin;
+        m_shapeFromPathPoints = !polar && !m_pointsVisible;
 
         // 存储矩形
-        m_rect = m_shapePath.boundingRect();
+        m_rect = rect;
     }
     // 路径有效
     else {
@@ -391,6 +445,140 @@ void LineChartItem::updateGeometry()
     }
 }
 
+// 按需由路径点集生成非极坐标的线路径，点可见时在每个点处加一个圆
+void LineChartItem::updatePath() const
+{
+    if (m_pathValid)
+        return;
+
+    QPainterPath linePath;
+    // 断点之后另起子路径
+    bool gap = true;
+    const int size = m_linePen.width();
+    for (int i = 0; i < m_pathPoints.size(); i++) {
+        const QPointF &point = m_pathPoints.at(i);
+        if (isGapPoint(point)) {
+            gap = true;
+            continue;
+        }
+        if (gap)
+            linePath.moveTo(point); // 开启新路径
+        else
+            linePath.lineTo(point); // 增加路径
+        if (m_pointsVisible) {
+            linePath.addEllipse(point, size, size); // 增加一个圆
+            linePath.moveTo(point);
+        }
+        gap = false;
+    }
+    m_linePath = linePath;
+    m_fullPath = linePath;
+    m_pathValid = true;
+}
+
+// 分批绘制折线
+// 每批不超过 PolylineBatchSize 个点，相邻批次共用边界点，以限制光栅化引擎一次描边的路径规模；
+// 断点处另起一批。设备变换只含平移、缩放时，落在同一设备像素内的连续点只保留首、末点。
+void LineChartItem::drawPolylines(QPainter *painter, const QVector<QPointF> &points)
+{
+    const QTransform device = painter->deviceTransform();
+    const bool merge = device.type() <= QTransform::TxScale;
+
+    QVector<QPointF> batch;
+    batch.reserve(qMin(points.size(), int(PolylineBatchSize)));
+
+    // 绘制当前批次
+    const auto flush = [&]() {
+        if (batch.size() >= 2)
+            painter->drawPolyline(batch.constData(), batch.size());
+        batch.clear();
+    };
+    // 追加点，批次满时绘制，并以最后一点开始下一批
+    const auto append = [&](const QPointF &point) {
+        batch.append(point);
+        if (batch.size() == PolylineBatchSize) {
+            const QPointF last = batch.last();
+            flush();
+            batch.append(last);
+        }
+    };
+
+    int pixelX = 0; // 上一个输出点所在的设备像素
+    int pixelY = 0;
+    bool merged = false; // 是否有与上一个输出点同像素、尚未输出的点
+    QPointF mergedPoint; // 其中的最后一个
+    for (int i = 0; i < points.size(); i++) {
+        const QPointF &point = points.at(i);
+        if (isGapPoint(point)) {
+            if (merged)
+                append(mergedPoint);
+            merged = false;
+            flush();
+            continue;
+        }
+        if (merge) {
+            const int x = qFloor(point.x() * device.m11() + device.dx());
+            const int y = qFloor(point.y() * device.m22() + device.dy());
+            if (!batch.isEmpty() && x == pixelX && y == pixelY) {
+                mergedPoint = point;
+                merged = true;
+                continue;
+            }
+            if (merged)
+                append(mergedPoint);
+            merged = false;
+            pixelX = x;
+            pixelY = y;
+        }
+        append(point);
+    }
+    if (merged)
+        append(mergedPoint);
+    flush();
+}
+
+// 分块生成折线的可填充轮廓
+// 相邻块共用边界点，各块在线程池中分别生成轮廓后按序合并为一个路径；合并后块边界处以线帽
+// 代替尖角连接，轮廓只用于命中检测和外接矩形，这一差别可以忽略。
+QPainterPath LineChartItem::createShapePath(qreal width) const
+{
+    const int size = m_pathPoints.size();
+    const int chunkSize = XYGeometryWorkers::ChunkSize;
+    QVector<QPainterPath> strokes((size + chunkSize - 1) / chunkSize);
+
+    XYGeometryWorkers::run(size, chunkSize, [&](int index, int count) {
+        const int last = qMin(index + count, size - 1); // 包含下一块的首点
+        QPainterPath path;
+        bool gap = true;
+        for (int i = index; i <= last; i++) {
+            const QPointF &point = m_pathPoints.at(i);
+            if (isGapPoint(point)) {
+                gap = true;
+                continue;
+            }
+            if (gap)
+                path.moveTo(point);
+            else
+                path.lineTo(point);
+            gap = false;
+        }
+        // 生成轮廓时会修改轮廓生成器的内部状态，因此每块使用各自的生成器
+        QPainterPathStroker stroker;
+        stroker.setWidth(width);
+        stroker.setJoinStyle(Qt::MiterJoin);
+        stroker.setCapStyle(Qt::SquareCap);
+        stroker.setMiterLimit(m_linePen.miterLimit());
+        strokes[index / chunkSize] = stroker.createStroke(path);
+    });
+
+    // 相邻块的轮廓在共用的首末点处重叠，按非零环绕规则填充，重叠处不会被奇偶规则挖空
+    QPainterPath shapePath;
+    shapePath.setFillRule(Qt::WindingFill);
+    for (int i = 0; i < strokes.size(); i++)
+        shapePath.addPath(strokes.at(i));
+    return shapePath;
+}
+
 // 更新信号响应槽
 void LineChartItem::handleUpdated()
 {
@@ -399,7 +587,8 @@ void LineChartItem::handleUpdated()
     // 几何更新
     bool doGeometryUpdate =
         (m_pointsVisible != m_series->pointsVisible()) // 可见与否发生变更
-        || (m_series->pointsVisible() && (m_linePen != m_series->pen())); // 可见并且画笔变化
+        || (m_series->pointsVisible() && (m_linePen != m_series->pen())) // 可见并且画笔变化
+        || (m_decimation != m_series->decimation()); // 抽稀发生变更
     // 序列可见是否变更
     bool visibleChanged = m_series->isVisible() != isVisible();
     // 设置可见
@@ -408,6 +597,8 @@ void LineChartItem::handleUpdated()
     setOpacity(m_series->opacity());
     // 点集是否可见
     m_pointsVisible = m_series->pointsVisible();
+    // 是否抽稀绘制
+    m_decimation = m_series->decimation();
     // 序列画笔
     m_linePen = m_series->pen();
     // 序列标签格式
@@ -451,10 +642,16 @@ void LineChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *opt
     const qreal x2 = (clipRect.width() + 0.5) - int(clipRect.width() + 0.5);
     const qreal y2 = (clipRect.height() + 0.5) - int(clipRect.height() + 0.5);
     clipRect.adjust(-x1, -y1, qMax(x1, x2), qMax(y1, y2));
+    // 交互变换期间，剪裁矩形换算到项坐标，线宽不随变换缩放
+    QPen linePen = m_linePen;
+    if (!transform().isIdentity()) {
+        clipRect = transform().inverted().mapRect(clipRect);
+        linePen.setCosmetic(true);
+    }
     // 保存绘图场景
     painter->save();
     // 设置画笔
-    painter->setPen(m_linePen);
+    painter->setPen(linePen);
     // 总是使用路径标记
     bool alwaysUsePath = false;
     // 极坐标
@@ -480,6 +677,7 @@ void LineChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *opt
     // 点集可视
     if (m_pointsVisible) {
         painter->setBrush(m_linePen.color()); // 设置画刷
+        updatePath(); // 按需生成路径
         painter->drawPath(m_linePath); // 绘制路径
     }
     // 点集不可视
@@ -490,10 +688,10 @@ void LineChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *opt
         if (m_linePen.style() != Qt::SolidLine || alwaysUsePath) {
             // If pen style is not solid line, always fall back to path painting
             // to ensure proper continuity of the pattern
+            updatePath(); // 按需生成路径
             painter->drawPath(m_linePath); // 绘制线路径
         } else {
-            for (int i(1); i < m_linePoints.size(); i++)
-                painter->drawLine(m_linePoints.at(i - 1), m_linePoints.at(i)); // 绘制线
+            drawPolylines(painter, m_pathPoints); // 分批绘制折线，跳过断点
         }
     }
 
@@ -506,7 +704,8 @@ void LineChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *opt
         else
             painter->setClipping(false);
         // 绘制序列点标签
-        m_series->d_func()->drawSeriesPointLabels(painter, m_linePoints, m_linePen.width() / 2);
+        m_series->d_func()->drawSeriesPointLabels(painter, m_linePoints, m_linePen.width() / 2,
+                                                  firstIndex(), &geometrySource());
     }
 
     // 恢复绘图场景
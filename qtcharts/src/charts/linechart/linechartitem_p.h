@@ -64,7 +64,8 @@ public:
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget); // 绘图
     QPainterPath shape() const; // 形状
 
-    QPainterPath path() const { return m_fullPath; } // 绘制路径
+    QPainterPath path() const { updatePath(); return m_fullPath; } // 绘制路径
+    const QVector<QPointF> &pathPoints() const { return m_pathPoints; } // 构成线路径的（抽稀后）几何点集
 
 public Q_SLOTS:
     void handleUpdated(); // 更新信号响应槽
@@ -78,19 +79,27 @@ protected:
     void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event); // 鼠标双击事件
     void suppressPoints() { m_pointsVisible = false; } //  废除点集
     void forceChartType(QChart::ChartType chartType) { m_chartType = chartType; } // 强制类型
+    bool acceptsGeometryTransform() const { return true; } // 交互时以图形项变换代替重新换算
 
 private:
+    QPainterPath createShapePath(qreal width) const; // 分块生成折线的可填充轮廓
+    void updatePath() const; // 按需由路径点集生成非极坐标的线路径
+    void drawPolylines(QPainter *painter, const QVector<QPointF> &points); // 分批绘制折线
+
+
     QLineSeries *m_series; // 所属序列
-    QPainterPath m_linePath; // 线路径
+    mutable QPainterPath m_linePath; // 线路径，非极坐标时按需生成
     QPainterPath m_linePathPolarRight; // 极右路径
     QPainterPath m_linePathPolarLeft; // 极左路径
-    QPainterPath m_fullPath; // 填充路径
-    QPainterPath m_shapePath; // 形状路径
+    mutable QPainterPath m_fullPath; // 填充路径，非极坐标时按需生成
+    mutable QPainterPath m_shapePath; // 形状路径，首次调用 shape() 时生成
 
     QVector<QPointF> m_linePoints; // 线点集
+    QVector<QPointF> m_pathPoints; // 构成线路径的点集，抽稀时少于线点集
     QRectF m_rect; // 矩形尺寸
     QPen m_linePen; // 线画笔
     bool m_pointsVisible; // 点集是否可见
+    bool m_decimation; // 是否抽稀绘制
     QChart::ChartType m_chartType; // 图表类型
 
     bool m_pointLabelsVisible; // 点标签是否可见
@@ -101,6 +110,11 @@ private:
 
     QPointF m_lastMousePos; // 鼠标最后位置
     bool m_mousePressed; // 鼠标按下
+
+    mutable bool m_pathValid; // 线路径和填充路径是否有效
+    mutable bool m_shapeValid; // 形状路径是否有效
+    qreal m_shapeWidth; // 形状路径的描边宽度
+    bool m_shapeFromPathPoints; // 形状路径能否由路径点集分块生成
 };
 
 QT_CHARTS_END_NAMESPACE
@@ -378,6 +378,57 @@ void QAbstractSeries::hide()
     setVisible(false);
 }
 
+/*!
+    Starts a batch of changes to the data of the series.
+
+    Until the matching endUpdate() call, the series does not emit the signals
+    that notify about changed data points. Instead, it merges the changes and
+    emits the smallest equivalent notification once, when the outermost
+    endUpdate() is called. The chart then updates its geometry once for the
+    whole batch instead of once per change. The data itself is changed
+    immediately, so the getters of the series return the current values.
+
+    Calls to beginUpdate() and endUpdate() can be nested.
+
+    \note Only QXYSeries and its subclasses currently merge their notifications.
+
+    \sa endUpdate(), isUpdating()
+*/
+// 开始批量更新
+void QAbstractSeries::beginUpdate()
+{
+    d_ptr->m_updateDepth++;
+}
+
+/*!
+    Ends a batch of changes started with beginUpdate(). When the outermost batch
+    ends, the merged change notifications are emitted.
+
+    \sa beginUpdate(), isUpdating()
+*/
+// 结束批量更新
+void QAbstractSeries::endUpdate()
+{
+    if (d_ptr->m_updateDepth == 0) {
+        qWarning() << "QAbstractSeries::endUpdate() called without a matching beginUpdate().";
+        return;
+    }
+    if (--d_ptr->m_updateDepth == 0)
+        d_ptr->commitUpdate();
+}
+
+/*!
+    Returns \c true if a batch of changes started with beginUpdate() has not
+    ended yet.
+
+    \sa beginUpdate(), endUpdate()
+*/
+// 是否正在批量更新
+bool QAbstractSeries::isUpdating() const
+{
+    return d_ptr->isUpdating();
+}
+
 /*!
     Attaches the axis specified by \a axis to the series.
 
@@ -442,7 +493,8 @@ QAbstractSeriesPrivate::QAbstractSeriesPrivate(QAbstractSeries *q)
       m_visible(true), // 是否可见
       m_opacity(1.0), // 不透明度
       m_useOpenGL(false), // 是否使用 OpenGL
-      m_blockOpenGL(false) // 是否阻塞 OpenGL
+      m_blockOpenGL(false), // 是否阻塞 OpenGL
+      m_updateDepth(0) // 批量更新嵌套层数
 {
 }
 
@@ -510,6 +562,11 @@ void QAbstractSeriesPrivate::setBlockOpenGL(bool enable)
         q_ptr->setUseOpenGL(false);
 }
 
+// 批量更新结束时发送合并后的变化通知，默认没有需要合并的通知
+void QAbstractSeriesPrivate::commitUpdate()
+{
+}
+
 #include "moc_qabstractseries.cpp"
 #include "moc_qabstractseries_p.cpp"
 
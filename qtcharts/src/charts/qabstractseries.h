@@ -97,6 +97,10 @@ public:
     void show(); // 显示
     void hide(); // 隐藏
 
+    void beginUpdate(); // 开始批量更新
+    void endUpdate(); // 结束批量更新
+    bool isUpdating() const; // 是否正在批量更新
+
 Q_SIGNALS:
     void nameChanged();
     void visibleChanged();
@@ -94,6 +94,9 @@ public:
 
     void setBlockOpenGL(bool enable); // 是否阻塞OpenGL
 
+    bool isUpdating() const { return m_updateDepth > 0; } // 是否正在批量更新
+    virtual void commitUpdate(); // 批量更新结束时发送合并后的变化通知
+
 Q_SIGNALS:
     void countChanged(); // 计数变更信号
 
@@ -111,6 +114,7 @@ private:
     ChartPresenter *m_presenter; // 主持人
     bool m_useOpenGL; // 是否使用OpenGL
     bool m_blockOpenGL; // 是否阻止OpenGL
+    int m_updateDepth; // 批量更新嵌套层数
 
     friend class QAbstractSeries;
     friend class ChartDataSet;
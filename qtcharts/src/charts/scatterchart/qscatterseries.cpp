@@ -161,6 +161,40 @@
     The default size is 15.0.
 */
 
+/*!
+    \property QScatterSeries::densityRendering
+    \brief Whether the series is drawn as a density map instead of individual markers.
+
+    When enabled, the points are counted in a grid of cells covering the plot area and the
+    grid is drawn as a single image, each cell colored by the number of points in it through
+    densityGradient. Counting costs one pass over the points whenever the data or the axis
+    ranges change, and appending points only adds them to the existing counts, which makes
+    the mode suitable for series with millions of points. Point labels, hover, and click
+    signals are not available in this mode. This property is \c false by default.
+
+    \sa densityCellSize, densityGradient
+*/
+
+/*!
+    \property QScatterSeries::densityCellSize
+    \brief The size in pixels of the cells in which points are counted in density rendering.
+
+    The default size is 1, which counts points per pixel of the plot area.
+
+    \sa densityRendering
+*/
+
+/*!
+    \property QScatterSeries::densityGradient
+    \brief The color stops used to color the cells in density rendering.
+
+    The position 0 is used for cells with a single point and 1 for the fullest cell, scaled
+    logarithmically in between. By default there are no stops, and the cells are drawn in the
+    color of the series with an opacity increasing with the count.
+
+    \sa densityRendering
+*/
+
 /*!
     \qmlproperty string ScatterSeries::brushFilename
     The name of the file used as a brush for the series.
@@ -186,6 +220,21 @@
     This signal is emitted when the marker size changes to \a size.
 */
 
+/*!
+    \fn void QScatterSeries::densityRenderingChanged(bool enabled)
+    This signal is emitted when density rendering is \a enabled or disabled.
+*/
+
+/*!
+    \fn void QScatterSeries::densityCellSizeChanged(int size)
+    This signal is emitted when the cell size of density rendering changes to \a size.
+*/
+
+/*!
+    \fn void QScatterSeries::densityGradientChanged(const QGradientStops &stops)
+    This signal is emitted when the color stops of density rendering change to \a stops.
+*/
+
 QT_CHARTS_BEGIN_NAMESPACE
 
 /*!
@@ -318,12 +367,63 @@ void QScatterSeries::setMarkerSize(qreal size)
     }
 }
 
+bool QScatterSeries::densityRendering() const
+{
+    Q_D(const QScatterSeries);
+    return d->m_densityRendering;
+}
+
+void QScatterSeries::setDensityRendering(bool enabled)
+{
+    Q_D(QScatterSeries);
+    if (d->m_densityRendering != enabled) {
+        d->m_densityRendering = enabled;
+        emit d->updated();
+        emit densityRenderingChanged(enabled);
+    }
+}
+
+int QScatterSeries::densityCellSize() const
+{
+    Q_D(const QScatterSeries);
+    return d->m_densityCellSize;
+}
+
+void QScatterSeries::setDensityCellSize(int size)
+{
+    Q_D(QScatterSeries);
+    size = qMax(size, 1);
+    if (d->m_densityCellSize != size) {
+        d->m_densityCellSize = size;
+        emit d->updated();
+        emit densityCellSizeChanged(size);
+    }
+}
+
+QGradientStops QScatterSeries::densityGradient() const
+{
+    Q_D(const QScatterSeries);
+    return d->m_densityGradient;
+}
+
+void QScatterSeries::setDensityGradient(const QGradientStops &stops)
+{
+    Q_D(QScatterSeries);
+    if (d->m_densityGradient != stops) {
+        d->m_densityGradient = stops;
+        emit d->updated();
+        emit densityGradientChanged(stops);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 QScatterSeriesPrivate::QScatterSeriesPrivate(QScatterSeries *q)
     : QXYSeriesPrivate(q),
       m_shape(QScatterSeries::MarkerShapeCircle),
-      m_size(15.0)
+      m_size(15.0),
+      m_densityRendering(false),
+      m_densityCellSize(1)
 {
 }
 
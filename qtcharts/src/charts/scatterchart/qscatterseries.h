@@ -45,6 +45,9 @@ class QT_CHARTS_EXPORT QScatterSeries : public QXYSeries
     Q_PROPERTY(MarkerShape markerShape READ markerShape WRITE setMarkerShape NOTIFY markerShapeChanged)
     Q_PROPERTY(qreal markerSize READ markerSize WRITE setMarkerSize NOTIFY markerSizeChanged)
     Q_PROPERTY(QBrush brush READ brush WRITE setBrush)
+    Q_PROPERTY(bool densityRendering READ densityRendering WRITE setDensityRendering NOTIFY densityRenderingChanged)
+    Q_PROPERTY(int densityCellSize READ densityCellSize WRITE setDensityCellSize NOTIFY densityCellSizeChanged)
+    Q_PROPERTY(QGradientStops densityGradient READ densityGradient WRITE setDensityGradient NOTIFY densityGradientChanged)
     Q_ENUMS(MarkerShape)
 
 public:
@@ -68,12 +71,21 @@ public:
     void setMarkerShape(MarkerShape shape);
     qreal markerSize() const;
     void setMarkerSize(qreal size);
+    bool densityRendering() const;
+    void setDensityRendering(bool enabled = true);
+    int densityCellSize() const;
+    void setDensityCellSize(int size);
+    QGradientStops densityGradient() const;
+    void setDensityGradient(const QGradientStops &stops);
 
 Q_SIGNALS:
     void colorChanged(QColor color);
     void borderColorChanged(QColor color);
     void markerShapeChanged(MarkerShape shape);
     void markerSizeChanged(qreal size);
+    void densityRenderingChanged(bool enabled);
+    void densityCellSizeChanged(int size);
+    void densityGradientChanged(const QGradientStops &stops);
 
 private:
     Q_DECLARE_PRIVATE(QScatterSeries)
@@ -56,6 +56,9 @@ public:
 private:
     QScatterSeries::MarkerShape m_shape;
     qreal m_size;
+    bool m_densityRendering;
+    int m_densityCellSize;
+    QGradientStops m_densityGradient;
     Q_DECLARE_PUBLIC(QScatterSeries)
 };
 
@@ -2,11 +2,13 @@ INCLUDEPATH += $$PWD
 
 SOURCES += \
     $$PWD/qscatterseries.cpp \
-    $$PWD/scatterchartitem.cpp
+    $$PWD/scatterchartitem.cpp \
+    $$PWD/scatterdensitygrid.cpp
 
 PRIVATE_HEADERS += \
     $$PWD/scatterchartitem_p.h \
-    $$PWD/qscatterseries_p.h
+    $$PWD/qscatterseries_p.h \
+    $$PWD/scatterdensitygrid_p.h
 
 PUBLIC_HEADERS += \
     $$PWD/qscatterseries.h
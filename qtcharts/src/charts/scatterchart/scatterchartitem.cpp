@@ -32,26 +32,43 @@
 #include <private/qscatterseries_p.h>
 #include <private/chartpresenter_p.h>
 #include <private/abstractdomain_p.h>
+#include <private/charthelpers_p.h>
 #include <QtCharts/QChart>
 #include <QtGui/QPainter>
+#include <QtCore/QtMath>
 #include <QtWidgets/QGraphicsScene>
-#include <QtCore/QDebug>
 #include <QtWidgets/QGraphicsSceneMouseEvent>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
+/*!
+  \internal
+  Paints all markers of a scatter series from its geometry points. Markers are stamped from a
+  sprite rendered once per shape, size, pen, brush and device pixel ratio, and hover and mouse
+  events are resolved to markers through a grid of the geometry points, so that no graphics
+  item is created per point.
+  */
 ScatterChartItem::ScatterChartItem(QScatterSeries *series, QGraphicsItem *item)
     : XYChart(series,item),
       m_series(series),
-      m_items(this),
       m_visible(true),
       m_shape(QScatterSeries::MarkerShapeRectangle),
       m_size(15),
+      m_gridValid(false),
+      m_spriteShape(-1),
+      m_spriteSize(0),
+      m_spriteRatio(0),
+      m_spriteAntialiasing(false),
+      m_density(false),
+      m_densityCellSize(1),
+      m_densityImageValid(false),
       m_pointLabelsVisible(false),
       m_pointLabelsFormat(series->pointLabelsFormat()),
       m_pointLabelsFont(series->pointLabelsFont()),
       m_pointLabelsColor(series->pointLabelsColor()),
       m_pointLabelsClipping(true),
+      m_pressedIndex(-1),
+      m_hoveredIndex(-1),
       m_mousePressed(false)
 {
     QObject::connect(m_series->d_func(), SIGNAL(updated()), this, SLOT(handleUpdated()));
@@ -66,11 +83,9 @@ ScatterChartItem::ScatterChartItem(QScatterSeries *series, QGraphicsItem *item)
     QObject::connect(series, SIGNAL(pointLabelsClippingChanged(bool)), this, SLOT(handleUpdated()));
 
     setZValue(ChartPresenter::ScatterSeriesZValue);
-    setFlags(QGraphicsItem::ItemClipsChildrenToShape);
+    setAcceptHoverEvents(true);
 
     handleUpdated();
-
-    m_items.setHandlesChildEvents(false);
 }
 
 QRectF ScatterChartItem::boundingRect() const
@@ -78,72 +93,147 @@ QRectF ScatterChartItem::boundingRect() const
     return m_rect;
 }
 
-void ScatterChartItem::createPoints(int count)
+/*!
+  Returns the distance from the center of a marker to its outer edge, including the pen.
+  */
+qreal ScatterChartItem::markerExtent() const
 {
-    for (int i = 0; i < count; ++i) {
+    const QPen pen = m_series->pen();
+    const qreal penWidth = pen.style() == Qt::NoPen ? 0 : qMax(pen.widthF(), qreal(1));
+    return (m_size + penWidth) / 2;
+}
 
-        QGraphicsItem *item = 0;
+/*!
+  Returns the index of the topmost visible marker intersecting \a rect, or -1 if there is none.
+  */
+int ScatterChartItem::markerAt(const QRectF &rect) const
+{
+    if (!m_visible || m_density || m_series->useOpenGL())
+        return -1;
 
-        switch (m_shape) {
-        case QScatterSeries::MarkerShapeCircle: {
-            item = new CircleMarker(0, 0, m_size, m_size, this);
-            const QRectF &rect = item->boundingRect();
-            item->setPos(-rect.width() / 2, -rect.height() / 2);
-            break;
-        }
-        case QScatterSeries::MarkerShapeRectangle:
-            item = new RectangleMarker(0, 0, m_size, m_size, this);
-            item->setPos(-m_size / 2, -m_size / 2);
-            break;
-        default:
-            qWarning() << "Unsupported marker type";
-            break;
-        }
-        m_items.addToGroup(item);
+    const qreal extent = markerExtent();
+    if (!m_gridValid) {
+        m_grid.build(m_points, m_rect, 2 * extent);
+        m_gridValid = true;
     }
+
+    QVector<int> candidates;
+    m_grid.query(rect.adjusted(-extent, -extent, extent, extent), candidates);
+
+    // Later markers are painted on top of earlier ones
+    int found = -1;
+    for (int i = 0; i < candidates.size(); i++) {
+        const int index = candidates.at(i);
+        if (index <= found || (index < m_offGrid.size() && m_offGrid.at(index)))
+            continue;
+        const QPointF &point = m_points.at(index);
+        const qreal dx = qMax(qMax(rect.left() - point.x(), point.x() - rect.right()), qreal(0));
+        const qreal dy = qMax(qMax(rect.top() - point.y(), point.y() - rect.bottom()), qreal(0));
+        const bool hit = m_shape == QScatterSeries::MarkerShapeCircle
+                ? dx * dx + dy * dy <= extent * extent
+                : dx <= extent && dy <= extent;
+        if (hit)
+            found = index;
+    }
+    return found;
+}
+
+bool ScatterChartItem::contains(const QPointF &point) const
+{
+    return markerAt(QRectF(point, QSizeF(0, 0))) >= 0;
 }
 
-void ScatterChartItem::deletePoints(int count)
+bool ScatterChartItem::collidesWithPath(const QPainterPath &path, Qt::ItemSelectionMode mode) const
 {
-    QList<QGraphicsItem *> items = m_items.childItems();
+    Q_UNUSED(mode)
+    return markerAt(path.boundingRect()) >= 0;
+}
+
+/*!
+  Returns the series point of the marker at \a index.
+  */
+QPointF ScatterChartItem::markerValue(int index) const
+{
+    // During remove animation series may have different number of points,
+    // so ensure we don't go over the index. Note that the values can be technically incorrect
+    // during the animation, if it was caused by an insert, but this shouldn't be a problem as
+    // the points are fake anyway. After remove animation stops, geometry is updated to correct one.
+    const XYSeriesBuffer &buffer = geometrySource();
+    const int seriesLastIndex = buffer.count() - 1;
+    if (seriesLastIndex < 0)
+        return QPointF();
+    return buffer.at(qMin(seriesLastIndex, m_firstIndex + index));
+}
+
+void ScatterChartItem::setHoveredMarker(int index)
+{
+    if (index == m_hoveredIndex)
+        return;
+    if (m_hoveredIndex >= 0)
+        emit XYChart::hovered(markerValue(m_hoveredIndex), false);
+    m_hoveredIndex = index;
+    if (m_hoveredIndex >= 0)
+        emit XYChart::hovered(markerValue(m_hoveredIndex), true);
+}
 
-    for (int i = 0; i < count; ++i) {
-        QGraphicsItem *item = items.takeLast();
-        m_markerMap.remove(item);
-        delete(item);
+void ScatterChartItem::mousePressEvent(QGraphicsSceneMouseEvent *event)
+{
+    m_pressedIndex = markerAt(QRectF(event->pos(), QSizeF(0, 0)));
+    if (m_pressedIndex < 0) {
+        event->ignore();
+        return;
     }
+    emit XYChart::pressed(markerValue(m_pressedIndex));
+    m_mousePressed = true;
+    event->accept();
 }
 
-void ScatterChartItem::markerSelected(QGraphicsItem *marker)
+void ScatterChartItem::hoverEnterEvent(QGraphicsSceneHoverEvent *event)
 {
-    emit XYChart::clicked(m_markerMap[marker]);
+    setHoveredMarker(markerAt(QRectF(event->pos(), QSizeF(0, 0))));
+    event->accept();
 }
 
-void ScatterChartItem::markerHovered(QGraphicsItem *marker, bool state)
+void ScatterChartItem::hoverMoveEvent(QGraphicsSceneHoverEvent *event)
 {
-    emit XYChart::hovered(m_markerMap[marker], state);
+    setHoveredMarker(markerAt(QRectF(event->pos(), QSizeF(0, 0))));
+    event->accept();
 }
 
-void ScatterChartItem::markerPressed(QGraphicsItem *marker)
+void ScatterChartItem::hoverLeaveEvent(QGraphicsSceneHoverEvent *event)
 {
-    emit XYChart::pressed(m_markerMap[marker]);
+    setHoveredMarker(-1);
+    event->accept();
 }
 
-void ScatterChartItem::markerReleased(QGraphicsItem *marker)
+void ScatterChartItem::mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
 {
-    emit XYChart::released(m_markerMap[marker]);
+    if (m_pressedIndex >= 0) {
+        emit XYChart::released(markerValue(m_pressedIndex));
+        if (m_mousePressed)
+            emit XYChart::clicked(markerValue(m_pressedIndex));
+    }
+    m_mousePressed = false;
+    event->accept();
 }
 
-void ScatterChartItem::markerDoubleClicked(QGraphicsItem *marker)
+void ScatterChartItem::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event)
 {
-    emit XYChart::doubleClicked(m_markerMap[marker]);
+    const int index = markerAt(QRectF(event->pos(), QSizeF(0, 0)));
+    if (index < 0) {
+        event->ignore();
+        return;
+    }
+    m_pressedIndex = index;
+    emit XYChart::doubleClicked(markerValue(index));
+    event->accept();
 }
 
 void ScatterChartItem::updateGeometry()
 {
+    m_gridValid = false;
     if (m_series->useOpenGL()) {
-        if (m_items.childItems().count())
-            deletePoints(m_items.childItems().count());
+        m_offGrid.clear();
         if (!m_rect.isEmpty()) {
             prepareGeometryChange();
             // Changed signal seems to trigger even with empty region
@@ -153,60 +243,168 @@ void ScatterChartItem::updateGeometry()
         return;
     }
 
-    const QVector<QPointF>& points = geometryPoints();
+    QRectF clipRect(QPointF(0,0),domain()->size());
 
-    if (points.size() == 0) {
-        deletePoints(m_items.childItems().count());
-        return;
+    // Only zoom in if the clipRect fits inside int limits. QWidget::update() uses
+    // a region that has to be compatible with QRect.
+    if (clipRect.height() <= INT_MAX
+            && clipRect.width() <= INT_MAX) {
+        // Markers of points outside the axis ranges are not drawn
+        m_offGrid = m_points.isEmpty() ? QVector<bool>() : offGridStatusVector();
+        prepareGeometryChange();
+        m_rect = clipRect;
     }
+    update();
+}
 
-    int diff = m_items.childItems().size() - points.size();
-
-    if (diff > 0)
-        deletePoints(diff);
-    else if (diff < 0)
-        createPoints(-diff);
+/*!
+  Returns the marker sprite for painting with \a painter, rendering it again if the marker
+  shape, size, pen, brush, device pixel ratio or antialiasing changed.
+  */
+const QPixmap &ScatterChartItem::markerSprite(QPainter *painter)
+{
+    const QPen pen = m_series->pen();
+    const QBrush brush = m_series->brush();
+    const qreal ratio = painter->device()->devicePixelRatioF();
+    const bool antialiasing = painter->testRenderHint(QPainter::Antialiasing);
+    if (!m_sprite.isNull() && m_spriteShape == m_shape && m_spriteSize == m_size
+            && m_spritePen == pen && m_spriteBrush == brush && m_spriteRatio == ratio
+            && m_spriteAntialiasing == antialiasing) {
+        return m_sprite;
+    }
 
-    if (diff != 0)
-        handleUpdated();
+    // Leave a pixel around the stroked marker for antialiasing
+    const int side = qCeil((2 * markerExtent() + 2) * ratio);
+    m_sprite = QPixmap(side, side);
+    m_sprite.setDevicePixelRatio(ratio);
+    m_sprite.fill(Qt::transparent);
+
+    QPainter spritePainter(&m_sprite);
+    spritePainter.setRenderHint(QPainter::Antialiasing, antialiasing);
+    spritePainter.setPen(pen);
+    spritePainter.setBrush(brush);
+    // Paint in the same coordinates as a marker item positioned on the point would
+    const qreal center = side / ratio / 2;
+    spritePainter.translate(center - m_size / 2.0, center - m_size / 2.0);
+    if (m_shape == QScatterSeries::MarkerShapeCircle)
+        spritePainter.drawEllipse(QRectF(0, 0, m_size, m_size));
+    else
+        spritePainter.drawRect(QRectF(0, 0, m_size, m_size));
+    spritePainter.end();
+
+    m_spriteShape = m_shape;
+    m_spriteSize = m_size;
+    m_spritePen = pen;
+    m_spriteBrush = brush;
+    m_spriteRatio = ratio;
+    m_spriteAntialiasing = antialiasing;
+    return m_sprite;
+}
 
-    QList<QGraphicsItem *> items = m_items.childItems();
+/*!
+  Returns true if markers can be stamped from a sprite rendered at \a devicePixelRatio on a
+  painter with \a deviceTransform, that is if the transform only translates and scales both
+  axes by the device pixel ratio, as on high-DPI screens.
+  */
+bool ScatterChartItem::stampsMarkers(const QTransform &deviceTransform, qreal devicePixelRatio)
+{
+    return deviceTransform.type() <= QTransform::TxScale
+            && qFuzzyCompare(deviceTransform.m11(), devicePixelRatio)
+            && qFuzzyCompare(deviceTransform.m22(), devicePixelRatio);
+}
 
-    QRectF clipRect(QPointF(0,0),domain()->size());
+/*!
+  Draws the markers of the visible points. When the painter only translates and scales by the
+  device pixel ratio, markers are stamped from the sprite; otherwise they are painted as shapes
+  so that they scale with the view.
+  */
+void ScatterChartItem::drawMarkers(QPainter *painter, const QRectF &clipRect)
+{
+    const qreal extent = markerExtent();
+    const QRectF visibleRect = clipRect.adjusted(-extent, -extent, extent, extent);
+    const bool stamp = stampsMarkers(painter->deviceTransform(),
+                                     painter->device()->devicePixelRatioF());
+
+    QPointF offset;
+    if (stamp) {
+        const QPixmap &sprite = markerSprite(painter);
+        const qreal center = sprite.width() / sprite.devicePixelRatioF() / 2;
+        offset = QPointF(center, center);
+    } else {
+        painter->setPen(m_series->pen());
+        painter->setBrush(m_series->brush());
+    }
 
-    // Only zoom in if the clipRect fits inside int limits. QWidget::update() uses
-    // a region that has to be compatible with QRect.
-    if (clipRect.height() <= INT_MAX
-            && clipRect.width() <= INT_MAX) {
-        QVector<bool> offGridStatus = offGridStatusVector();
-        const int seriesLastIndex = m_series->count() - 1;
-
-        for (int i = 0; i < points.size(); i++) {
-            QGraphicsItem *item = items.at(i);
-            const QPointF &point = points.at(i);
-            const QRectF &rect = item->boundingRect();
-            // During remove animation series may have different number of points,
-            // so ensure we don't go over the index. Animation handling itself ensures that
-            // if there is actually no points in the series, then it won't generate a fake point,
-            // so we can be assured there is always at least one point in m_series here.
-            // Note that marker map values can be technically incorrect during the animation,
-            // if it was caused by an insert, but this shouldn't be a problem as the points are
-            // fake anyway. After remove animation stops, geometry is updated to correct one.
-            m_markerMap[item] = m_series->at(qMin(seriesLastIndex, i));
-            QPointF position;
-            position.setX(point.x() - rect.width() / 2);
-            position.setY(point.y() - rect.height() / 2);
-            item->setPos(position);
-
-            if (!m_visible || offGridStatus.at(i))
-                item->setVisible(false);
+    for (int i = 0; i < m_points.size(); i++) {
+        const QPointF &point = m_points.at(i);
+        // Points that cannot be mapped, e.g. non-positive values on a log axis, are gaps
+        if (isGapPoint(point) || !visibleRect.contains(point)
+                || (i < m_offGrid.size() && m_offGrid.at(i))) {
+            continue;
+        }
+        if (stamp) {
+            painter->drawPixmap(point - offset, m_sprite);
+        } else {
+            const QRectF rect(point.x() - m_size / 2.0, point.y() - m_size / 2.0, m_size, m_size);
+            if (m_shape == QScatterSeries::MarkerShapeCircle)
+                painter->drawEllipse(rect);
             else
-                item->setVisible(true);
+                painter->drawRect(rect);
         }
+    }
+}
 
+/*!
+  In density rendering the geometry points are not kept. Appended points are added to the
+  density grid right away; other changes drop the grid, which is counted again on the next paint.
+  */
+bool ScatterChartItem::handleDataChanged(int appendedIndex)
+{
+    if (!m_density)
+        return false;
+
+    if (appendedIndex < 0 || !m_densityGrid.append(m_series->d_func(), domain(), appendedIndex))
+        m_densityGrid.invalidate();
+    m_densityImageValid = false;
+    update();
+    return true;
+}
+
+bool ScatterChartItem::handleDomainChanged()
+{
+    if (!m_density)
+        return false;
+
+    m_densityGrid.invalidate();
+    m_densityImageValid = false;
+    const QRectF clipRect(QPointF(0, 0), domain()->size());
+    if (clipRect.height() <= INT_MAX && clipRect.width() <= INT_MAX) {
         prepareGeometryChange();
         m_rect = clipRect;
     }
+    update();
+    return true;
+}
+
+/*!
+  Draws the density grid as an image scaled to the plot area, counting the points first if
+  the data or the domain changed since the last paint.
+  */
+void ScatterChartItem::drawDensity(QPainter *painter)
+{
+    if (!m_densityGrid.isValid()) {
+        if (!m_densityGrid.build(m_series->d_func(), domain(), m_densityCellSize))
+            return;
+        m_densityImageValid = false;
+    }
+    if (!m_densityImageValid) {
+        m_densityImage = m_densityGrid.image(m_series->densityGradient(), m_series->brush().color());
+        m_densityImageValid = true;
+    }
+
+    const int cellSize = m_densityGrid.cellSize();
+    painter->drawImage(QRectF(0, 0, m_densityImage.width() * cellSize,
+                              m_densityImage.height() * cellSize), m_densityImage);
 }
 
 void ScatterChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -222,6 +420,14 @@ void ScatterChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
     painter->save();
     painter->setClipRect(clipRect);
 
+    if (m_density) {
+        drawDensity(painter);
+        painter->restore();
+        return;
+    }
+
+    drawMarkers(painter, clipRect);
+
     if (m_pointLabelsVisible) {
         if (m_pointLabelsClipping)
             painter->setClipping(true);
@@ -229,24 +435,13 @@ void ScatterChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *
             painter->setClipping(false);
         m_series->d_func()->drawSeriesPointLabels(painter, m_points,
                                                   m_series->markerSize() / 2
-                                                  + m_series->pen().width());
+                                                  + m_series->pen().width(),
+                                                  m_firstIndex, &geometrySource());
     }
 
     painter->restore();
 }
 
-void ScatterChartItem::setPen(const QPen &pen)
-{
-    foreach (QGraphicsItem *item , m_items.childItems())
-        static_cast<QAbstractGraphicsShapeItem*>(item)->setPen(pen);
-}
-
-void ScatterChartItem::setBrush(const QBrush &brush)
-{
-    foreach (QGraphicsItem *item , m_items.childItems())
-        static_cast<QAbstractGraphicsShapeItem*>(item)->setBrush(brush);
-}
-
 void ScatterChartItem::handleUpdated()
 {
     if (m_series->useOpenGL()) {
@@ -257,13 +452,6 @@ void ScatterChartItem::handleUpdated()
         return;
     }
 
-    int count = m_items.childItems().count();
-    if (count == 0)
-        return;
-
-    bool recreate = m_visible != m_series->isVisible()
-                    || m_size != m_series->markerSize()
-                    || m_shape != m_series->markerShape();
     m_visible = m_series->isVisible();
     m_size = m_series->markerSize();
     m_shape = m_series->markerShape();
@@ -275,16 +463,26 @@ void ScatterChartItem::handleUpdated()
     m_pointLabelsColor = m_series->pointLabelsColor();
     m_pointLabelsClipping = m_series->pointLabelsClipping();
 
-    if (recreate) {
-        deletePoints(count);
-        createPoints(count);
-
-        // Updating geometry is now safe, because it won't call handleUpdated unless it creates/deletes points
-        updateGeometry();
+    // The marker size and pen decide the hit area
+    m_gridValid = false;
+
+    // Density rendering counts the series points directly and drops the geometry points;
+    // switching back maps them again.
+    const bool density = m_series->densityRendering();
+    if (density != m_density || m_densityCellSize != m_series->densityCellSize()) {
+        const bool switched = density != m_density;
+        m_density = density;
+        m_densityCellSize = m_series->densityCellSize();
+        m_densityGrid.invalidate();
+        if (switched && m_density) {
+            cancelGeometry();
+            m_points.clear();
+            m_offGrid.clear();
+        } else if (switched && presenter()) {
+            handleDomainUpdated();
+        }
     }
-
-    setPen(m_series->pen());
-    setBrush(m_series->brush());
+    m_densityImageValid = false;
     update();
 }
 
@@ -41,8 +41,10 @@
 
 #include <QtCharts/QChartGlobal>
 #include <private/xychart_p.h>
-#include <QtWidgets/QGraphicsEllipseItem>
+#include <private/xypointgrid_p.h>
+#include <private/scatterdensitygrid_p.h>
 #include <QtGui/QPen>
+#include <QtGui/QPixmap>
 #include <QtWidgets/QGraphicsSceneMouseEvent>
 #include <QtCharts/private/qchartglobal_p.h>
 
@@ -61,38 +63,59 @@ public:
     //from QGraphicsItem
     QRectF boundingRect() const;
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
+    bool contains(const QPointF &point) const;
+    bool collidesWithPath(const QPainterPath &path,
+                          Qt::ItemSelectionMode mode = Qt::IntersectsItemShape) const;
 
-    void setPen(const QPen &pen);
-    void setBrush(const QBrush &brush);
-
-    void markerSelected(QGraphicsItem *item);
-    void markerHovered(QGraphicsItem *item, bool state);
-    void markerPressed(QGraphicsItem *item);
-    void markerReleased(QGraphicsItem *item);
-    void markerDoubleClicked(QGraphicsItem *item);
-
-    void setMousePressed(bool pressed = true) {m_mousePressed = pressed;}
-    bool mousePressed() {return m_mousePressed;}
+    int markerAt(const QRectF &rect) const;
 
+    static bool stampsMarkers(const QTransform &deviceTransform, qreal devicePixelRatio);
 
 public Q_SLOTS:
     void handleUpdated();
 
-private:
-    void createPoints(int count);
-    void deletePoints(int count);
-
 protected:
     void updateGeometry();
+    bool handleDataChanged(int appendedIndex);
+    bool handleDomainChanged();
+    void mousePressEvent(QGraphicsSceneMouseEvent *event);
+    void hoverEnterEvent(QGraphicsSceneHoverEvent *event);
+    void hoverMoveEvent(QGraphicsSceneHoverEvent *event);
+    void hoverLeaveEvent(QGraphicsSceneHoverEvent *event);
+    void mouseReleaseEvent(QGraphicsSceneMouseEvent *event);
+    void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event);
+
+private:
+    qreal markerExtent() const;
+    QPointF markerValue(int index) const;
+    void setHoveredMarker(int index);
+    const QPixmap &markerSprite(QPainter *painter);
+    void drawMarkers(QPainter *painter, const QRectF &clipRect);
+    void drawDensity(QPainter *painter);
 
 private:
     QScatterSeries *m_series;
-    QGraphicsItemGroup m_items;
     bool m_visible;
     int m_shape;
     int m_size;
     QRectF m_rect;
-    QMap<QGraphicsItem *, QPointF> m_markerMap;
+    QVector<bool> m_offGrid;
+    mutable XYPointGrid m_grid;
+    mutable bool m_gridValid;
+
+    QPixmap m_sprite;
+    QPen m_spritePen;
+    QBrush m_spriteBrush;
+    int m_spriteShape;
+    int m_spriteSize;
+    qreal m_spriteRatio;
+    bool m_spriteAntialiasing;
+
+    bool m_density;
+    int m_densityCellSize;
+    ScatterDensityGrid m_densityGrid;
+    QImage m_densityImage;
+    bool m_densityImageValid;
 
     bool m_pointLabelsVisible;
     QString m_pointLabelsFormat;
@@ -100,103 +123,11 @@ private:
     QColor m_pointLabelsColor;
     bool m_pointLabelsClipping;
 
+    int m_pressedIndex;
+    int m_hoveredIndex;
     bool m_mousePressed;
 };
 
-class QT_CHARTS_PRIVATE_EXPORT CircleMarker: public QGraphicsEllipseItem
-{
-
-public:
-    CircleMarker(qreal x, qreal y, qreal w, qreal h, ScatterChartItem *parent)
-        : QGraphicsEllipseItem(x, y, w, h, parent),
-          m_parent(parent)
-    {
-        setAcceptHoverEvents(true);
-        setFlag(QGraphicsItem::ItemIsSelectable);
-    }
-
-protected:
-    void mousePressEvent(QGraphicsSceneMouseEvent *event)
-    {
-        QGraphicsEllipseItem::mousePressEvent(event);
-        m_parent->markerPressed(this);
-        m_parent->setMousePressed();
-    }
-    void hoverEnterEvent(QGraphicsSceneHoverEvent *event)
-    {
-        QGraphicsEllipseItem::hoverEnterEvent(event);
-        m_parent->markerHovered(this, true);
-    }
-    void hoverLeaveEvent(QGraphicsSceneHoverEvent *event)
-    {
-        QGraphicsEllipseItem::hoverLeaveEvent(event);
-        m_parent->markerHovered(this, false);
-    }
-    void mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
-    {
-        QGraphicsEllipseItem::mouseReleaseEvent(event);
-        m_parent->markerReleased(this);
-        if (m_parent->mousePressed())
-            m_parent->markerSelected(this);
-        m_parent->setMousePressed(false);
-    }
-    void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event)
-    {
-        QGraphicsEllipseItem::mouseDoubleClickEvent(event);
-        m_parent->markerDoubleClicked(this);
-    }
-
-private:
-    ScatterChartItem *m_parent;
-};
-
-class QT_CHARTS_PRIVATE_EXPORT RectangleMarker: public QGraphicsRectItem
-{
-
-public:
-    RectangleMarker(qreal x, qreal y, qreal w, qreal h, ScatterChartItem *parent)
-        : QGraphicsRectItem(x, y, w, h, parent),
-          m_parent(parent)
-    {
-        setAcceptHoverEvents(true);
-        setFlag(QGraphicsItem::ItemIsSelectable);
-    }
-
-protected:
-    void mousePressEvent(QGraphicsSceneMouseEvent *event)
-    {
-        QGraphicsRectItem::mousePressEvent(event);
-        m_parent->markerPressed(this);
-        m_parent->setMousePressed();
-    }
-    void hoverEnterEvent(QGraphicsSceneHoverEvent *event)
-    {
-        QGraphicsRectItem::hoverEnterEvent(event);
-        m_parent->markerHovered(this, true);
-    }
-    void hoverLeaveEvent(QGraphicsSceneHoverEvent *event)
-    {
-        QGraphicsRectItem::hoverLeaveEvent(event);
-        m_parent->markerHovered(this, false);
-    }
-    void mouseReleaseEvent(QGraphicsSceneMouseEvent *event)
-    {
-        QGraphicsRectItem::mouseReleaseEvent(event);
-        m_parent->markerReleased(this);
-        if (m_parent->mousePressed())
-            m_parent->markerSelected(this);
-        m_parent->setMousePressed(false);
-    }
-    void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event)
-    {
-        QGraphicsRectItem::mouseDoubleClickEvent(event);
-        m_parent->markerDoubleClicked(this);
-    }
-
-private:
-    ScatterChartItem *m_parent;
-};
-
 QT_CHARTS_END_NAMESPACE
 
 #endif // SCATTERPRESENTER_H
@@ -0,0 +1,214 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/scatterdensitygrid_p.h>
+#include <private/qxyseries_p.h>
+#include <private/abstractdomain_p.h>
+#include <private/xygeometryworkers_p.h>
+#include <private/charthelpers_p.h>
+#include <QtGui/QPainter>
+#include <QtCore/QMutex>
+#include <QtCore/QThreadPool>
+#include <QtCore/QtMath>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+ScatterDensityGrid::ScatterDensityGrid()
+    : m_cellSize(1),
+      m_columns(0),
+      m_rows(0),
+      m_maxCount(0),
+      m_pointCount(0),
+      m_valid(false)
+{
+}
+
+void ScatterDensityGrid::invalidate()
+{
+    m_counts.clear();
+    m_maxCount = 0;
+    m_pointCount = 0;
+    m_valid = false;
+}
+
+/*!
+  Counts \a count points of \a series starting at \a index into \a counts, converting them to
+  geometry in blocks so that no geometry buffer for the whole series is needed. The largest
+  count of the cells counted into is stored in \a maxCount. Returns false if the points
+  cannot be mapped to \a domain.
+  */
+bool ScatterDensityGrid::accumulate(const QXYSeriesPrivate *series, const AbstractDomain *domain,
+                                    int index, int count, quint32 *counts,
+                                    quint32 &maxCount) const
+{
+    const qreal width = m_size.width();
+    const qreal height = m_size.height();
+    QVector<QPointF> block(qMin(count, int(BlockSize)));
+    for (int first = index; first < index + count; first += BlockSize) {
+        const int blockCount = qMin(int(BlockSize), index + count - first);
+        if (!series->calculateGeometryPoints(domain, first, blockCount, block.data()))
+            return false;
+        for (int i = 0; i < blockCount; i++) {
+            const QPointF &point = block.at(i);
+            // Points outside the plot area, and gaps, are not counted
+            if (isGapPoint(point) || !(point.x() >= 0 && point.x() <= width
+                                       && point.y() >= 0 && point.y() <= height)) {
+                continue;
+            }
+            const int column = qMin(int(point.x() / m_cellSize), m_columns - 1);
+            const int row = qMin(int(point.y() / m_cellSize), m_rows - 1);
+            maxCount = qMax(maxCount, ++counts[row * m_columns + column]);
+        }
+    }
+    return true;
+}
+
+void ScatterDensityGrid::updateMaxCount()
+{
+    m_maxCount = 0;
+    for (int i = 0; i < m_counts.size(); i++)
+        m_maxCount = qMax(m_maxCount, m_counts.at(i));
+}
+
+/*!
+  Counts all points of \a series in cells of \a cellSize pixels covering the plot area of
+  \a domain. Returns false if the points cannot be mapped.
+  */
+bool ScatterDensityGrid::build(const QXYSeriesPrivate *series, const AbstractDomain *domain,
+                               int cellSize)
+{
+    invalidate();
+    m_size = domain->size();
+    m_cellSize = qMax(cellSize, 1);
+    m_columns = qMax(qCeil(m_size.width() / m_cellSize), 1);
+    m_rows = qMax(qCeil(m_size.height() / m_cellSize), 1);
+    m_counts.fill(0, m_columns * m_rows);
+
+    const int count = series->pointBuffer().count();
+    bool ok = true;
+    if (XYGeometryWorkers::isParallel(count)) {
+        // Map one point on this thread first, so that caches shared by the chunks, such as
+        // the logarithms of the points, are built before the workers read them.
+        QPointF point;
+        ok = series->calculateGeometryPoints(domain, 0, 1, &point);
+
+        // Few large chunks, each counted into a grid of its own and merged when done
+        const int chunks = qMin(int(MaxChunks), QThreadPool::globalInstance()->maxThreadCount());
+        const int chunkSize = qMax(int(XYGeometryWorkers::ChunkSize), count / chunks + 1);
+        QMutex mutex;
+        XYGeometryWorkers::run(count, chunkSize, [&](int index, int chunkCount) {
+            QVector<quint32> counts(m_counts.size(), 0);
+            quint32 chunkMaxCount = 0;
+            const bool chunkOk = accumulate(series, domain, index, chunkCount, counts.data(),
+                                            chunkMaxCount);
+            QMutexLocker locker(&mutex);
+            ok = ok && chunkOk;
+            quint32 *target = m_counts.data();
+            for (int i = 0; i < counts.size(); i++)
+                target[i] += counts.at(i);
+        });
+        updateMaxCount();
+    } else {
+        ok = accumulate(series, domain, 0, count, m_counts.data(), m_maxCount);
+    }
+
+    if (!ok) {
+        invalidate();
+        return false;
+    }
+    m_pointCount = count;
+    m_valid = true;
+    return true;
+}
+
+/*!
+  Adds the points of \a series from \a index to its end to the counts, if the grid holds
+  exactly the points before \a index and \a domain has not changed size. Returns false if the
+  grid has to be built again instead.
+  */
+bool ScatterDensityGrid::append(const QXYSeriesPrivate *series, const AbstractDomain *domain,
+                                int index)
+{
+    if (!m_valid || index != m_pointCount || domain->size() != m_size)
+        return false;
+
+    const int count = series->pointBuffer().count() - index;
+    if (!accumulate(series, domain, index, count, m_counts.data(), m_maxCount)) {
+        invalidate();
+        return false;
+    }
+    m_pointCount += count;
+    return true;
+}
+
+/*!
+  Returns the counts as an image with one pixel per cell. Counts are scaled logarithmically
+  between one point and the fullest cell and colored through \a stops, or through \a color
+  with an increasing opacity if there are no stops. Empty cells are transparent.
+  */
+QImage ScatterDensityGrid::image(const QGradientStops &stops, const QColor &color) const
+{
+    if (!m_valid)
+        return QImage();
+
+    // Color table with one entry per step of the scaled count
+    QVector<QRgb> colors(256);
+    if (stops.isEmpty()) {
+        for (int i = 0; i < colors.size(); i++) {
+            QColor stepColor = color;
+            stepColor.setAlphaF(color.alphaF() * (0.25 + 0.75 * i / 255.0));
+            colors[i] = qPremultiply(stepColor.rgba());
+        }
+    } else {
+        QImage ramp(colors.size(), 1, QImage::Format_ARGB32_Premultiplied);
+        ramp.fill(Qt::transparent);
+        QLinearGradient gradient(0, 0, colors.size(), 0);
+        gradient.setStops(stops);
+        QPainter painter(&ramp);
+        painter.fillRect(ramp.rect(), gradient);
+        painter.end();
+        for (int i = 0; i < colors.size(); i++)
+            colors[i] = ramp.pixel(i, 0);
+    }
+
+    QImage image(m_columns, m_rows, QImage::Format_ARGB32_Premultiplied);
+    const qreal scale = m_maxCount > 1 ? 255 / qLn(qreal(m_maxCount)) : 0;
+    for (int row = 0; row < m_rows; row++) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(row));
+        const quint32 *counts = m_counts.constData() + row * m_columns;
+        for (int column = 0; column < m_columns; column++) {
+            const quint32 count = counts[column];
+            line[column] = count ? colors.at(qBound(0, qRound(qLn(qreal(count)) * scale), 255))
+                                 : qRgba(0, 0, 0, 0);
+        }
+    }
+    return image;
+}
+
+QT_CHARTS_END_NAMESPACE
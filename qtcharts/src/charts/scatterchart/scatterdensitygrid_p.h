@@ -0,0 +1,98 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef SCATTERDENSITYGRID_P_H
+#define SCATTERDENSITYGRID_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <QtCore/QSizeF>
+#include <QtCore/QVector>
+#include <QtGui/QBrush>
+#include <QtGui/QImage>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+class AbstractDomain;
+class QXYSeriesPrivate;
+
+/*!
+  \internal
+  Counts the geometry points of a series in a grid of square cells covering the plot area.
+  Large series are counted in parallel chunks, each into a grid of its own that is merged
+  afterwards. Appended points are added to the existing counts; any other change of the data
+  or the domain requires counting again.
+  */
+class QT_CHARTS_PRIVATE_EXPORT ScatterDensityGrid
+{
+public:
+    ScatterDensityGrid();
+
+    bool isValid() const { return m_valid; }
+    void invalidate();
+    bool build(const QXYSeriesPrivate *series, const AbstractDomain *domain, int cellSize);
+    bool append(const QXYSeriesPrivate *series, const AbstractDomain *domain, int index);
+
+    int cellSize() const { return m_cellSize; }
+    int columns() const { return m_columns; }
+    int rows() const { return m_rows; }
+    quint32 count(int column, int row) const { return m_counts.at(row * m_columns + column); }
+    quint32 maxCount() const { return m_maxCount; }
+    int pointCount() const { return m_pointCount; }
+    QImage image(const QGradientStops &stops, const QColor &color) const;
+
+private:
+    enum { BlockSize = 16384, MaxChunks = 8 };
+
+    bool accumulate(const QXYSeriesPrivate *series, const AbstractDomain *domain,
+                    int index, int count, quint32 *counts, quint32 &maxCount) const;
+    void updateMaxCount();
+
+    QSizeF m_size;
+    int m_cellSize;
+    int m_columns;
+    int m_rows;
+    QVector<quint32> m_counts;
+    quint32 m_maxCount;
+    int m_pointCount;
+    bool m_valid;
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // SCATTERDENSITYGRID_P_H
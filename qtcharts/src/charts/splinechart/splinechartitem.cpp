@@ -32,22 +32,106 @@
 #include <private/chartpresenter_p.h>
 #include <private/splineanimation_p.h>
 #include <private/polardomain_p.h>
+#include <private/xydecimator_p.h>
+#include <private/xygeometryworkers_p.h>
+#include <private/charthelpers_p.h>
 #include <QtGui/QPainter>
 #include <QtWidgets/QGraphicsSceneMouseEvent>
+#include <algorithm>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
+namespace {
+
+// A change of one point alters the first control points of the neighbouring segments by a factor
+// of about 2 - sqrt(3) per segment, which falls below the precision of qreal after this many.
+const int SplineInfluenceRows = 32;
+
+// Rows of the first control point system taken over from the previous solution.
+struct TakenRows
+{
+    int first;
+    int last;
+};
+
+// Solves the rows first to last of the system in calculateControlPoints() for both coordinates,
+// taking the first control points next to the range from controlPoints. The first control point
+// of segment i is controlPoints[2 * i].
+bool solveFirstControlPoints(const QVector<QPointF> &points, QVector<QPointF> &controlPoints,
+                             int first, int last)
+{
+    for (int i = first; i <= last + 1; ++i) {
+        if (isGapPoint(points.at(i)))
+            return false;
+    }
+
+    const int rows = points.count() - 1;
+    QVector<qreal> temp(last - first + 1);
+    qreal b = 0;
+    for (int i = first; i <= last; ++i) {
+        QPointF value;
+        qreal diagonal = 4.0;
+        if (i == 0) {
+            value = points.at(0) + 2 * points.at(1);
+            diagonal = 2.0;
+        } else if (i == rows - 1) {
+            value = (8 * points.at(rows - 1) + points.at(rows)) / 2.0;
+            diagonal = 3.5;
+        } else {
+            value = 4 * points.at(i) + 2 * points.at(i + 1);
+        }
+
+        if (i > 0)
+            value -= controlPoints.at(2 * (i - 1));
+        if (i == first) {
+            b = diagonal;
+        } else {
+            temp[i - first] = 1 / b;
+            b = diagonal - temp[i - first];
+        }
+        if (i == last && i < rows - 1)
+            value -= controlPoints.at(2 * (i + 1));
+        controlPoints[2 * i] = value / b;
+    }
+
+    for (int i = last - 1; i >= first; --i)
+        controlPoints[2 * i] -= temp[i + 1 - first] * controlPoints.at(2 * (i + 1));
+    return true;
+}
+
+// Sets the second control points of the segments first to last from the first control points.
+void setSecondControlPoints(const QVector<QPointF> &points, QVector<QPointF> &controlPoints,
+                            int first, int last)
+{
+    const int rows = points.count() - 1;
+    for (int i = first; i <= last; ++i) {
+        if (i < rows - 1)
+            controlPoints[2 * i + 1] = 2 * points.at(i + 1) - controlPoints.at(2 * (i + 1));
+        else
+            controlPoints[2 * i + 1] = (points.at(rows) + controlPoints.at(2 * i)) / 2;
+    }
+}
+
+}
+
 SplineChartItem::SplineChartItem(QSplineSeries *series, QGraphicsItem *item)
     : XYChart(series,item),
       m_series(series),
       m_pointsVisible(false),
+      m_decimation(false),
+      m_controlPointsSolved(false),
+      m_pathRows(-1),
+      m_pathFirstRow(-1),
+      m_pathLastRow(-1),
       m_animation(0),
       m_pointLabelsVisible(false),
       m_pointLabelsFormat(series->pointLabelsFormat()),
       m_pointLabelsFont(series->pointLabelsFont()),
       m_pointLabelsColor(series->pointLabelsColor()),
       m_pointLabelsClipping(true),
-      m_mousePressed(false)
+      m_mousePressed(false),
+      m_shapeValid(false),
+      m_shapeWidth(0)
 {
     setAcceptHoverEvents(true);
     setFlag(QGraphicsItem::ItemIsSelectable);
@@ -70,9 +154,28 @@ QRectF SplineChartItem::boundingRect() const
     return m_rect;
 }
 
+/*!
+  Returns the stroked outline of the spline, created on first use. Series without receivers for
+  the click and hover signals do not take part in hit testing and return an empty shape.
+  */
 QPainterPath SplineChartItem::shape() const
 {
-    return m_fullPath;
+    if (!m_series->d_func()->hasInteractionReceivers())
+        return QPainterPath();
+
+    if (!m_shapeValid) {
+        QPainterPathStroker stroker;
+        // The full path is comprised of three separate paths.
+        // This is why we are prepared for the "worst case" scenario, i.e. use always MiterJoin and
+        // multiply line width with square root of two when defining shape and bounding rectangle.
+        stroker.setWidth(m_shapeWidth);
+        stroker.setJoinStyle(Qt::MiterJoin);
+        stroker.setCapStyle(Qt::SquareCap);
+        stroker.setMiterLimit(m_linePen.miterLimit());
+        m_shapePath = stroker.createStroke(m_fullPath);
+        m_shapeValid = true;
+    }
+    return m_shapePath;
 }
 
 void SplineChartItem::setAnimation(SplineAnimation *animation)
@@ -89,6 +192,19 @@ ChartAnimation *SplineChartItem::animation() const
 void SplineChartItem::setControlGeometryPoints(QVector<QPointF>& points)
 {
     m_controlPoints = points;
+    m_controlPointsSolved = false;
+    m_pathFirstRow = -1;
+}
+
+/*!
+  Exchanges the control points with \a points, so that animations can alternate between two
+  buffers instead of allocating one per frame.
+  */
+void SplineChartItem::swapControlGeometryPoints(QVector<QPointF> &points)
+{
+    m_controlPoints.swap(points);
+    m_controlPointsSolved = false;
+    m_pathFirstRow = -1;
 }
 
 QVector<QPointF> SplineChartItem::controlGeometryPoints() const
@@ -99,14 +215,40 @@ QVector<QPointF> SplineChartItem::controlGeometryPoints() const
 void SplineChartItem::updateChart(QVector<QPointF> &oldPoints, QVector<QPointF> &newPoints, int index)
 {
     QVector<QPointF> controlPoints;
-    if (newPoints.count() >= 2)
-        controlPoints = calculateControlPoints(newPoints);
+    bool solved = false;
+    m_pathFirstRow = -1;
+    if (newPoints.count() >= 2) {
+        // Without an animation the previous control points are not needed any more and are
+        // updated in place
+        int firstRow = 0;
+        int lastRow = 0;
+        if (m_controlPointsSolved && !m_animation
+                && m_controlPoints.count() == 2 * oldPoints.count() - 2) {
+            controlPoints.swap(m_controlPoints);
+            solved = updateControlPoints(newPoints, controlPoints, m_geometryChange,
+                                         &firstRow, &lastRow);
+        }
+        if (solved) {
+            // Replaced or appended points only move the segments next to them in the path
+            const XYGeometryChange &change = m_geometryChange;
+            if (change.dropped == 0 && (change.removed == change.added
+                                        || (change.removed == 0
+                                            && change.index == oldPoints.count()))) {
+                m_pathFirstRow = firstRow;
+                m_pathLastRow = lastRow;
+            }
+        } else {
+            controlPoints = calculateControlPoints(newPoints);
+            solved = std::none_of(newPoints.cbegin(), newPoints.cend(), isGapPoint);
+        }
+    }
 
     if (m_animation)
         m_animation->setup(oldPoints, newPoints, m_controlPoints, controlPoints, index);
 
     m_points = newPoints;
     m_controlPoints = controlPoints;
+    m_controlPointsSolved = solved;
     setDirty(false);
 
     if (m_animation)
@@ -115,14 +257,29 @@ void SplineChartItem::updateChart(QVector<QPointF> &oldPoints, QVector<QPointF>
         updateGeometry();
 }
 
+void SplineChartItem::mapGeometry(const QTransform &transform)
+{
+    XYChart::mapGeometry(transform);
+    // The spline system is affine, so the control points follow the points.
+    m_controlPoints = transform.map(QPolygonF(m_controlPoints));
+    // The path is rebuilt from the mapped points by the next update
+    m_pathRows = -1;
+}
+
 void SplineChartItem::updateGeometry()
 {
     const QVector<QPointF> &points = m_points;
     const QVector<QPointF> &controlPoints = m_controlPoints;
 
+    const int pathFirstRow = m_pathFirstRow;
+    m_pathFirstRow = -1;
     if ((points.size() < 2) || (controlPoints.size() < 2)) {
         prepareGeometryChange();
+        m_pathRows = -1;
         m_path = QPainterPath();
+        m_fullPath = QPainterPath();
+        m_shapePath = QPainterPath();
+        m_shapeValid = true;
         m_rect = QRect();
         return;
     }
@@ -131,6 +288,10 @@ void SplineChartItem::updateGeometry()
 
     QPainterPath splinePath;
     QPainterPath fullPath;
+    // Whether the path is built from the points and the control points as they are, and whether
+    // it was extended by the segments next to a change only
+    bool pathFromPoints = false;
+    bool pathTailUpdated = false;
     // Use worst case scenario to determine required margin.
     qreal margin = m_linePen.width() * 1.42;
 
@@ -282,40 +443,222 @@ void SplineChartItem::updateGeometry()
         // Note: This construction of m_fullpath is not perfect. The partial segments that are
         // outside left/right clip regions at axis boundary still generate hover/click events,
         // because shape doesn't get clipped. It doesn't seem possible to do sensibly.
-    } else { // not polar
-        splinePath.moveTo(points.at(0));
+    } else if (m_decimation && points.size() > domain()->size().width()) { // decimated
+        // With more segments than pixel columns, each curve segment is contained in its
+        // sub-pixel control polygon, so draw the decimated control polygon as a polyline.
+        QVector<QPointF> polygon;
+        polygon.resize(points.size() * 3 - 2);
+        polygon[0] = points.at(0);
         for (int i = 0; i < points.size() - 1; i++) {
-            const QPointF &point = points.at(i + 1);
-            splinePath.cubicTo(controlPoints[2 * i], controlPoints[2 * i + 1], point);
+            polygon[3 * i + 1] = controlPoints[2 * i];
+            polygon[3 * i + 2] = controlPoints[2 * i + 1];
+            polygon[3 * i + 3] = points.at(i + 1);
+        }
+        polygon = XYDecimator::decimate(polygon);
+        // Gaps in the data start a new subpath
+        bool gap = true;
+        for (int i = 0; i < polygon.size(); i++) {
+            const QPointF &point = polygon.at(i);
+            if (isGapPoint(point)) {
+                gap = true;
+                continue;
+            }
+            if (gap)
+                splinePath.moveTo(point);
+            else
+                splinePath.lineTo(point);
+            gap = false;
+        }
+        fullPath = splinePath;
+    } else if (updatePathTail(points, controlPoints, pathFirstRow)) { // only segments near a change
+        splinePath = m_path;
+        fullPath = m_path;
+        pathFromPoints = true;
+        pathTailUpdated = true;
+    } else if (updatePathPositions(points, controlPoints)) { // only the positions changed
+        splinePath = m_path;
+        fullPath = m_path;
+        pathFromPoints = true;
+    } else { // not polar
+        pathFromPoints = true;
+        // Gaps in the data start a new subpath
+        bool gap = true;
+        for (int i = 0; i < points.size(); i++) {
+            const QPointF &point = points.at(i);
+            if (isGapPoint(point)) {
+                gap = true;
+                continue;
+            }
+            if (gap)
+                splinePath.moveTo(point);
+            else
+                splinePath.cubicTo(controlPoints[2 * i - 2], controlPoints[2 * i - 1], point);
+            gap = false;
         }
         fullPath = splinePath;
     }
 
-    QPainterPathStroker stroker;
-    // The full path is comprised of three separate paths.
-    // This is why we are prepared for the "worst case" scenario, i.e. use always MiterJoin and
-    // multiply line width with square root of two when defining shape and bounding rectangle.
-    stroker.setWidth(margin);
-    stroker.setJoinStyle(Qt::MiterJoin);
-    stroker.setCapStyle(Qt::SquareCap);
-    stroker.setMiterLimit(m_linePen.miterLimit());
+    // The stroked shape is only needed for hit testing and is created lazily in shape(). The
+    // bounding rectangle is estimated from the path and the stroke width instead. A path
+    // extended near a change has the previous bounds extended by the new segments, so that the
+    // whole path need not be scanned.
+    const QRectF bounds = pathTailUpdated ? m_pathBounds : fullPath.boundingRect();
+    const QRectF splineBounds = pathTailUpdated ? m_pathBounds : splinePath.boundingRect();
+    const QRectF rect = fullPath.isEmpty()
+            ? QRectF() : strokeBoundingRect(bounds, margin, m_linePen.miterLimit());
 
     // Only zoom in if the bounding rects of the path fit inside int limits. QWidget::update() uses
     // a region that has to be compatible with QRect.
-    QPainterPath checkShapePath = stroker.createStroke(fullPath);
-    if (checkShapePath.boundingRect().height() <= INT_MAX
-            && checkShapePath.boundingRect().width() <= INT_MAX
-            && splinePath.boundingRect().height() <= INT_MAX
-            && splinePath.boundingRect().width() <= INT_MAX) {
+    m_pathRows = -1;
+    if (rect.height() <= INT_MAX
+            && rect.width() <= INT_MAX
+            && splineBounds.height() <= INT_MAX
+            && splineBounds.width() <= INT_MAX) {
         m_path = splinePath;
+        m_pathBounds = bounds;
+        // Only a path with a curve for every segment can later be extended near a change
+        if (pathFromPoints && m_path.elementCount() == 3 * points.size() - 2)
+            m_pathRows = points.size() - 1;
 
         prepareGeometryChange();
 
-        m_fullPath = checkShapePath;
-        m_rect = m_fullPath.boundingRect();
+        m_fullPath = fullPath;
+        m_shapePath = QPainterPath();
+        m_shapeValid = false;
+        m_shapeWidth = margin;
+        m_rect = rect;
     }
 }
 
+/*!
+  Rewrites the segments \a firstRow to the last one updated by updateControlPoints() in the
+  current path and appends the segments of appended points, if the path was built from the
+  previous points with a curve for every segment and only points were replaced or appended. The
+  bounds of the path are extended by the rewritten segments. The work is thus bounded by the size
+  of the change. Returns false, leaving the path unchanged, otherwise.
+  */
+bool SplineChartItem::updatePathTail(const QVector<QPointF> &points,
+                                     const QVector<QPointF> &controlPoints, int firstRow)
+{
+    const int rows = points.size() - 1;
+    const int lastRow = m_pathLastRow;
+    if (firstRow < 0 || m_pathRows < 0 || m_pathRows > rows || lastRow >= rows
+            || (m_pathRows < rows && lastRow != rows - 1)
+            || m_path.elementCount() != 3 * m_pathRows + 1) {
+        return false;
+    }
+
+    // QPainterPath drops curves whose points all coincide, so those need a new path
+    if (isGapPoint(points.at(firstRow)))
+        return false;
+    for (int i = firstRow; i <= lastRow; ++i) {
+        const QPointF &cp1 = controlPoints.at(2 * i);
+        const QPointF &cp2 = controlPoints.at(2 * i + 1);
+        if (isGapPoint(points.at(i + 1))
+                || (points.at(i) == cp1 && cp1 == cp2 && cp2 == points.at(i + 1))) {
+            return false;
+        }
+    }
+
+    // Drop the shared copies so that the path is modified without being copied
+    m_fullPath = QPainterPath();
+    m_shapePath = QPainterPath();
+    m_shapeValid = false;
+    qreal left = m_pathBounds.left();
+    qreal top = m_pathBounds.top();
+    qreal right = m_pathBounds.right();
+    qreal bottom = m_pathBounds.bottom();
+    const auto extend = [&](const QPointF &point) {
+        left = qMin(left, point.x());
+        right = qMax(right, point.x());
+        top = qMin(top, point.y());
+        bottom = qMax(bottom, point.y());
+    };
+    if (firstRow == 0) {
+        m_path.setElementPositionAt(0, points.at(0).x(), points.at(0).y());
+        extend(points.at(0));
+    }
+    for (int i = firstRow; i <= lastRow; ++i) {
+        const QPointF &cp1 = controlPoints.at(2 * i);
+        const QPointF &cp2 = controlPoints.at(2 * i + 1);
+        const QPointF &point = points.at(i + 1);
+        if (i < m_pathRows) {
+            m_path.setElementPositionAt(3 * i + 1, cp1.x(), cp1.y());
+            m_path.setElementPositionAt(3 * i + 2, cp2.x(), cp2.y());
+            m_path.setElementPositionAt(3 * i + 3, point.x(), point.y());
+        } else {
+            m_path.cubicTo(cp1, cp2, point);
+        }
+        extend(cp1);
+        extend(cp2);
+        extend(point);
+    }
+    m_pathBounds = QRectF(QPointF(left, top), QPointF(right, bottom));
+    m_fullPath = m_path;
+    return true;
+}
+
+/*!
+  Moves the elements of the current path to \a points and \a controlPoints if the path has
+  exactly the elements that building it from them would create, as for the frames of an
+  animation or points replaced in place. The path storage is then reused instead of building a
+  new path. Returns false, leaving the path unchanged, if the layout differs.
+  */
+bool SplineChartItem::updatePathPositions(const QVector<QPointF> &points,
+                                          const QVector<QPointF> &controlPoints)
+{
+    const int elementCount = m_path.elementCount();
+    if (elementCount == 0 || elementCount > points.size() * 3)
+        return false;
+
+    // Check the layout first: a move for the first point after a gap, a curve otherwise.
+    // QPainterPath drops curves whose points all coincide, so those need a new path.
+    int element = 0;
+    bool gap = true;
+    for (int i = 0; i < points.size(); i++) {
+        const QPointF &point = points.at(i);
+        if (isGapPoint(point)) {
+            gap = true;
+            continue;
+        }
+        const QPainterPath::ElementType type = gap ? QPainterPath::MoveToElement
+                                                   : QPainterPath::CurveToElement;
+        if (element >= elementCount || m_path.elementAt(element).type != type)
+            return false;
+        if (!gap && points.at(i - 1) == controlPoints.at(2 * i - 2)
+                && controlPoints.at(2 * i - 2) == controlPoints.at(2 * i - 1)
+                && controlPoints.at(2 * i - 1) == point) {
+            return false;
+        }
+        element += gap ? 1 : 3;
+        gap = false;
+    }
+    if (element != elementCount)
+        return false;
+
+    // Drop the shared copy so that the path is modified without being copied
+    m_fullPath = QPainterPath();
+    element = 0;
+    gap = true;
+    for (int i = 0; i < points.size(); i++) {
+        const QPointF &point = points.at(i);
+        if (isGapPoint(point)) {
+            gap = true;
+            continue;
+        }
+        if (!gap) {
+            const QPointF &cp1 = controlPoints.at(2 * i - 2);
+            const QPointF &cp2 = controlPoints.at(2 * i - 1);
+            m_path.setElementPositionAt(element++, cp1.x(), cp1.y());
+            m_path.setElementPositionAt(element++, cp2.x(), cp2.y());
+        }
+        m_path.setElementPositionAt(element++, point.x(), point.y());
+        gap = false;
+    }
+    m_fullPath = m_path;
+    return true;
+}
+
 /*!
   Calculates control points which are needed by QPainterPath.cubicTo function to draw the cubic Bezier cureve between two points.
   */
@@ -324,6 +667,28 @@ QVector<QPointF> SplineChartItem::calculateControlPoints(const QVector<QPointF>
     QVector<QPointF> controlPoints;
     controlPoints.resize(points.count() * 2 - 2);
 
+    // Gaps split the points into runs that are solved separately. Segments
+    // touching a gap get NaN control points and are not drawn.
+    int gap = 0;
+    while (gap < points.count() && !isGapPoint(points.at(gap)))
+        gap++;
+    if (gap < points.count()) {
+        controlPoints.fill(QPointF(qQNaN(), qQNaN()));
+        int first = 0;
+        while (first < points.count()) {
+            int last = first;
+            while (last < points.count() && !isGapPoint(points.at(last)))
+                last++;
+            if (last - first >= 2) {
+                const QVector<QPointF> runControlPoints = calculateControlPoints(points.mid(first, last - first));
+                std::copy(runControlPoints.cbegin(), runControlPoints.cend(),
+                          controlPoints.begin() + 2 * first);
+            }
+            first = last + 1;
+        }
+        return controlPoints;
+    }
+
     int n = points.count() - 1;
 
     if (n == 1) {
@@ -347,27 +712,31 @@ QVector<QPointF> SplineChartItem::calculateControlPoints(const QVector<QPointF>
     //  |   0   0   0   0   0   0   0   0   ... 1   4   1   |   |   P1_(n-1)|   |   4 * P(n-2) + 2 * P(n-1) |
     //  |   0   0   0   0   0   0   0   0   ... 0   2   7   |   |   P1_n    |   |   8 * P(n-1) + Pn         |
     //
-    QVector<qreal> vector;
-    vector.resize(n);
-
-    vector[0] = points[0].x() + 2 * points[1].x();
+    // The x and y systems are independent; large ones are solved concurrently.
+    QVector<qreal> xControl;
+    QVector<qreal> yControl;
+    const auto solve = [&](int axis) {
+        const auto coordinate = [&](int i) { return axis == 0 ? points[i].x() : points[i].y(); };
 
+        QVector<qreal> vector;
+        vector.resize(n);
 
-    for (int i = 1; i < n - 1; ++i)
-        vector[i] = 4 * points[i].x() + 2 * points[i + 1].x();
+        vector[0] = coordinate(0) + 2 * coordinate(1);
 
-    vector[n - 1] = (8 * points[n - 1].x() + points[n].x()) / 2.0;
+        for (int i = 1; i < n - 1; ++i)
+            vector[i] = 4 * coordinate(i) + 2 * coordinate(i + 1);
 
-    QVector<qreal> xControl = firstControlPoints(vector);
+        vector[n - 1] = (8 * coordinate(n - 1) + coordinate(n)) / 2.0;
 
-    vector[0] = points[0].y() + 2 * points[1].y();
+        (axis == 0 ? xControl : yControl) = firstControlPoints(vector);
+    };
 
-    for (int i = 1; i < n - 1; ++i)
-        vector[i] = 4 * points[i].y() + 2 * points[i + 1].y();
-
-    vector[n - 1] = (8 * points[n - 1].y() + points[n].y()) / 2.0;
-
-    QVector<qreal> yControl = firstControlPoints(vector);
+    if (XYGeometryWorkers::isParallel(n)) {
+        XYGeometryWorkers::run(2, 1, [&](int axis, int) { solve(axis); });
+    } else {
+        solve(0);
+        solve(1);
+    }
 
     for (int i = 0, j = 0; i < n; ++i, ++j) {
 
@@ -387,6 +756,81 @@ QVector<QPointF> SplineChartItem::calculateControlPoints(const QVector<QPointF>
     return controlPoints;
 }
 
+/*!
+  Updates \a controlPoints, the control points of the previous points, in place to those of
+  \a points, which differ from the previous points by \a change. First control points further
+  than SplineInfluenceRows segments from the change and from the ends it moved are taken over;
+  only the rows in between are solved again, pinned to the taken-over neighbours, so that the
+  solving is bounded by the size of the change rather than the number of points. \a firstRow and
+  \a lastRow receive the range of segments whose control points were rewritten. Returns false,
+  leaving \a controlPoints undefined, if a full calculation is needed.
+  */
+bool SplineChartItem::updateControlPoints(const QVector<QPointF> &points,
+                                          QVector<QPointF> &controlPoints,
+                                          const XYGeometryChange &change,
+                                          int *firstRow, int *lastRow)
+{
+    const int rows = points.count() - 1;
+    const int oldRows = controlPoints.count() / 2;
+    if (change.dropped < 0 || rows < 4 * SplineInfluenceRows
+            || oldRows < 4 * SplineInfluenceRows || controlPoints.count() != 2 * oldRows
+            || oldRows - change.dropped - change.removed + change.added != rows) {
+        return false;
+    }
+
+    // Row i of the system depends on points i and i + 1, and the first and last rows differ from
+    // the others, so a row is taken over only if its points are unchanged and it stays a first,
+    // last or inner row. Rows before the change keep their offset from the head, rows after it
+    // their offset from the tail.
+    const int dropped = change.dropped;
+    const int tailShift = dropped + change.removed - change.added;
+    TakenRows taken[2] = {
+        { dropped > 0 ? 1 : 0, qMin(change.index - 2, qMin(rows - 2, oldRows - 2 - dropped)) },
+        { qMax(change.index + change.added, tailShift != 0 ? qMax(1, 1 - tailShift) : 0), rows - 1 }
+    };
+
+    // Keep clear of the changed rows by the range of their influence
+    int reused = 0;
+    for (int k = 0; k < 2; ++k) {
+        if (taken[k].first > 0)
+            taken[k].first += SplineInfluenceRows;
+        if (taken[k].last < rows - 1)
+            taken[k].last -= SplineInfluenceRows;
+        reused += qMax(0, taken[k].last - taken[k].first + 1);
+    }
+    if (reused < rows / 2)
+        return false;
+
+    // Move the taken-over rows to their new positions
+    if (dropped > 0)
+        controlPoints.remove(0, 2 * dropped);
+    const int added = change.added - change.removed;
+    if (added > 0)
+        controlPoints.insert(qMin(2 * change.index, controlPoints.count()), 2 * added, QPointF());
+    else if (added < 0)
+        controlPoints.remove(qMin(2 * change.index, controlPoints.count() + 2 * added), -2 * added);
+
+    // Solve the rows in between
+    int row = 0;
+    *firstRow = rows;
+    *lastRow = -1;
+    for (int k = 0; k <= 2; ++k) {
+        if (k < 2 && taken[k].first > taken[k].last)
+            continue;
+        const int end = k < 2 ? taken[k].first : rows;
+        if (end > row) {
+            if (!solveFirstControlPoints(points, controlPoints, row, end - 1))
+                return false;
+            setSecondControlPoints(points, controlPoints, qMax(0, row - 1), end - 1);
+            *firstRow = qMin(*firstRow, qMax(0, row - 1));
+            *lastRow = end - 1;
+        }
+        if (k < 2)
+            row = taken[k].last + 1;
+    }
+    return true;
+}
+
 QVector<qreal> SplineChartItem::firstControlPoints(const QVector<qreal>& vector)
 {
     QVector<qreal> result;
@@ -417,6 +861,8 @@ QVector<qreal> SplineChartItem::firstControlPoints(const QVector<qreal>& vector)
 
 void SplineChartItem::handleUpdated()
 {
+    const bool decimationChanged = m_decimation != m_series->decimation();
+    m_decimation = m_series->decimation();
     setVisible(m_series->isVisible());
     setOpacity(m_series->opacity());
     m_pointsVisible = m_series->pointsVisible();
@@ -428,6 +874,8 @@ void SplineChartItem::handleUpdated()
     m_pointLabelsFont = m_series->pointLabelsFont();
     m_pointLabelsColor = m_series->pointLabelsColor();
     m_pointLabelsClipping = m_series->pointLabelsClipping();
+    if (decimationChanged)
+        updateGeometry();
     update();
 }
 
@@ -440,8 +888,16 @@ void SplineChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *o
 
     QRectF clipRect = QRectF(QPointF(0, 0), domain()->size());
 
+    // While following an interaction with an item transform, map the clip
+    // into item coordinates and keep the line width unscaled
+    QPen linePen = m_linePen;
+    if (!transform().isIdentity()) {
+        clipRect = transform().inverted().mapRect(clipRect);
+        linePen.setCosmetic(true);
+    }
+
     painter->save();
-    painter->setPen(m_linePen);
+    painter->setPen(linePen);
     painter->setBrush(Qt::NoBrush);
 
     if (m_series->chart()->chartType() == QChart::ChartTypePolar) {
@@ -475,7 +931,8 @@ void SplineChartItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *o
             painter->setClipping(true);
         else
             painter->setClipping(false);
-        m_series->d_func()->drawSeriesPointLabels(painter, m_points, m_linePen.width() / 2);
+        m_series->d_func()->drawSeriesPointLabels(painter, m_points, m_linePen.width() / 2,
+                                                  m_firstIndex, &geometrySource());
     }
 
     painter->restore();
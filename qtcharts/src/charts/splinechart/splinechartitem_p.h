@@ -58,21 +58,31 @@ public:
     QRectF boundingRect() const;
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
     QPainterPath shape() const;
+    QPainterPath path() const { return m_fullPath; }
 
     void setControlGeometryPoints(QVector<QPointF>& points);
+    void swapControlGeometryPoints(QVector<QPointF> &points);
     QVector<QPointF> controlGeometryPoints() const;
 
     void setAnimation(SplineAnimation *animation);
     ChartAnimation *animation() const;
 
+    static QVector<QPointF> calculateControlPoints(const QVector<QPointF> &points);
+    static bool updateControlPoints(const QVector<QPointF> &points, QVector<QPointF> &controlPoints,
+                                    const XYGeometryChange &change, int *firstRow, int *lastRow);
+
 public Q_SLOTS:
     void handleUpdated();
 
 protected:
     void updateGeometry();
-    QVector<QPointF> calculateControlPoints(const QVector<QPointF> &points);
-    QVector<qreal> firstControlPoints(const QVector<qreal>& vector);
+    static QVector<qreal> firstControlPoints(const QVector<qreal>& vector);
+    bool updatePathTail(const QVector<QPointF> &points, const QVector<QPointF> &controlPoints,
+                        int firstRow);
+    bool updatePathPositions(const QVector<QPointF> &points, const QVector<QPointF> &controlPoints);
     void updateChart(QVector<QPointF> &oldPoints, QVector<QPointF> &newPoints, int index);
+    bool acceptsGeometryTransform() const { return true; }
+    void mapGeometry(const QTransform &transform);
     void mousePressEvent(QGraphicsSceneMouseEvent *event);
     void hoverEnterEvent(QGraphicsSceneHoverEvent *event);
     void hoverLeaveEvent(QGraphicsSceneHoverEvent *event);
@@ -85,11 +95,18 @@ private:
     QPainterPath m_pathPolarRight;
     QPainterPath m_pathPolarLeft;
     QPainterPath m_fullPath;
+    mutable QPainterPath m_shapePath;
     QRectF m_rect;
     QPen m_linePen;
     QPen m_pointPen;
     bool m_pointsVisible;
+    bool m_decimation;
     QVector<QPointF> m_controlPoints;
+    bool m_controlPointsSolved;
+    int m_pathRows;
+    int m_pathFirstRow;
+    int m_pathLastRow;
+    QRectF m_pathBounds;
     QVector<QPointF> m_visiblePoints;
     SplineAnimation *m_animation;
 
@@ -102,6 +119,9 @@ private:
     QPointF m_lastMousePos;
     bool m_mousePressed;
 
+    mutable bool m_shapeValid;
+    qreal m_shapeWidth;
+
     friend class SplineAnimation;
 };
 
@@ -29,6 +29,9 @@
 
 #include "private/glxyseriesdata_p.h"
 #include "private/abstractdomain_p.h"
+#include "private/qxyseries_p.h"
+#include "private/charthelpers_p.h"
+#include <QtCore/QtMath>
 #include <QtCharts/QScatterSeries>
 
 QT_CHARTS_BEGIN_NAMESPACE
@@ -94,18 +97,53 @@ void GLXYSeriesDataManager::setPoints(QXYSeries *series, const AbstractDomain *d
         }
     }
     int count = series->count();
+
+    // With decimation enabled, upload only a few min/max points per pixel column
+    // of the visible x range instead of the whole series.
+    QVector<QPointF> reducedPoints;
+    const QXYSeriesPrivate *d = series->d_func();
+    if (d->useReducedPoints()) {
+        const XYSeriesBuffer &buffer = d->pointBuffer();
+        const int first = qMax(0, buffer.lowerBound(domain->minX()) - 1);
+        const int last = qMin(count, buffer.upperBound(domain->maxX()) + 1);
+        qreal logBaseX = 0;
+        qreal logBaseY = 0;
+        if (!domain->logBases(logBaseX, logBaseY))
+            logBaseX = 0;
+        const qreal columnSpan = XYSeriesLod::columnSpan(domain->minX(), domain->maxX(), logBaseX,
+                                                         domain->size().width());
+        reducedPoints = d->reducedPoints(first, last - first,
+                                         qCeil(domain->size().width()), columnSpan, logBaseX);
+        if (!reducedPoints.isEmpty())
+            count = reducedPoints.size();
+    }
+
     int index = 0;
     array.resize(count * 2);
     QMatrix4x4 matrix;
     if (logAxis) {
         // Use domain to resolve geometry points. Not as fast as shaders, but simpler that way
-        QVector<QPointF> geometryPoints = domain->calculateGeometryPoints(series->pointsVector());
+        QVector<QPointF> geometryPoints;
+        if (!reducedPoints.isEmpty()) {
+            geometryPoints = domain->calculateGeometryPoints(reducedPoints);
+        } else {
+            geometryPoints.resize(count);
+            if (!d->calculateGeometryPoints(domain, 0, count, geometryPoints.data()))
+                geometryPoints.clear();
+        }
         const float height = domain->size().height();
         if (geometryPoints.size()) {
+            // Line strips cannot have gaps, so non-positive values repeat the previous vertex
+            int first = 0;
+            while (first < count - 1 && isGapPoint(geometryPoints.at(first)))
+                first++;
+            QPointF previous = geometryPoints.at(first);
             for (int i = 0; i < count; i++) {
                 const QPointF &point = geometryPoints.at(i);
-                array[index++] = float(point.x());
-                array[index++] = float(height - point.y());
+                if (!isGapPoint(point))
+                    previous = point;
+                array[index++] = float(previous.x());
+                array[index++] = float(height - previous.y());
             }
         } else {
             // If there are invalid log values, geometry points generation fails
@@ -122,11 +160,34 @@ void GLXYSeriesDataManager::setPoints(QXYSeries *series, const AbstractDomain *d
             matrix.scale(-1.0, 1.0);
         if (reverseY)
             matrix.scale(1.0, -1.0);
-        QVector<QPointF> seriesPoints = series->pointsVector();
-        for (int i = 0; i < count; i++) {
-            const QPointF &point = seriesPoints.at(i);
-            array[index++] = float(point.x());
-            array[index++] = float(point.y());
+        if (!reducedPoints.isEmpty()) {
+            for (int i = 0; i < count; i++) {
+                const QPointF &point = reducedPoints.at(i);
+                array[index++] = float(point.x());
+                array[index++] = float(point.y());
+            }
+        } else if (series->storageLayout() == QXYSeries::StorageLayoutColumns) {
+            const qreal *x = series->xData();
+            const qreal *y = series->yData();
+            for (int i = 0; i < count; i++) {
+                array[index++] = float(x[i]);
+                array[index++] = float(y[i]);
+            }
+        } else if (series->storageLayout() == QXYSeries::StorageLayoutUniformX) {
+            const qreal x0 = series->samplingOrigin();
+            const qreal dx = series->samplingInterval();
+            const qreal *y = series->yData();
+            for (int i = 0; i < count; i++) {
+                array[index++] = float(x0 + i * dx);
+                array[index++] = float(y[i]);
+            }
+        } else {
+            QVector<QPointF> seriesPoints = series->pointsVector();
+            for (int i = 0; i < count; i++) {
+                const QPointF &point = seriesPoints.at(i);
+                array[index++] = float(point.x());
+                array[index++] = float(point.y());
+            }
         }
         data->min = QVector2D(domain->minX(), domain->minY());
         data->delta = QVector2D((domain->maxX() - domain->minX()) / 2.0f,
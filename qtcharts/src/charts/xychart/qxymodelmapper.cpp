@@ -104,8 +104,11 @@ void QXYModelMapper::setSeries(QXYSeries *series)
     d->initializeXYFromModel();
     // connect the signals from the series
     connect(d->m_series, SIGNAL(pointAdded(int)), d, SLOT(handlePointAdded(int)));
+    connect(d->m_series, SIGNAL(pointsAdded(int,int)), d, SLOT(handlePointsAdded(int,int)));
+    connect(d->m_series, SIGNAL(pointsAdvanced(int,int)), d, SLOT(handlePointsAdvanced(int,int)));
     connect(d->m_series, SIGNAL(pointRemoved(int)), d, SLOT(handlePointRemoved(int)));
     connect(d->m_series, SIGNAL(pointReplaced(int)), d, SLOT(handlePointReplaced(int)));
+    connect(d->m_series, SIGNAL(pointRangeReplaced(int,int)), d, SLOT(handlePointRangeReplaced(int,int)));
     connect(d->m_series, SIGNAL(destroyed()), d, SLOT(handleSeriesDestroyed()));
     connect(d->m_series, SIGNAL(pointsRemoved(int,int)), d, SLOT(handlePointsRemoved(int,int)));
 }
@@ -302,8 +305,57 @@ void QXYModelMapperPrivate::handlePointAdded(int pointPos)
     else
         m_model->insertColumns(pointPos + m_first, 1);
 
-    setValueToModel(xModelIndex(pointPos), m_series->points().at(pointPos).x());
-    setValueToModel(yModelIndex(pointPos), m_series->points().at(pointPos).y());
+    setValueToModel(xModelIndex(pointPos), m_series->at(pointPos).x());
+    setValueToModel(yModelIndex(pointPos), m_series->at(pointPos).y());
+    blockModelSignals(false);
+}
+
+void QXYModelMapperPrivate::handlePointsAdded(int pointPos, int count)
+{
+    if (m_seriesSignalsBlock)
+        return;
+
+    if (m_count != -1)
+        m_count += count;
+
+    blockModelSignals();
+    if (m_orientation == Qt::Vertical)
+        m_model->insertRows(pointPos + m_first, count);
+    else
+        m_model->insertColumns(pointPos + m_first, count);
+
+    const QVector<QPointF> points = m_series->pointsVector();
+    for (int i = pointPos; i < pointPos + count; i++) {
+        setValueToModel(xModelIndex(i), points.at(i).x());
+        setValueToModel(yModelIndex(i), points.at(i).y());
+    }
+    blockModelSignals(false);
+}
+
+void QXYModelMapperPrivate::handlePointsAdvanced(int removedCount, int addedCount)
+{
+    if (m_seriesSignalsBlock)
+        return;
+
+    if (m_count != -1)
+        m_count += addedCount - removedCount;
+
+    // The oldest points were evicted from the beginning and new ones appended to the end
+    blockModelSignals();
+    const int pointPos = m_series->count() - addedCount;
+    if (m_orientation == Qt::Vertical) {
+        m_model->removeRows(m_first, removedCount);
+        m_model->insertRows(pointPos + m_first, addedCount);
+    } else {
+        m_model->removeColumns(m_first, removedCount);
+        m_model->insertColumns(pointPos + m_first, addedCount);
+    }
+
+    const QVector<QPointF> points = m_series->pointsVector();
+    for (int i = pointPos; i < pointPos + addedCount; i++) {
+        setValueToModel(xModelIndex(i), points.at(i).x());
+        setValueToModel(yModelIndex(i), points.at(i).y());
+    }
     blockModelSignals(false);
 }
 
@@ -347,8 +399,21 @@ void QXYModelMapperPrivate::handlePointReplaced(int pointPos)
         return;
 
     blockModelSignals();
-    setValueToModel(xModelIndex(pointPos), m_series->points().at(pointPos).x());
-    setValueToModel(yModelIndex(pointPos), m_series->points().at(pointPos).y());
+    setValueToModel(xModelIndex(pointPos), m_series->at(pointPos).x());
+    setValueToModel(yModelIndex(pointPos), m_series->at(pointPos).y());
+    blockModelSignals(false);
+}
+
+void QXYModelMapperPrivate::handlePointRangeReplaced(int pointPos, int count)
+{
+    if (m_seriesSignalsBlock)
+        return;
+
+    blockModelSignals();
+    for (int i = pointPos; i < pointPos + count; i++) {
+        setValueToModel(xModelIndex(i), m_series->at(i).x());
+        setValueToModel(yModelIndex(i), m_series->at(i).y());
+    }
     blockModelSignals(false);
 }
 
@@ -366,8 +431,9 @@ void QXYModelMapperPrivate::modelUpdated(QModelIndex topLeft, QModelIndex bottom
         return;
 
     blockSeriesSignals();
+    // merge the replaced points into a single notification
+    m_series->beginUpdate();
     QModelIndex index;
-    QPointF oldPoint;
     QPointF newPoint;
     for (int row = topLeft.row(); row <= bottomRight.row(); row++) {
         for (int column = topLeft.column(); column <= bottomRight.column(); column++) {
@@ -377,7 +443,6 @@ void QXYModelMapperPrivate::modelUpdated(QModelIndex topLeft, QModelIndex bottom
                     QModelIndex xIndex = xModelIndex(index.row() - m_first);
                     QModelIndex yIndex = yModelIndex(index.row() - m_first);
                     if (xIndex.isValid() && yIndex.isValid()) {
-                        oldPoint = m_series->points().at(index.row() - m_first);
                         newPoint.setX(valueFromModel(xIndex));
                         newPoint.setY(valueFromModel(yIndex));
                         m_series->replace(index.row() - m_first, newPoint);
@@ -388,7 +453,6 @@ void QXYModelMapperPrivate::modelUpdated(QModelIndex topLeft, QModelIndex bottom
                     QModelIndex xIndex = xModelIndex(index.column() - m_first);
                     QModelIndex yIndex = yModelIndex(index.column() - m_first);
                     if (xIndex.isValid() && yIndex.isValid()) {
-                        oldPoint = m_series->points().at(index.column() - m_first);
                         newPoint.setX(valueFromModel(xIndex));
                         newPoint.setY(valueFromModel(yIndex));
                         m_series->replace(index.column() - m_first, newPoint);
@@ -397,6 +461,7 @@ void QXYModelMapperPrivate::modelUpdated(QModelIndex topLeft, QModelIndex bottom
             }
         }
     }
+    m_series->endUpdate();
     blockSeriesSignals(false);
 }
 
@@ -474,6 +539,7 @@ void QXYModelMapperPrivate::insertData(int start, int end)
             addedCount = m_count;
         int first = qMax(start, m_first);
         int last = qMin(first + addedCount - 1, m_orientation == Qt::Vertical ? m_model->rowCount() - 1 : m_model->columnCount() - 1);
+        m_series->beginUpdate();
         for (int i = first; i <= last; i++) {
             QPointF point;
             QModelIndex xIndex = xModelIndex(i - m_first);
@@ -486,10 +552,11 @@ void QXYModelMapperPrivate::insertData(int start, int end)
         }
 
         // remove excess of points (above m_count)
-        if (m_count != -1 && m_series->points().size() > m_count)
-            for (int i = m_series->points().size() - 1; i >= m_count; i--) {
-                m_series->remove(m_series->points().at(i));
+        if (m_count != -1 && m_series->count() > m_count)
+            for (int i = m_series->count() - 1; i >= m_count; i--) {
+                m_series->remove(i);
             }
+        m_series->endUpdate();
     }
 }
 
@@ -505,8 +572,9 @@ void QXYModelMapperPrivate::removeData(int start, int end)
         int toRemove = qMin(m_series->count(), removedCount);     // first find how many items can actually be removed
         int first = qMax(start, m_first);    // get the index of the first item that will be removed.
         int last = qMin(first + toRemove - 1, m_series->count() + m_first - 1);    // get the index of the last item that will be removed.
+        m_series->beginUpdate();
         for (int i = last; i >= first; i--) {
-            m_series->remove(m_series->points().at(i - m_first));
+            m_series->remove(i - m_first);
         }
 
         if (m_count != -1) {
@@ -529,6 +597,7 @@ void QXYModelMapperPrivate::removeData(int start, int end)
                     }
                 }
         }
+        m_series->endUpdate();
     }
 }
 
@@ -547,17 +616,20 @@ void QXYModelMapperPrivate::initializeXYFromModel()
     QModelIndex yIndex = yModelIndex(pointPos);
 
     if (xIndex.isValid() && yIndex.isValid()) {
+        QVector<QPointF> points;
         while (xIndex.isValid() && yIndex.isValid()) {
             QPointF point;
             point.setX(valueFromModel(xIndex));
             point.setY(valueFromModel(yIndex));
-            m_series->append(point);
+            points.append(point);
             pointPos++;
             xIndex = xModelIndex(pointPos);
             yIndex = yModelIndex(pointPos);
             // Don't warn about invalid index after the first, those are valid and used to
             // determine when we should end looping.
         }
+        // Add the whole set at once so that the chart is updated only once
+        m_series->append(points);
     } else {
         // Invalid index right off the bat means series will be left empty, so output a warning,
         // unless model is also empty
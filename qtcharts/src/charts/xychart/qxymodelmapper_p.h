@@ -72,9 +72,12 @@ public Q_SLOTS:
 
     // for the series
     void handlePointAdded(int pointPos);
+    void handlePointsAdded(int pointPos, int count);
+    void handlePointsAdvanced(int removedCount, int addedCount);
     void handlePointRemoved(int pointPos);
     void handlePointsRemoved(int pointPos, int count);
     void handlePointReplaced(int pointPos);
+    void handlePointRangeReplaced(int pointPos, int count);
     void handleSeriesDestroyed();
 
     void initializeXYFromModel();
@@ -34,8 +34,11 @@
 #include <private/xychart_p.h>
 #include <QtCharts/QXYLegendMarker>
 #include <private/charthelpers_p.h>
+#include <private/xygeometryworkers_p.h>
 #include <private/qchart_p.h>
 #include <QtGui/QPainter>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMetaMethod>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
@@ -106,6 +109,23 @@ QT_CHARTS_BEGIN_NAMESPACE
     Whether the data points are visible and should be drawn.
 */
 
+/*!
+    \property QXYSeries::decimation
+    \brief Whether the line is drawn through a reduced set of points.
+
+    When enabled, consecutive points that fall into the same pixel column of the
+    plot area are reduced to the first, last, lowest, and highest of them before
+    the line is drawn. The result covers the same pixels as the full-resolution
+    line, but drawing costs time proportional to the width of the plot area
+    instead of the number of points. Decimation applies to line and spline series
+    and to the boundary lines of area series. Line series are not decimated while
+    their data points are visible, and spline series only when they have more
+    points than the plot area has pixel columns. Decimation is not used in polar
+    charts. This property is \c false by default.
+
+    \sa pointsVisible
+*/
+
 /*!
    \fn QPen QXYSeries::pen() const
    Returns the pen used to draw the outline of the data points for the series.
@@ -376,6 +396,22 @@ QT_CHARTS_BEGIN_NAMESPACE
     The corresponding signal handler is \c onPointReplaced().
 */
 
+/*!
+    \fn void QXYSeries::pointRangeReplaced(int index, int count)
+    This signal is emitted when the number of points specified by \a count,
+    starting at the position specified by \a index, have been replaced in place.
+    It is emitted instead of pointReplaced() when several points were replaced
+    between beginUpdate() and endUpdate().
+    \sa replace(), beginUpdate()
+*/
+/*!
+    \qmlsignal XYSeries::pointRangeReplaced(int index, int count)
+    This signal is emitted when the number of points specified by \a count,
+    starting at the position specified by \a index, have been replaced in place.
+
+    The corresponding signal handler is \c onPointRangeReplaced().
+*/
+
 /*!
     \fn void QXYSeries::pointsReplaced()
     This signal is emitted when all points are replaced with other points.
@@ -402,6 +438,38 @@ QT_CHARTS_BEGIN_NAMESPACE
     The corresponding signal handler is \c onPointAdded().
 */
 
+/*!
+    \fn void QXYSeries::pointsAdded(int index, int count)
+    This signal is emitted when the number of points specified by \a count
+    is added starting at the position specified by \a index.
+    \sa append()
+*/
+/*!
+    \qmlsignal XYSeries::pointsAdded(int index, int count)
+    This signal is emitted when the number of points specified by \a count
+    is added starting at the position specified by \a index.
+
+    The corresponding signal handler is \c onPointsAdded().
+*/
+
+/*!
+    \fn void QXYSeries::pointsAdvanced(int removedCount, int addedCount)
+    This signal is emitted when points are appended to a series that has a
+    capacity and is full. The number of oldest points specified by \a removedCount
+    was removed from the beginning of the series and the number of points
+    specified by \a addedCount was added to its end.
+    \sa setCapacity(), append()
+*/
+/*!
+    \qmlsignal XYSeries::pointsAdvanced(int removedCount, int addedCount)
+    This signal is emitted when points are appended to a series that has a
+    capacity and is full. The number of oldest points specified by \a removedCount
+    was removed from the beginning of the series and the number of points
+    specified by \a addedCount was added to its end.
+
+    The corresponding signal handler is \c onPointsAdvanced().
+*/
+
 /*!
     \fn void QXYSeries::pointRemoved(int index)
     This signal is emitted when a point is removed from the position specified
@@ -533,22 +601,90 @@ void QXYSeries::append(const QPointF &point)
 
     // 如果点有效
     if (isValidValue(point)) {
-        // 存储点
-        d->m_points << point;
-        // 发送点增加信号
-        emit pointAdded(d->m_points.count() - 1);
+        // 存储点，容量已满时淘汰最旧的点
+        if (d->m_points.append(point)) {
+            if (!d->recordChange(QXYSeriesPrivate::PointsAdvancedChange, 1, 1))
+                emit pointsAdvanced(1, 1); // 发送点集推进信号
+        } else {
+            const int index = d->m_points.count() - 1;
+            if (!d->recordChange(QXYSeriesPrivate::PointsAddedChange, index, 1))
+                emit pointAdded(index); // 发送点增加信号
+        }
     }
 }
 
 /*!
    \overload
    Adds the list of data points specified by \a points to the series.
+   Emits QXYSeries::pointsAdded() once for the whole list.
+   \sa pointsAdded()
  */
 // 追加点集
 void QXYSeries::append(const QList<QPointF> &points)
 {
-    foreach (const QPointF &point , points)
-        append(point); // 追加集
+    append(points.toVector()); // 追加集
+}
+
+/*!
+   \overload
+   Adds the vector of data points specified by \a points to the series.
+   \note This is much faster than appending data points one by one, because
+   the points are stored at once and QXYSeries::pointsAdded() is emitted only once.
+   \sa pointsAdded()
+ */
+// 追加点集
+void QXYSeries::append(const QVector<QPointF> &points)
+{
+    append(points.constData(), points.count());
+}
+
+/*!
+   \overload
+   Adds \a count data points starting from \a points to the series.
+   Invalid points are skipped. Emits QXYSeries::pointsAdded() once if any
+   point was added, or QXYSeries::pointsAdvanced() if the series has a
+   capacity and the oldest points were evicted to make room.
+   \sa pointsAdded(), pointsAdvanced(), setCapacity()
+ */
+// 追加点集
+void QXYSeries::append(const QPointF *points, int count)
+{
+    // 启用私有成员
+    Q_D(QXYSeries);
+
+    // 参数无效
+    if (!points || count <= 0)
+        return;
+
+    // 记录追加起始索引
+    const int index = d->m_points.count();
+    // 存储有效点
+    int added = 0;
+    for (int i = 0; i < count; i++) {
+        if (isValidValue(points[i])) {
+            d->m_points.append(points[i]);
+            added++;
+        }
+    }
+
+    // 没有追加任何点
+    if (added == 0)
+        return;
+
+    // 容量有限时，新追加的点也可能相互淘汰
+    added = qMin(added, d->m_points.count());
+    // 被淘汰的最旧点数
+    const int removed = index + added - d->m_points.count();
+
+    // 发送点集推进信号
+    if (removed > 0) {
+        if (!d->recordChange(QXYSeriesPrivate::PointsAdvancedChange, removed, added))
+            emit pointsAdvanced(removed, added);
+    }
+    // 发送点集增加信号
+    else if (!d->recordChange(QXYSeriesPrivate::PointsAddedChange, index, added)) {
+        emit pointsAdded(index, added);
+    }
 }
 
 /*!
@@ -607,8 +743,9 @@ void QXYSeries::replace(int index, const QPointF &newPoint)
     Q_D(QXYSeries);
     // 点有效
     if (isValidValue(newPoint)) {
-        d->m_points[index] = newPoint; // 存储点
-        emit pointReplaced(index); // 发送点信号
+        d->m_points.replace(index, newPoint); // 存储点
+        if (!d->recordChange(QXYSeriesPrivate::PointsReplacedChange, index, 1))
+            emit pointReplaced(index); // 发送点信号
     }
 }
 
@@ -631,8 +768,9 @@ void QXYSeries::replace(QList<QPointF> points)
   Replaces the current points with the points specified by \a points.
   \note This is much faster than replacing data points one by one,
   or first clearing all data, and then appending the new data. Emits QXYSeries::pointsReplaced()
-  when the points have been replaced.
-  \sa pointsReplaced()
+  when the points have been replaced. If the series has a capacity, only the
+  last capacity() points are kept.
+  \sa pointsReplaced(), setCapacity()
 */
 // 替换点集
 void QXYSeries::replace(QVector<QPointF> points)
@@ -640,9 +778,10 @@ void QXYSeries::replace(QVector<QPointF> points)
     // 启用点私有成员
     Q_D(QXYSeries);
     // 存储点集
-    d->m_points = points;
+    d->m_points.setPoints(points);
     // 发送点集替换信号
-    emit pointsReplaced();
+    if (!d->recordChange(QXYSeriesPrivate::AllPointsChange, 0, 0))
+        emit pointsReplaced();
 }
 
 /*!
@@ -678,7 +817,8 @@ void QXYSeries::remove(int index)
 {
     Q_D(QXYSeries);
     d->m_points.remove(index);
-    emit pointRemoved(index);
+    if (!d->recordChange(QXYSeriesPrivate::PointsRemovedChange, index, 1))
+        emit pointRemoved(index);
 }
 
 /*!
@@ -694,23 +834,31 @@ void QXYSeries::removePoints(int index, int count)
     Q_D(QXYSeries);
     if (count > 0) {
         d->m_points.remove(index, count);
-        emit pointsRemoved(index, count);
+        if (!d->recordChange(QXYSeriesPrivate::PointsRemovedChange, index, count))
+            emit pointsRemoved(index, count);
     }
 }
 
 /*!
   Inserts the data point \a point in the series at the position specified by
-  \a index.
-  \sa pointAdded()
+  \a index. If the series has a capacity and is full, the oldest point is
+  removed first.
+  \sa pointAdded(), setCapacity()
 */
 // 插入点
 void QXYSeries::insert(int index, const QPointF &point)
 {
     Q_D(QXYSeries);
     if (isValidValue(point)) {
+        // 容量已满时先淘汰最旧的点
+        if (d->m_points.isFull()) {
+            remove(0);
+            index--;
+        }
         index = qMax(0, qMin(index, d->m_points.size()));
         d->m_points.insert(index, point);
-        emit pointAdded(index);
+        if (!d->recordChange(QXYSeriesPrivate::PointsAddedChange, index, 1))
+            emit pointAdded(index);
     }
 }
 
@@ -744,7 +892,7 @@ QList<QPointF> QXYSeries::points() const
 QVector<QPointF> QXYSeries::pointsVector() const
 {
     Q_D(const QXYSeries);
-    return d->m_points;
+    return d->m_points.toVector();
 }
 
 /*!
@@ -755,7 +903,11 @@ QVector<QPointF> QXYSeries::pointsVector() const
 const QPointF &QXYSeries::at(int index) const
 {
     Q_D(const QXYSeries);
-    return d->m_points.at(index);
+    if (d->m_points.layout() == StorageLayoutPoints) {
+        Q_ASSERT_X(index >= 0 && index < d->m_points.count(), "QXYSeries::at", "index out of range");
+        return d->m_points.constData()[index];
+    }
+    return d->materializedPoints().at(index);
 }
 
 /*!
@@ -768,6 +920,289 @@ int QXYSeries::count() const
     return d->m_points.count();
 }
 
+/*!
+    Returns the index of the data point closest to \a position, or -1 if no data
+    point lies within \a maxDistance of it. \a position is in the chart
+    coordinates used by QChart::mapToValue() and \a maxDistance is in pixels.
+    Of equally close points the one with the lowest index is returned.
+
+    Only points inside the plot area of a chart the series is added to are
+    considered. The series keeps a spatial index of the point positions that is
+    rebuilt on the first query after the data or the axis ranges change, so
+    repeated queries, for example on every mouse move, take time proportional
+    to the number of points near \a position rather than to the size of the
+    series.
+
+    \sa pointsInRect(), QChart::mapToValue()
+*/
+// 查找离图表位置最近的点
+int QXYSeries::nearestPoint(const QPointF &position, qreal maxDistance) const
+{
+    Q_D(const QXYSeries);
+    if (!d->m_chart || !d->m_domain)
+        return -1;
+    return d->m_pointIndex.nearest(d, d->m_domain.data(),
+                                   position - d->m_chart->plotArea().topLeft(), maxDistance);
+}
+
+/*!
+    Returns the indexes, in increasing order, of the data points inside \a rect,
+    which is in the chart coordinates used by QChart::mapToValue().
+
+    Only points inside the plot area of a chart the series is added to are
+    considered. The query uses the same spatial index as nearestPoint().
+
+    \sa nearestPoint()
+*/
+// 查找图表矩形内的点
+QVector<int> QXYSeries::pointsInRect(const QRectF &rect) const
+{
+    Q_D(const QXYSeries);
+    if (!d->m_chart || !d->m_domain)
+        return QVector<int>();
+    return d->m_pointIndex.pointsIn(d, d->m_domain.data(),
+                                    rect.translated(-d->m_chart->plotArea().topLeft()));
+}
+
+/*!
+    Sets the maximum number of data points kept by the series to \a capacity.
+
+    A series with a capacity works as a fixed-size circular buffer: when points
+    are appended to a full series, the oldest points are evicted in constant time
+    and QXYSeries::pointsAdvanced() is emitted instead of QXYSeries::pointsAdded().
+    This is intended for scrolling real-time plots.
+
+    If the series currently holds more than \a capacity points, the oldest ones
+    are removed and QXYSeries::pointsRemoved() is emitted. A \a capacity of zero,
+    which is the default, removes the limit.
+
+    \note A series with a capacity uses twice the memory of its capacity to store
+    the points, and pointsVector() returns a copy of the points.
+
+    \sa capacity(), pointsAdvanced()
+*/
+// 设置容量
+void QXYSeries::setCapacity(int capacity)
+{
+    Q_D(QXYSeries);
+    const int evicted = d->m_points.setCapacity(capacity);
+    if (evicted > 0 && !d->recordChange(QXYSeriesPrivate::PointsRemovedChange, 0, evicted))
+        emit pointsRemoved(0, evicted);
+}
+
+/*!
+    Returns the maximum number of data points kept by the series, or zero if the
+    number of points is not limited.
+    \sa setCapacity()
+*/
+// 获取容量
+int QXYSeries::capacity() const
+{
+    Q_D(const QXYSeries);
+    return d->m_points.capacity();
+}
+
+/*!
+    Sets the number of data points the ingest queue of the series can hold to
+    \a capacity, rounded up to a power of two. A \a capacity of zero, which is
+    the default, removes the queue.
+
+    The ingest queue lets other threads feed the series with enqueue() without
+    locking and without allocating memory. The queued points are appended to the
+    series on the thread of the series, in a single call to append() for everything
+    that was enqueued since the queue was last emptied. A fast producer therefore
+    does not flood the event queue, and the chart is updated once per batch.
+
+    Points still in the queue are appended to the series before the queue is
+    resized. This function must not be called while other threads are calling
+    enqueue().
+
+    \sa ingestCapacity(), enqueue()
+*/
+// 设置接收队列容量
+void QXYSeries::setIngestCapacity(int capacity)
+{
+    Q_D(QXYSeries);
+    d->flushIngestQueue();
+    d->m_ingestQueue.setCapacity(capacity);
+    d->m_ingestPoints.reserve(d->m_ingestQueue.capacity());
+}
+
+/*!
+    Returns the number of data points the ingest queue of the series can hold,
+    or zero if the series has no ingest queue.
+    \sa setIngestCapacity()
+*/
+// 获取接收队列容量
+int QXYSeries::ingestCapacity() const
+{
+    Q_D(const QXYSeries);
+    return d->m_ingestQueue.capacity();
+}
+
+/*!
+    Adds the data point \a point to the ingest queue of the series. Returns \c false
+    if the series has no ingest queue or the queue is full, in which case the
+    point is dropped.
+
+    \note This function is thread-safe.
+    \sa setIngestCapacity()
+*/
+// 写入接收队列
+bool QXYSeries::enqueue(const QPointF &point)
+{
+    return enqueue(&point, 1) == 1;
+}
+
+/*!
+    \overload
+    Adds \a count data points starting from \a points to the ingest queue of the
+    series. Returns the number of points that were queued. The remaining points
+    are dropped when the queue is full.
+
+    \note This function is thread-safe.
+    \sa setIngestCapacity()
+*/
+// 写入接收队列
+int QXYSeries::enqueue(const QPointF *points, int count)
+{
+    Q_D(QXYSeries);
+    const int queued = d->m_ingestQueue.push(points, count);
+
+    // 只有第一个写入的线程安排一次取出，之后的写入合并到同一批中
+    if (queued > 0 && d->m_ingestQueue.schedule())
+        QMetaObject::invokeMethod(d, "flushIngestQueue", Qt::QueuedConnection);
+    return queued;
+}
+
+/*!
+    \enum QXYSeries::StorageLayout
+
+    This enum value describes how the data points of the series are stored in memory.
+
+    \value StorageLayoutPoints
+           The points are stored as a single array of QPointF. This is the default.
+    \value StorageLayoutColumns
+           The x and y values are stored in two separate contiguous arrays that can
+           be accessed with xData() and yData(). Scanning one coordinate, as done
+           when calculating the axis ranges or the geometry of large series,
+           touches half of the memory.
+    \value StorageLayoutUniformX
+           Only the y values are stored, in a contiguous array that can be
+           accessed with yData(). The x value of the point at index \c i is
+           computed as \c {samplingOrigin() + i * samplingInterval()}, so the
+           series uses half of the memory and its x range is known without
+           scanning. The x coordinates of added or replaced points are ignored.
+           Removing the first points or evicting them from a full series with a
+           capacity advances samplingOrigin(), so the remaining points keep
+           their x values.
+*/
+
+/*!
+    \property QXYSeries::storageLayout
+    \brief How the data points of the series are stored in memory.
+
+    Changing the layout keeps the points of the series. All the functions
+    working with QPointF continue to work with every layout. When changing to
+    StorageLayoutUniformX, the sampling is derived from the first and last points,
+    which are kept exactly; the points in between are moved to evenly spaced x values,
+    and pointsReplaced() is emitted.
+
+    \note With StorageLayoutColumns and StorageLayoutUniformX, the first call to at()
+    after the series is modified assembles a copy of the points, which at() then
+    refers to until the series is modified again.
+
+    \sa xData(), yData(), setSampling()
+*/
+// 设置存储布局
+void QXYSeries::setStorageLayout(StorageLayout layout)
+{
+    Q_D(QXYSeries);
+    if (layout == d->m_points.layout())
+        return;
+    d->m_points.setLayout(layout);
+    // 点布局的 at() 直接引用存储，释放组装的点集
+    if (layout == StorageLayoutPoints) {
+        d->m_materializedPoints = QVector<QPointF>();
+        d->m_materialized = false;
+    }
+    // 均匀采样布局会重新计算点的x值
+    if (layout == StorageLayoutUniformX && !d->recordChange(QXYSeriesPrivate::AllPointsChange, 0, 0))
+        emit pointsReplaced();
+}
+
+// 获取存储布局
+QXYSeries::StorageLayout QXYSeries::storageLayout() const
+{
+    Q_D(const QXYSeries);
+    return d->m_points.layout();
+}
+
+/*!
+    Returns a pointer to the contiguous x values of the series, or a null pointer
+    if storageLayout() is not QXYSeries::StorageLayoutColumns.
+    The pointer is valid until the series is modified.
+    \sa yData(), count()
+*/
+// 获取连续x值
+const qreal *QXYSeries::xData() const
+{
+    Q_D(const QXYSeries);
+    return d->m_points.xData();
+}
+
+/*!
+    Returns a pointer to the contiguous y values of the series, or a null pointer
+    if storageLayout() is QXYSeries::StorageLayoutPoints.
+    The pointer is valid until the series is modified.
+    \sa xData(), count()
+*/
+// 获取连续y值
+const qreal *QXYSeries::yData() const
+{
+    Q_D(const QXYSeries);
+    return d->m_points.yData();
+}
+
+/*!
+    Sets the storage layout of the series to QXYSeries::StorageLayoutUniformX,
+    with the first point at the x value \a x0 and the following points spaced
+    by \a dx. The y values are kept.
+    \sa samplingOrigin(), samplingInterval(), pointsReplaced()
+*/
+// 设置均匀采样参数
+void QXYSeries::setSampling(qreal x0, qreal dx)
+{
+    Q_D(QXYSeries);
+    d->m_points.setLayout(StorageLayoutUniformX);
+    d->m_points.setSampling(x0, dx);
+    if (!d->recordChange(QXYSeriesPrivate::AllPointsChange, 0, 0))
+        emit pointsReplaced();
+}
+
+/*!
+    Returns the x value of the first point of a uniformly sampled series.
+    \sa setSampling(), storageLayout
+*/
+// 获取均匀采样起始x值
+qreal QXYSeries::samplingOrigin() const
+{
+    Q_D(const QXYSeries);
+    return d->m_points.samplingOrigin();
+}
+
+/*!
+    Returns the distance between the x values of consecutive points of a
+    uniformly sampled series.
+    \sa setSampling(), storageLayout
+*/
+// 获取均匀采样x间隔
+qreal QXYSeries::samplingInterval() const
+{
+    Q_D(const QXYSeries);
+    return d->m_points.samplingInterval();
+}
+
 
 /*!
     Sets the pen used for drawing points on the chart to \a pen. If the pen is
@@ -859,6 +1294,23 @@ bool QXYSeries::pointsVisible() const
     return d->m_pointsVisible;
 }
 
+// 设置是否抽稀绘制
+void QXYSeries::setDecimation(bool enabled)
+{
+    Q_D(QXYSeries);
+    if (d->m_decimation != enabled) {
+        d->m_decimation = enabled;
+        emit d->updated();
+    }
+}
+
+// 获取是否抽稀绘制
+bool QXYSeries::decimation() const
+{
+    Q_D(const QXYSeries);
+    return d->m_decimation;
+}
+
 // 设置点标签格式
 void QXYSeries::setPointLabelsFormat(const QString &format)
 {
@@ -978,11 +1430,18 @@ QXYSeriesPrivate::QXYSeriesPrivate(QXYSeries *q)
       m_pen(QChartPrivate::defaultPen()), // 画笔
       m_brush(QChartPrivate::defaultBrush()), // 画刷
       m_pointsVisible(false), // 点是否可见
+      m_decimation(false), // 是否抽稀绘制
       m_pointLabelsFormat(QLatin1String("@xPoint, @yPoint")), // 点标签格式
       m_pointLabelsVisible(false), // 标签是否可视
       m_pointLabelsFont(QChartPrivate::defaultFont()), // 标签字体
       m_pointLabelsColor(QChartPrivate::defaultPen().color()), // 标签颜色
-      m_pointLabelsClipping(true) // 标签是否可以检测
+      m_pointLabelsClipping(true), // 标签是否可以检测
+      m_materializedRevision(0), // 组装点集时点缓冲的修订号
+      m_materialized(false), // 是否已组装点集
+      m_change(NoDataChange), // 批量更新期间合并的数据变化
+      m_changeIndex(0), // 变化的起始索引
+      m_changeCount(0), // 变化的点数
+      m_changeStartCount(0) // 第一次变化之前的点数
 {
 }
 
@@ -995,34 +1454,245 @@ void QXYSeriesPrivate::initializeDomain()
     qreal maxX(1);
     qreal maxY(1);
 
-    // 支持使用所属序列指针
+    // 统计点集中最大、最小x、y，点集为空时保持默认值
+    m_points.extents(minX, maxX, minY, maxY);
+
+    // 设置区域范围
+    domain()->setRange(minX, maxX, minY, maxY);
+}
+
+// 把接收队列中的点追加到序列
+// 先清除取出标记再取出，取出期间写入的点要么被本次取出，要么会再次安排取出
+void QXYSeriesPrivate::flushIngestQueue()
+{
     Q_Q(QXYSeries);
+    m_ingestQueue.unschedule();
+    m_ingestQueue.drain(m_ingestPoints);
+    q->append(m_ingestPoints.constData(), m_ingestPoints.count());
+    m_ingestPoints.clear();
+}
 
-    // 获取所属序列点集
-    const QVector<QPointF> &points = q->pointsVector();
-
-    // 如果点集非空
-    if (!points.isEmpty()) {
-
-        // 记录最大、最小x、y
-        minX = points[0].x();
-        minY = points[0].y();
-        maxX = minX;
-        maxY = minY;
-
-        // 统计点集中最大、最小x、y
-        for (int i = 0; i < points.count(); i++) {
-            qreal x = points[i].x();
-            qreal y = points[i].y();
-            minX = qMin(minX, x);
-            minY = qMin(minY, y);
-            maxX = qMax(maxX, x);
-            maxY = qMax(maxY, y);
+// 批量更新时记录数据变化，未在批量更新时返回false，由调用者直接发送信号
+// 新的变化与已记录的变化能表示为单个区间时合并，否则视为替换了所有点
+bool QXYSeriesPrivate::recordChange(DataChange change, int index, int count)
+{
+    if (!isUpdating())
+        return false;
+
+    const int total = m_points.count();
+
+    // 第一次变化，推算变化之前的点数
+    if (m_change == NoDataChange) {
+        m_change = change;
+        m_changeIndex = index;
+        m_changeCount = count;
+        if (change == PointsAddedChange)
+            m_changeStartCount = total - count;
+        else if (change == PointsAdvancedChange)
+            m_changeStartCount = total - count + index;
+        else if (change == PointsRemovedChange)
+            m_changeStartCount = total + count;
+        else
+            m_changeStartCount = total;
+        return true;
+    }
+
+    switch (change) {
+    case PointsReplacedChange:
+        // 替换区间取并集，替换新插入的点不改变插入区间
+        if (m_change == PointsReplacedChange) {
+            const int end = qMax(m_changeIndex + m_changeCount, index + count);
+            m_changeIndex = qMin(m_changeIndex, index);
+            m_changeCount = end - m_changeIndex;
+        } else if (m_change != PointsAddedChange || index < m_changeIndex
+                   || index + count > m_changeIndex + m_changeCount) {
+            m_change = AllPointsChange;
+        }
+        break;
+    case PointsAddedChange:
+        // 在插入区间之内或紧邻处继续插入
+        if (m_change == PointsAddedChange
+                && index >= m_changeIndex && index <= m_changeIndex + m_changeCount) {
+            m_changeCount += count;
+        } else {
+            m_change = AllPointsChange;
+        }
+        break;
+    case PointsAdvancedChange:
+        // 连续推进，或先在末尾追加再推进，淘汰的点数在发送时由点数推算
+        if (m_change == PointsAdvancedChange
+                || (m_change == PointsAddedChange
+                    && m_changeIndex + m_changeCount == total - count + index)) {
+            m_change = PointsAdvancedChange;
+            m_changeCount += count;
+        } else {
+            m_change = AllPointsChange;
         }
+        break;
+    case PointsRemovedChange:
+        // 在同一位置继续移除，或移除紧邻在前的点
+        if (m_change == PointsRemovedChange && index == m_changeIndex) {
+            m_changeCount += count;
+        } else if (m_change == PointsRemovedChange && index + count == m_changeIndex) {
+            m_changeIndex = index;
+            m_changeCount += count;
+        } else {
+            m_change = AllPointsChange;
+        }
+        break;
+    default:
+        m_change = AllPointsChange;
+        break;
     }
+    return true;
+}
 
-    // 设置区域范围
-    domain()->setRange(minX, maxX, minY, maxY);
+// 发送合并后的数据变化通知
+void QXYSeriesPrivate::commitUpdate()
+{
+    Q_Q(QXYSeries);
+
+    const DataChange change = m_change;
+    m_change = NoDataChange;
+
+    switch (change) {
+    case PointsReplacedChange:
+        if (m_changeCount == 1)
+            emit q->pointReplaced(m_changeIndex);
+        else
+            emit q->pointRangeReplaced(m_changeIndex, m_changeCount);
+        break;
+    case PointsAddedChange:
+        if (m_changeCount == 1)
+            emit q->pointAdded(m_changeIndex);
+        else
+            emit q->pointsAdded(m_changeIndex, m_changeCount);
+        break;
+    case PointsAdvancedChange: {
+        // 追加的点可能多于容量，此时只有最后的点留在序列中
+        const int added = qMin(m_changeCount, m_points.count());
+        const int removed = m_changeStartCount + added - m_points.count();
+        emit q->pointsAdvanced(removed, added);
+        break;
+    }
+    case PointsRemovedChange:
+        if (m_changeCount == 1)
+            emit q->pointRemoved(m_changeIndex);
+        else
+            emit q->pointsRemoved(m_changeIndex, m_changeCount);
+        break;
+    case AllPointsChange:
+        emit q->pointsReplaced();
+        break;
+    default:
+        break;
+    }
+}
+
+// 获取从index开始的count个点的范围，区间为空时返回false
+// 范围由最值金字塔合并得出，可用于按可见x窗口自动调整y范围
+bool QXYSeriesPrivate::extents(int index, int count,
+                               qreal &minX, qreal &maxX, qreal &minY, qreal &maxY) const
+{
+    return m_points.extents(index, count, minX, maxX, minY, maxY);
+}
+
+// 非点布局时组装的点集
+// 列布局和均匀采样布局没有连续的点可以引用，at() 需要返回引用时按需组装一份点集，
+// 点缓冲修订号变化后重新组装，因此返回的引用在序列被修改前保持有效。
+const QVector<QPointF> &QXYSeriesPrivate::materializedPoints() const
+{
+    QMutexLocker locker(&m_materializeMutex);
+    if (!m_materialized || m_materializedRevision != m_points.revision()) {
+        m_materializedPoints = m_points.toVector();
+        m_materializedRevision = m_points.revision();
+        m_materialized = true;
+    }
+    return m_materializedPoints;
+}
+
+// 是否可用最值金字塔抽稀点集
+// 只用于抽稀绘制、不显示点和点标签、x值有序的线状序列。合并的每组点的x跨度不超过一个像素列，
+// 更宽的桶拆分到更细的层级或输出全部点，因此略去的点都落在保留的首、末、最小、最大点所覆盖的
+// 像素列范围内，绘制结果与全部点相比最多相差一个像素列。
+bool QXYSeriesPrivate::useReducedPoints() const
+{
+    Q_Q(const QXYSeries);
+    return m_decimation && !m_pointsVisible && !m_pointLabelsVisible
+            && q->type() != QAbstractSeries::SeriesTypeScatter && m_points.isSorted();
+}
+
+// 获取区间的抽稀点集，区间的点数不足以分出 buckets 个桶时返回空点集
+// columnSpan 为一个像素列的x跨度，x跨度更大的桶不合并。
+QVector<QPointF> QXYSeriesPrivate::reducedPoints(int index, int count, int buckets,
+                                                 qreal columnSpan, qreal logBaseX) const
+{
+    return m_points.lod().reducedPoints(m_points, index, count, buckets, columnSpan, logBaseX);
+}
+
+// 换算区间的几何点集，写入result
+// 直接从存储换算，不复制中间点集；对数直角坐标区域使用缓存的对数坐标，只需线性变换。
+// 点数较多时分块交给线程池并行换算，各块只读取存储、写入result的对应区间。
+bool QXYSeriesPrivate::calculateGeometryPoints(const AbstractDomain *domain, int index, int count,
+                                               QPointF *result) const
+{
+    qreal logBaseX;
+    qreal logBaseY;
+    const QPointF *logPoints = 0;
+    if (domain->logBases(logBaseX, logBaseY))
+        logPoints = m_points.logPoints(logBaseX, logBaseY); // 在调用线程中更新对数坐标缓存
+
+    const QXYSeries::StorageLayout layout = m_points.layout();
+    const QPointF *points = m_points.constData();
+    const qreal *xData = m_points.xData();
+    const qreal *yData = m_points.yData();
+    const qreal interval = m_points.samplingInterval();
+
+    // 换算 [index + offset, index + offset + n) 的点
+    auto calculateChunk = [&](int offset, int n) -> bool {
+        const int first = index + offset;
+        if (logPoints)
+            return domain->calculateLogPointsGeometry(logPoints + first, n, result + offset);
+
+        switch (layout) {
+        case QXYSeries::StorageLayoutColumns: // 列布局直接换算x、y列
+            return domain->calculateColumnsGeometry(xData + first, yData + first, n, result + offset);
+        case QXYSeries::StorageLayoutUniformX: // 均匀采样布局只需换算y列
+            return domain->calculateUniformGeometry(m_points.xAt(0), interval, first,
+                                                    yData + first, n, result + offset);
+        default:
+            return domain->calculatePointsGeometry(points + first, n, result + offset);
+        }
+    };
+
+    if (!XYGeometryWorkers::isParallel(count))
+        return calculateChunk(0, count);
+
+    QAtomicInt failed(0);
+    XYGeometryWorkers::run(count, XYGeometryWorkers::ChunkSize, [&](int offset, int n) {
+        if (!calculateChunk(offset, n))
+            failed.store(1);
+    });
+    return failed.load() == 0;
+}
+
+// 点击、悬停等交互信号是否有接收者，包括QML中的信号处理器
+// 没有接收者时图表项不必参与命中检测，也就不必生成描边轮廓。
+bool QXYSeriesPrivate::hasInteractionReceivers() const
+{
+    Q_Q(const QXYSeries);
+    static const QMetaMethod signalList[] = {
+        QMetaMethod::fromSignal(&QXYSeries::clicked),
+        QMetaMethod::fromSignal(&QXYSeries::hovered),
+        QMetaMethod::fromSignal(&QXYSeries::pressed),
+        QMetaMethod::fromSignal(&QXYSeries::released),
+        QMetaMethod::fromSignal(&QXYSeries::doubleClicked)
+    };
+    for (const QMetaMethod &signal : signalList) {
+        if (q->isSignalConnected(signal))
+            return true;
+    }
+    return false;
 }
 
 // 创建图例标记
@@ -1078,45 +1748,19 @@ void QXYSeriesPrivate::initializeAnimations(QtCharts::QChart::AnimationOptions o
 
 // 绘制序列点标签
 void QXYSeriesPrivate::drawSeriesPointLabels(QPainter *painter, const QVector<QPointF> &points,
-                                             const int offset)
+                                             const int offset, int firstIndex,
+                                             const XYSeriesBuffer *buffer)
 {
     // 如果点集为空
     if (points.size() == 0)
         return;
 
-    // 格式标记字符串
-    static const QString xPointTag(QLatin1String("@xPoint"));
-    static const QString yPointTag(QLatin1String("@yPoint"));
-
-    // 计算标签偏移
-    const int labelOffset = offset + 2;
-
     // 设置标签字体、画笔
     painter->setFont(m_pointLabelsFont);
     painter->setPen(QPen(m_pointLabelsColor));
-    QFontMetrics fm(painter->font());
-    // m_points is used for the label here as it has the series point information
-    // points variable passed is used for positioning because it has the coordinates
-    // 计算点集数量
-    const int pointCount = qMin(points.size(), m_points.size());
-    // 遍历点集
-    for (int i(0); i < pointCount; i++) {
-        // 标签内容格式替换
-        QString pointLabel = m_pointLabelsFormat;
-        pointLabel.replace(xPointTag, presenter()->numberToString(m_points.at(i).x()));
-        pointLabel.replace(yPointTag, presenter()->numberToString(m_points.at(i).y()));
-
-        // Position text in relation to the point
-        // 计算标签宽度
-        int pointLabelWidth = fm.width(pointLabel);
-        // 计算标签位置
-        QPointF position(points.at(i));
-        position.setX(position.x() - pointLabelWidth / 2);
-        position.setY(position.y() - labelOffset);
-
-        // 书写标签
-        painter->drawText(position, pointLabel);
-    }
+    // 只为可见且不与其他标签重叠的点绘制标签，格式化的文本及宽度按点缓存
+    m_pointLabels.draw(painter, presenter(), buffer ? *buffer : m_points, points, firstIndex,
+                       offset, m_pointLabelsFormat);
 }
 
 #include "moc_qxyseries.cpp"
@@ -55,6 +55,17 @@ class QT_CHARTS_EXPORT QXYSeries : public QAbstractSeries
     Q_PROPERTY(QFont pointLabelsFont READ pointLabelsFont WRITE setPointLabelsFont NOTIFY pointLabelsFontChanged)
     Q_PROPERTY(QColor pointLabelsColor READ pointLabelsColor WRITE setPointLabelsColor NOTIFY pointLabelsColorChanged)
     Q_PROPERTY(bool pointLabelsClipping READ pointLabelsClipping WRITE setPointLabelsClipping NOTIFY pointLabelsClippingChanged)
+    Q_PROPERTY(StorageLayout storageLayout READ storageLayout WRITE setStorageLayout)
+    Q_PROPERTY(bool decimation READ decimation WRITE setDecimation)
+    Q_ENUMS(StorageLayout)
+
+public:
+    // 点存储布局
+    enum StorageLayout {
+        StorageLayoutPoints, // 点数组
+        StorageLayoutColumns, // x、y列数组
+        StorageLayoutUniformX // 均匀采样，仅存储y列
+    };
 
 protected:
     explicit QXYSeries(QXYSeriesPrivate &d, QObject *parent = Q_NULLPTR); // 构造
@@ -64,6 +75,8 @@ public:
     void append(qreal x, qreal y); // 追加点
     void append(const QPointF &point); // 追加点
     void append(const QList<QPointF> &points); // 追加点集
+    void append(const QVector<QPointF> &points); // 追加点集
+    void append(const QPointF *points, int count); // 追加点集
     void replace(qreal oldX, qreal oldY, qreal newX, qreal newY); // 替换点
     void replace(const QPointF &oldPoint, const QPointF &newPoint); // 替换点
     void replace(int index, qreal newX, qreal newY); // 替换点
@@ -80,6 +93,25 @@ public:
     QVector<QPointF> pointsVector() const; // 获取点集
     const QPointF &at(int index) const; // 获取点
 
+    int nearestPoint(const QPointF &position, qreal maxDistance) const; // 查找离图表位置最近的点
+    QVector<int> pointsInRect(const QRectF &rect) const; // 查找图表矩形内的点
+
+    void setCapacity(int capacity); // 设置容量
+    int capacity() const; // 获取容量
+
+    void setIngestCapacity(int capacity); // 设置接收队列容量
+    int ingestCapacity() const; // 获取接收队列容量
+    bool enqueue(const QPointF &point); // 写入接收队列，线程安全
+    int enqueue(const QPointF *points, int count); // 写入接收队列，线程安全
+
+    void setStorageLayout(StorageLayout layout); // 设置存储布局
+    StorageLayout storageLayout() const; // 获取存储布局
+    const qreal *xData() const; // 获取连续x值
+    const qreal *yData() const; // 获取连续y值
+    void setSampling(qreal x0, qreal dx); // 设置均匀采样参数
+    qreal samplingOrigin() const; // 获取均匀采样起始x值
+    qreal samplingInterval() const; // 获取均匀采样x间隔
+
     QXYSeries &operator << (const QPointF &point); // 插入点
     QXYSeries &operator << (const QList<QPointF> &points); // 插入点集
 
@@ -95,6 +127,9 @@ public:
     void setPointsVisible(bool visible = true); // 设置点集是否可见
     bool pointsVisible() const; // 获取点集是否可见
 
+    void setDecimation(bool enabled = true); // 设置是否抽稀绘制
+    bool decimation() const; // 获取是否抽稀绘制
+
     void setPointLabelsFormat(const QString &format); // 设置点集标签格式
     QString pointLabelsFormat() const; // 获取点集标签格式
 
@@ -120,8 +155,11 @@ Q_SIGNALS:
     void released(const QPointF &point);
     void doubleClicked(const QPointF &point);
     void pointReplaced(int index);
+    void pointRangeReplaced(int index, int count);
     void pointRemoved(int index);
     void pointAdded(int index);
+    void pointsAdded(int index, int count);
+    void pointsAdvanced(int removedCount, int addedCount);
     void colorChanged(QColor color);
     void pointsReplaced();
     void pointLabelsFormatChanged(const QString &format);
@@ -138,6 +176,8 @@ private:
     friend class QXYLegendMarkerPrivate;
     friend class XYLegendMarker;
     friend class XYChart;
+    friend class GLXYSeriesDataManager;
+    friend class QAreaSeriesPrivate;
 };
 
 QT_CHARTS_END_NAMESPACE
@@ -40,7 +40,12 @@
 #define QXYSERIES_P_H
 
 #include <private/qabstractseries_p.h>
+#include <private/xyseriesbuffer_p.h>
+#include <private/xyseriesingestqueue_p.h>
+#include <private/xypointlabels_p.h>
+#include <private/xypointindex_p.h>
 #include <QtCharts/private/qchartglobal_p.h>
+#include <QtCore/QMutex>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
@@ -53,6 +58,16 @@ class QT_CHARTS_PRIVATE_EXPORT QXYSeriesPrivate: public QAbstractSeriesPrivate
     Q_OBJECT
 
 public:
+    // 批量更新期间合并的数据变化
+    enum DataChange {
+        NoDataChange, // 没有变化
+        PointsReplacedChange, // 替换了一个区间内的点
+        PointsAddedChange, // 插入了连续的点
+        PointsAdvancedChange, // 在末尾追加并从头部淘汰了点
+        PointsRemovedChange, // 移除了连续的点
+        AllPointsChange // 无法合并为单个区间，视为替换了所有点
+    };
+
     // 构造
     QXYSeriesPrivate(QXYSeries *q);
 
@@ -67,21 +82,54 @@ public:
     QAbstractAxis* createDefaultAxis(Qt::Orientation orientation) const; // 创建默认轴
 
     void drawSeriesPointLabels(QPainter *painter, const QVector<QPointF> &points,
-                               const int offset = 0); // 绘制序列点标签
+                               const int offset = 0, int firstIndex = 0,
+                               const XYSeriesBuffer *buffer = 0); // 绘制序列点标签，标签取自buffer，默认为序列的点缓冲
+
+    const XYSeriesBuffer &pointBuffer() const { return m_points; } // 获取点缓冲
+    void adoptPointCaches(const XYSeriesBuffer &snapshot) { m_points.adoptCaches(snapshot); } // 接收快照中构建的缓存
+    const XYSeriesLod &lod() const { return m_points.lod(); } // 获取多分辨率最值金字塔
+    const QVector<QPointF> &materializedPoints() const; // 非点布局时组装的点集，序列修改前保持不变
+    bool extents(int index, int count,
+                 qreal &minX, qreal &maxX, qreal &minY, qreal &maxY) const; // 获取区间范围
+    bool useReducedPoints() const; // 是否可用最值金字塔抽稀点集
+    QVector<QPointF> reducedPoints(int index, int count, int buckets, qreal columnSpan,
+                                   qreal logBaseX = 0) const; // 获取区间的抽稀点集
+    bool calculateGeometryPoints(const AbstractDomain *domain, int index, int count,
+                                 QPointF *result) const; // 换算区间的几何点集，写入result
+    bool hasInteractionReceivers() const; // 点击、悬停等交互信号是否有接收者
+
+    bool recordChange(DataChange change, int index, int count); // 批量更新时记录数据变化
+    void commitUpdate(); // 发送合并后的数据变化通知
+
+public Q_SLOTS:
+    void flushIngestQueue(); // 把接收队列中的点追加到序列
 
 Q_SIGNALS:
     void updated(); // 更新信号
 
 protected:
-    QVector<QPointF> m_points; // 点集
+    XYSeriesBuffer m_points; // 点集
     QPen m_pen; // 画笔
     QBrush m_brush; // 画刷
     bool m_pointsVisible; // 是否点可见
+    bool m_decimation; // 是否抽稀绘制
     QString m_pointLabelsFormat; // 点标签格式
     bool m_pointLabelsVisible; // 点标签是否可见
     QFont m_pointLabelsFont; // 点标签字体
     QColor m_pointLabelsColor; // 点标签颜色
     bool m_pointLabelsClipping; // 点标签是否可以剪裁
+    XYPointLabels m_pointLabels; // 点标签层，缓存格式化后的标签
+    mutable XYPointIndex m_pointIndex; // 点位置索引，查询时按需重建
+    mutable QVector<QPointF> m_materializedPoints; // 非点布局时 at() 引用的点集
+    mutable uint m_materializedRevision; // 组装点集时点缓冲的修订号
+    mutable bool m_materialized; // 是否已组装点集
+    mutable QMutex m_materializeMutex; // 保护组装点集，允许多个线程读取常量序列
+    XYSeriesIngestQueue m_ingestQueue; // 接收队列
+    QVector<QPointF> m_ingestPoints; // 从接收队列取出的点，重复使用以免分配内存
+    DataChange m_change; // 批量更新期间合并的数据变化
+    int m_changeIndex; // 变化的起始索引，推进变化时为淘汰的点数
+    int m_changeCount; // 变化的点数，推进变化时为追加的点数
+    int m_changeStartCount; // 批量更新中第一次变化之前的点数
 
 private:
     Q_DECLARE_PUBLIC(QXYSeries)
@@ -32,26 +32,59 @@
 #include <private/qxyseries_p.h>
 #include <private/chartpresenter_p.h>
 #include <private/abstractdomain_p.h>
+#include <private/polardomain_p.h>
 #include <private/chartdataset_p.h>
 #include <private/glxyseriesdata_p.h>
 #include <QtCharts/QXYModelMapper>
 #include <private/qabstractaxis_p.h>
 #include <QtGui/QPainter>
 #include <QtCore/QAbstractItemModel>
+#include <QtCore/QtMath>
+#include <QtCore/QtNumeric>
+#include <QtCore/QThreadPool>
+#include <algorithm>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
+// 交互停止后重新换算几何点集前等待的毫秒数
+static const int SettleInterval = 150;
+// 交互变换相对上次换算允许的最大缩放倍数
+static const qreal MaxTransformScale = 2.0;
+// 在后台换算几何点集的最少序列点数
+static const int AsyncGeometryThreshold = 16384;
+
 // 构造
 XYChart::XYChart(QXYSeries *series, QGraphicsItem *item):
       ChartItem(series->d_func(),item), // 基类构造函数
       m_series(series), // 所属序列
+      m_firstIndex(0), // 首个几何点对应的序列点索引
+      m_windowed(false), // 几何点集是否只包含可见窗口
+      m_reduced(false), // 几何点集是否由最值金字塔抽稀
       m_animation(0), // 动画
-      m_dirty(true) // 是否脏数据
+      m_dirty(true), // 是否脏数据
+      m_transformable(false), // 几何点集能否随交互变换
+      m_coveredMinX(0), // 已换算的最小x
+      m_coveredMaxX(0), // 已换算的最大x
+      m_backBuffer(QSharedPointer<XYGeometryBackBuffer>::create(this)), // 后台换算的后缓冲
+      m_geometryRunning(false), // 是否有后台换算任务正在进行
+      m_geometryRequested(false), // 任务进行期间是否又请求了换算
+      m_geometryPending(false), // 几何点集是否落后于数据和区域
+      m_geometryAhead(false), // 几何点集是否已包含尚未通知的数据变化
+      m_snapshotGeometry(false) // 几何点集是否换算自较旧的快照
 {
+    setGeometryChange(-1, 0, 0, 0); // 尚无增量变化
+    // 交互停止后重新换算
+    m_settleTimer.setSingleShot(true);
+    m_settleTimer.setInterval(SettleInterval);
+    QObject::connect(&m_settleTimer, SIGNAL(timeout()), this, SLOT(handleDomainUpdated()));
+
     // 连接信、槽
     QObject::connect(series, SIGNAL(pointReplaced(int)), this, SLOT(handlePointReplaced(int)));
+    QObject::connect(series, SIGNAL(pointRangeReplaced(int,int)), this, SLOT(handlePointRangeReplaced(int,int)));
     QObject::connect(series, SIGNAL(pointsReplaced()), this, SLOT(handlePointsReplaced()));
     QObject::connect(series, SIGNAL(pointAdded(int)), this, SLOT(handlePointAdded(int)));
+    QObject::connect(series, SIGNAL(pointsAdded(int, int)), this, SLOT(handlePointsAdded(int, int)));
+    QObject::connect(series, SIGNAL(pointsAdvanced(int, int)), this, SLOT(handlePointsAdvanced(int, int)));
     QObject::connect(series, SIGNAL(pointRemoved(int)), this, SLOT(handlePointRemoved(int)));
     QObject::connect(series, SIGNAL(pointsRemoved(int, int)), this, SLOT(handlePointsRemoved(int, int)));
     QObject::connect(this, SIGNAL(clicked(QPointF)), series, SIGNAL(clicked(QPointF)));
@@ -60,6 +93,15 @@ XYChart::XYChart(QXYSeries *series, QGraphicsItem *item):
     QObject::connect(this, SIGNAL(released(QPointF)), series, SIGNAL(released(QPointF)));
     QObject::connect(this, SIGNAL(doubleClicked(QPointF)), series, SIGNAL(doubleClicked(QPointF)));
     QObject::connect(series, &QAbstractSeries::useOpenGLChanged,this, &XYChart::handleDomainUpdated);
+    QObject::connect(series->d_func(), SIGNAL(updated()), this, SLOT(handleSeriesUpdated()));
+    QObject::connect(series, SIGNAL(pointLabelsVisibilityChanged(bool)), this, SLOT(handleSeriesUpdated()));
+}
+
+// 析构
+XYChart::~XYChart()
+{
+    // 取消后台换算，任务可能晚于图表项结束
+    m_backBuffer->detach();
 }
 
 // 设置几何点集
@@ -99,26 +141,41 @@ QVector<bool> XYChart::offGridStatusVector()
     // During remove animation series may have different number of points,
     // so ensure we don't go over the index. No need to check for zero points, this
     // will not be called in such a situation.
-    // 最后一个序列索引
-    const int seriesLastIndex = m_series->count() - 1;
-
-    // 遍历点集
-    for (int i = 0; i < m_points.size(); i++) {
-        // 获取序列点
-        const QPointF &seriesPoint = m_series->at(qMin(seriesLastIndex, i));
-        // 如果点在范围外
-        if (seriesPoint.x() < minX
-            || seriesPoint.x() > maxX
-            || seriesPoint.y() < minY
-            || seriesPoint.y() > maxY) {
-            returnVector[i] = true;
+    // 可与序列点一一对应的点数
+    const XYSeriesBuffer &buffer = geometrySource();
+    const int count = qMax(0, qMin(m_points.size(), buffer.count() - m_firstIndex));
+    bool *status = returnVector.data();
+
+    // 列布局，直接扫描x、y列
+    if (buffer.layout() == QXYSeries::StorageLayoutColumns) {
+        const qreal *x = buffer.xData() + m_firstIndex;
+        const qreal *y = buffer.yData() + m_firstIndex;
+        for (int i = 0; i < count; i++)
+            status[i] = x[i] < minX || x[i] > maxX || y[i] < minY || y[i] > maxY;
+    }
+    // 均匀采样布局，x值由采样参数算出
+    else if (buffer.layout() == QXYSeries::StorageLayoutUniformX) {
+        const qreal *y = buffer.yData() + m_firstIndex;
+        const qreal x0 = buffer.xAt(m_firstIndex);
+        const qreal dx = buffer.samplingInterval();
+        for (int i = 0; i < count; i++) {
+            const qreal x = x0 + i * dx;
+            status[i] = x < minX || x > maxX || y[i] < minY || y[i] > maxY;
         }
-        // 如果点未在范围内
-        else {
-            returnVector[i] = false;
+    }
+    // 点布局，逐点扫描
+    else {
+        const QPointF *points = buffer.constData() + m_firstIndex;
+        for (int i = 0; i < count; i++) {
+            status[i] = points[i].x() < minX || points[i].x() > maxX
+                    || points[i].y() < minY || points[i].y() > maxY;
         }
     }
 
+    // 多出的几何点沿用最后一个序列点的标记
+    for (int i = count; i < m_points.size(); i++)
+        status[i] = count > 0 && status[count - 1];
+
     // 返回带范围标记的点
     return returnVector;
 }
@@ -149,6 +206,7 @@ void XYChart::updateChart(QVector<QPointF> &oldPoints, QVector<QPointF> &newPoin
 // 更新 OpenGL 图表
 void XYChart::updateGlChart()
 {
+    cancelGeometry();
     dataSet()->glXYSeriesDataManager()->setPoints(m_series, domain());
     presenter()->updateGLWidget();
     updateGeometry();
@@ -169,6 +227,10 @@ void XYChart::handlePointAdded(int index)
     Q_ASSERT(index < m_series->count());
     Q_ASSERT(index >= 0);
 
+    settleGeometryTransform(); // 并入交互变换
+    if (!m_series->useOpenGL() && handleDataChanged(index == m_series->count() - 1 ? index : -1))
+        return; // 派生类不使用几何点集绘制
+
     // 如果使用OpenGL
     if (m_series->useOpenGL()) {
         updateGlChart(); // 更新OpenGL图表
@@ -176,35 +238,129 @@ void XYChart::handlePointAdded(int index)
     // 如果不使用OpenGL
     else {
         QVector<QPointF> points;
-        // 如果是脏数据或点集为空
-        if (m_dirty || m_points.isEmpty()) {
-            points = domain()->calculateGeometryPoints(m_series->pointsVector()); // 计算点集位置
+        // 几何点集不能增量更新时重新换算
+        if (!canUpdatePoints(1)) {
+            if (requestGeometry()) // 点数较多时在后台换算
+                return;
+            points = visibleGeometryPoints(); // 计算点集位置
         }
-        // 如果不是脏数据且点集非空
+        // 仅换算新增的点，对数轴上的非正值换算为断点
         else {
-            // 记录点集
-            points = m_points;
-            // 换算点的位置
-            QPointF point = domain()->calculateGeometryPoint(m_series->pointsVector().at(index),
-                                                             m_validData);
+            const QVector<QPointF> addedPoints = seriesGeometryPoints(index, 1);
             // 如果数据无效
-            if (!m_validData)
+            if (addedPoints.isEmpty()) {
                 m_points.clear();
+            }
             // 如果数据有效
-            else
-                points.insert(index, point);
+            else {
+                points = m_points;
+                points.insert(index, addedPoints.first());
+                setGeometryChange(0, index, 0, 1);
+            }
+        }
+        // 更新图表
+        updateChart(m_points, points, index);
+    }
+}
+
+// 点集增加信号相应槽
+void XYChart::handlePointsAdded(int index, int count)
+{
+    Q_ASSERT(index + count <= m_series->count());
+    Q_ASSERT(index >= 0);
+
+    settleGeometryTransform(); // 并入交互变换
+    if (!m_series->useOpenGL() && handleDataChanged(index + count == m_series->count() ? index : -1))
+        return; // 派生类不使用几何点集绘制
+
+    // 如果使用OpenGL
+    if (m_series->useOpenGL()) {
+        updateGlChart(); // 更新OpenGL图表
+    }
+    // 如果不使用OpenGL
+    else {
+        QVector<QPointF> points;
+        // 几何点集不能增量更新时重新换算
+        if (!canUpdatePoints(count)) {
+            if (requestGeometry()) // 点数较多时在后台换算
+                return;
+            points = visibleGeometryPoints(); // 计算点集位置
+        }
+        // 如果不是脏数据且点集非空，仅换算新增的点
+        else {
+            const QVector<QPointF> addedPoints = seriesGeometryPoints(index, count);
+            // 如果数据无效
+            if (addedPoints.isEmpty()) {
+                m_points.clear();
+            }
+            // 如果数据有效，将新增点一次性插入
+            else {
+                points.reserve(m_points.count() + addedPoints.count());
+                points += m_points.mid(0, index);
+                points += addedPoints;
+                points += m_points.mid(index);
+                setGeometryChange(0, index, 0, count);
+            }
         }
         // 更新图表
         updateChart(m_points, points, index);
     }
 }
 
+// 点集推进信号相应槽
+void XYChart::handlePointsAdvanced(int removedCount, int addedCount)
+{
+    Q_ASSERT(addedCount <= m_series->count());
+    Q_ASSERT(removedCount >= 0);
+
+    settleGeometryTransform(); // 并入交互变换
+    if (!m_series->useOpenGL() && handleDataChanged(-1))
+        return; // 派生类不使用几何点集绘制
+
+    // 如果使用OpenGL
+    if (m_series->useOpenGL()) {
+        updateGlChart(); // 更新OpenGL图表
+    }
+    // 如果不使用OpenGL
+    else {
+        QVector<QPointF> points;
+        // 几何点集不能增量更新时重新换算
+        if (!canUpdatePoints(addedCount - removedCount)) {
+            if (requestGeometry()) // 点数较多时在后台换算
+                return;
+            points = visibleGeometryPoints(); // 计算点集位置
+        }
+        // 丢弃被淘汰点的几何点，仅换算新增的点
+        else {
+            const QVector<QPointF> addedPoints =
+                seriesGeometryPoints(m_series->count() - addedCount, addedCount);
+            // 如果数据无效
+            if (addedPoints.isEmpty()) {
+                m_points.clear();
+            }
+            // 如果数据有效
+            else {
+                points.reserve(m_points.count() - removedCount + addedPoints.count());
+                points += m_points.mid(removedCount);
+                points += addedPoints;
+                setGeometryChange(removedCount, m_points.count() - removedCount, 0, addedCount);
+            }
+        }
+        // 更新图表
+        updateChart(m_points, points);
+    }
+}
+
 // 点移除信号相应槽
 void XYChart::handlePointRemoved(int index)
 {
     Q_ASSERT(index <= m_series->count());
     Q_ASSERT(index >= 0);
 
+    settleGeometryTransform(); // 并入交互变换
+    if (!m_series->useOpenGL() && handleDataChanged(-1))
+        return; // 派生类不使用几何点集绘制
+
     // 如果使用OpenGL
     if (m_series->useOpenGL()) {
         updateGlChart();
@@ -212,14 +368,17 @@ void XYChart::handlePointRemoved(int index)
     // 如果没有使用OpenGL
     else {
         QVector<QPointF> points;
-        // 脏数据或者点集为空
-        if (m_dirty || m_points.isEmpty()) {
+        // 几何点集不能增量更新时重新换算
+        if (!canUpdatePoints(-1)) {
+            if (requestGeometry()) // 点数较多时在后台换算
+                return;
             // 更新点集
-            points = domain()->calculateGeometryPoints(m_series->pointsVector());
+            points = visibleGeometryPoints();
         } else {
             // 删除点集
             points = m_points;
             points.remove(index);
+            setGeometryChange(0, index, 1, 0);
         }
         // 更新图表
         updateChart(m_points, points, index);
@@ -232,19 +391,26 @@ void XYChart::handlePointsRemoved(int index, int count)
     Q_ASSERT(index <= m_series->count());
     Q_ASSERT(index >= 0);
 
+    settleGeometryTransform(); // 并入交互变换
+    if (!m_series->useOpenGL() && handleDataChanged(-1))
+        return; // 派生类不使用几何点集绘制
+
     // 如果使用OpenGL
     if (m_series->useOpenGL()) {
         updateGlChart(); // 更新图表
     } else {
         QVector<QPointF> points;
-        // 脏数据，点集为空
-        if (m_dirty || m_points.isEmpty()) {
-            points = domain()->calculateGeometryPoints(m_series->pointsVector());
+        // 几何点集不能增量更新时重新换算
+        if (!canUpdatePoints(-count)) {
+            if (requestGeometry()) // 点数较多时在后台换算
+                return;
+            points = visibleGeometryPoints();
         }
         // 非脏数据，点集非空
         else {
             points = m_points;
             points.remove(index, count);
+            setGeometryChange(0, index, count, 0);
         }
         // 更新图表
         updateChart(m_points, points, index);
@@ -257,6 +423,10 @@ void XYChart::handlePointReplaced(int index)
     Q_ASSERT(index < m_series->count());
     Q_ASSERT(index >= 0);
 
+    settleGeometryTransform(); // 并入交互变换
+    if (!m_series->useOpenGL() && handleDataChanged(-1))
+        return; // 派生类不使用几何点集绘制
+
     // 如果使用OpenGL
     if (m_series->useOpenGL()) {
         updateGlChart(); // 更新图表
@@ -264,28 +434,76 @@ void XYChart::handlePointReplaced(int index)
     // 如果不使用OpenGL
     else {
         QVector<QPointF> points;
-        // 脏数据、点集为空
-        if (m_dirty || m_points.isEmpty()) {
-            points = domain()->calculateGeometryPoints(m_series->pointsVector());
+        // 几何点集不能增量更新时重新换算
+        if (!canUpdatePoints(0)) {
+            if (requestGeometry()) // 点数较多时在后台换算
+                return;
+            points = visibleGeometryPoints();
         }
-        // 非脏数据、点击非空
+        // 仅换算替换的点，对数轴上的非正值换算为断点
         else {
-            QPointF point = domain()->calculateGeometryPoint(m_series->pointsVector().at(index),
-                                                             m_validData);
-            if (!m_validData)
+            const QVector<QPointF> replaced = seriesGeometryPoints(index, 1);
+            if (replaced.isEmpty()) {
                 m_points.clear();
-            points = m_points;
-            if (m_validData)
-                points.replace(index, point);
+            } else {
+                points = m_points;
+                points.replace(index, replaced.first());
+                setGeometryChange(0, index, 1, 1);
+            }
         }
         // 更新图表
         updateChart(m_points, points, index);
     }
 }
 
+// 点区间替换信号响应槽
+void XYChart::handlePointRangeReplaced(int index, int count)
+{
+    Q_ASSERT(index >= 0);
+    Q_ASSERT(index + count <= m_series->count());
+
+    settleGeometryTransform(); // 并入交互变换
+    if (!m_series->useOpenGL() && handleDataChanged(-1))
+        return; // 派生类不使用几何点集绘制
+
+    // 如果使用OpenGL
+    if (m_series->useOpenGL()) {
+        updateGlChart(); // 更新图表
+    }
+    // 如果不使用OpenGL
+    else {
+        QVector<QPointF> points;
+        // 几何点集不能增量更新时重新换算
+        if (!canUpdatePoints(0)) {
+            if (requestGeometry()) // 点数较多时在后台换算
+                return;
+            points = visibleGeometryPoints();
+        }
+        // 非脏数据、点集非空，只换算替换的区间
+        else {
+            const QVector<QPointF> replaced = seriesGeometryPoints(index, count);
+            if (replaced.count() == count) {
+                points = m_points;
+                std::copy(replaced.constBegin(), replaced.constEnd(), points.begin() + index);
+                setGeometryChange(0, index, count, count);
+            } else {
+                if (requestGeometry()) // 点数较多时在后台换算
+                    return;
+                points = visibleGeometryPoints();
+            }
+        }
+        // 更新图表
+        updateChart(m_points, points);
+    }
+}
+
 // 点集替换信号相应槽
 void XYChart::handlePointsReplaced()
 {
+    settleGeometryTransform(); // 并入交互变换
+    if (!m_series->useOpenGL() && handleDataChanged(-1))
+        return; // 派生类不使用几何点集绘制
+
     // 使用OpenGL
     if (m_series->useOpenGL()) {
         updateGlChart();
@@ -293,7 +511,9 @@ void XYChart::handlePointsReplaced()
     // 为使用OpenGL
     else {
         // All the points were replaced -> recalculate
-        QVector<QPointF> points = domain()->calculateGeometryPoints(m_series->pointsVector());
+        if (requestGeometry()) // 点数较多时在后台换算
+            return;
+        QVector<QPointF> points = visibleGeometryPoints();
         updateChart(m_points, points, -1);
     }
 }
@@ -307,16 +527,274 @@ void XYChart::handleDomainUpdated()
     }
     // 未使用OpenGL
     else {
+        if (handleDomainChanged()) // 派生类不使用几何点集绘制
+            return;
+        // 交互平移、缩放时只变换上次的几何
+        if (transformGeometry())
+            return;
+        settleGeometryTransform();
         if (isEmpty()) return;
-        QVector<QPointF> points = domain()->calculateGeometryPoints(m_series->pointsVector());
+        if (requestGeometry()) // 点数较多时在后台换算
+            return;
+        QVector<QPointF> points = visibleGeometryPoints();
         updateChart(m_points, points);
     }
 }
 
+// 交互平移、缩放时，以图形项变换代替重新换算
+// 区域为线性（对数轴上为对数空间线性）时，新旧几何坐标之间只差一个各轴独立的线性变换。
+// 缩放超过阈值、窗口之外的点进入视野或者正在播放动画时仍然重新换算；交互停止一段时间后
+// 由定时器重新换算，以恢复抽稀、剪切的精度。
+bool XYChart::transformGeometry()
+{
+    DomainTransform current;
+    if (!domain()->isInteractive() || !m_transformable || m_points.isEmpty() || m_geometryPending
+            || !acceptsGeometryTransform()
+            || (m_animation && m_animation->state() == QAbstractAnimation::Running)
+            || !domain()->geometryTransform(current)) {
+        return false;
+    }
+
+    // 窗口之外的点未换算
+    if (domain()->minX() < m_coveredMinX || domain()->maxX() > m_coveredMaxX)
+        return false;
+
+    // 相对上次换算缩放过多时，抽稀精度或者剪切范围不再适用
+    const QTransform transform = current.transformFrom(m_geometryTransform);
+    const qreal scaleX = qAbs(transform.m11());
+    const qreal scaleY = qAbs(transform.m22());
+    if (scaleX < 1 / MaxTransformScale || scaleX > MaxTransformScale
+            || scaleY < 1 / MaxTransformScale || scaleY > MaxTransformScale) {
+        return false;
+    }
+
+    setTransform(transform);
+    m_settleTimer.start();
+    return true;
+}
+
+// 把交互变换并入几何点集并复位图形项变换，此后几何点集对应当前区域
+void XYChart::settleGeometryTransform()
+{
+    m_settleTimer.stop();
+    if (transform().isIdentity())
+        return;
+
+    mapGeometry(transform());
+    resetTransform();
+    m_transformable = domain()->geometryTransform(m_geometryTransform);
+}
+
+// 几何点集能否按数据变化增量更新，countChange为变化增加的点数
+// 增量更新要求几何点集恰好对应变化之前的全部序列点。批量更新期间区域变化会按已修改的序列
+// 换算几何点集，之后提交的变化已经包含在其中，不能再增量应用。
+bool XYChart::canUpdatePoints(int countChange) const
+{
+    return !m_dirty && !m_windowed && !m_points.isEmpty() && !m_geometryPending && !m_geometryAhead
+            && m_points.count() + countChange == m_series->count();
+}
+
+// 把线性变换作用于几何点集，派生类据此同步由几何点集导出的数据（如样条控制点）
+void XYChart::mapGeometry(const QTransform &transform)
+{
+    m_points = transform.map(QPolygonF(m_points));
+}
+
+// 记录下次更新图表的增量变化
+// 增量更新的处理函数在调用 updateChart() 前记录新点集相对几何点集的变化，派生类据此只更新
+// 变化附近的派生几何；重新换算几何点集时记为没有对应关系。
+void XYChart::setGeometryChange(int dropped, int index, int removed, int added)
+{
+    m_geometryChange.dropped = dropped;
+    m_geometryChange.index = index;
+    m_geometryChange.removed = removed;
+    m_geometryChange.added = added;
+}
+
+// 换算序列中从index开始的count个点的几何位置，count为-1时换算到末尾
+QVector<QPointF> XYChart::seriesGeometryPoints(int index, int count)
+{
+    const XYSeriesBuffer &buffer = m_series->d_func()->pointBuffer();
+    if (count < 0)
+        count = buffer.count() - index;
+
+    QVector<QPointF> result(count);
+    if (!m_series->d_func()->calculateGeometryPoints(domain(), index, count, result.data()))
+        return QVector<QPointF>();
+    return result;
+}
+
+// 换算可见窗口内序列点集的几何位置，并记录窗口起始索引
+QVector<QPointF> XYChart::visibleGeometryPoints()
+{
+    cancelGeometry(); // 同步换算的结果取代后台换算
+
+    // 直角坐标区域与后台换算使用同一换算过程
+    XYGeometryParameters parameters;
+    if (geometryParameters(parameters)) {
+        XYGeometryResult result;
+        XYGeometryJob::calculate(m_series->d_func()->pointBuffer(), parameters, result);
+        applyGeometryResult(result);
+        return result.points;
+    }
+
+    // 极坐标区域换算全部点
+    m_windowed = false;
+    m_firstIndex = 0;
+    m_reduced = false;
+    m_transformable = false;
+    m_geometryAhead = m_series->isUpdating();
+    m_geometrySnapshot = XYSeriesBuffer();
+    m_snapshotGeometry = false;
+    setGeometryChange(-1, 0, 0, 0);
+    m_coveredMinX = -qInf();
+    m_coveredMaxX = qInf();
+    return seriesGeometryPoints();
+}
+
+// 获取直角坐标区域的换算参数，极坐标区域返回false
+// 动画会按索引插值前后两组几何点，因此启用动画时始终换算全部点，也不抽稀。
+bool XYChart::geometryParameters(XYGeometryParameters &parameters)
+{
+    if (!domain()->geometryTransform(parameters.transform))
+        return false;
+
+    parameters.logarithmic = domain()->logBases(parameters.logBaseX, parameters.logBaseY);
+    if (!parameters.logarithmic)
+        parameters.logBaseX = parameters.logBaseY = 0;
+    parameters.minX = domain()->minX();
+    parameters.maxX = domain()->maxX();
+    parameters.windowing = !m_animation;
+    parameters.buckets = !m_animation && m_series->d_func()->useReducedPoints()
+            ? qCeil(domain()->size().width()) : 0;
+    parameters.columnSpan = XYSeriesLod::columnSpan(parameters.minX, parameters.maxX,
+                                                    parameters.logBaseX, domain()->size().width());
+    return true;
+}
+
+// 记录换算结果的窗口、抽稀标志以及换算时的线性变换和已换算的x范围，供交互变换使用
+void XYChart::applyGeometryResult(const XYGeometryResult &result)
+{
+    m_firstIndex = result.firstIndex;
+    m_windowed = result.windowed;
+    m_reduced = result.reduced;
+    m_transformable = true;
+    m_geometryAhead = m_series->isUpdating();
+    m_geometrySnapshot = XYSeriesBuffer();
+    m_snapshotGeometry = false;
+    setGeometryChange(-1, 0, 0, 0);
+    m_geometryTransform = result.transform;
+    m_coveredMinX = result.coveredMinX;
+    m_coveredMaxX = result.coveredMaxX;
+}
+
+// 在后台换算可见窗口的几何点集，完成后由 handleGeometryReady() 换入
+// 只用于点数较多的直角坐标序列；启用动画时需要同时取得新旧两组几何点，仍然同步换算。
+// 每个图表项同时只有一个任务，任务进行期间的请求合并为任务完成后的一次换算。
+bool XYChart::requestGeometry()
+{
+    XYGeometryParameters parameters;
+    if (m_animation || m_series->count() < AsyncGeometryThreshold
+            || !geometryParameters(parameters)) {
+        return false;
+    }
+
+    m_geometryPending = true;
+    if (m_geometryRunning)
+        m_geometryRequested = true;
+    else
+        startGeometryJob(parameters);
+    return true;
+}
+
+// 启动后台换算任务，任务持有点缓冲的快照
+void XYChart::startGeometryJob(const XYGeometryParameters &parameters)
+{
+    m_geometryRunning = true;
+    m_geometryRequested = false;
+    QThreadPool::globalInstance()->start(new XYGeometryJob(m_backBuffer, m_backBuffer->revision(),
+                                                           m_series->d_func()->pointBuffer(),
+                                                           parameters));
+}
+
+// 取消后台换算，此后由调用者同步换算
+void XYChart::cancelGeometry()
+{
+    if (m_geometryRunning)
+        m_backBuffer->cancel();
+    m_geometryRunning = false;
+    m_geometryRequested = false;
+    m_geometryPending = false;
+}
+
+// 后台换算完成响应槽
+// 把结果换入几何点集，并交还快照中构建的缓存；任务进行期间又有变化时，先显示这次的结果，
+// 再换算最新的状态。显示的结果中的索引对应的是快照，此时保留快照供范围标记和点标签读取；
+// 序列修改后已不再与快照共享存储，保留快照不会引起复制。
+void XYChart::handleGeometryReady()
+{
+    XYGeometryResult result;
+    if (!m_backBuffer->take(result))
+        return;
+
+    m_geometryRunning = false;
+    m_series->d_func()->adoptPointCaches(result.snapshot);
+    applyGeometryResult(result);
+    if (result.snapshot.revision() != m_series->d_func()->pointBuffer().revision()) {
+        m_geometrySnapshot = result.snapshot;
+        m_snapshotGeometry = true;
+    }
+
+    QVector<QPointF> points = result.points;
+    if (m_geometryRequested) {
+        XYGeometryParameters parameters;
+        if (!m_animation && geometryParameters(parameters))
+            startGeometryJob(parameters);
+        else
+            points = visibleGeometryPoints(); // 已不能在后台换算，同步换算最新的状态
+    } else {
+        m_geometryPending = false;
+    }
+
+    updateChart(m_points, points);
+}
+
+// 几何点集换算自的点缓冲
+// 通常为序列的点缓冲；显示后台换算的中间结果期间为换算所用的快照，firstIndex() 及几何点的
+// 索引都对应快照中的点。
+const XYSeriesBuffer &XYChart::geometrySource() const
+{
+    return m_snapshotGeometry ? m_geometrySnapshot : m_series->d_func()->pointBuffer();
+}
+
+// 按描边宽度估算路径描边后的外接矩形，不生成描边轮廓
+// 方形线帽超出端点不到一个线宽，尖角连接最多超出连接点 miterLimit 个线宽。
+QRectF XYChart::strokeBoundingRect(const QPainterPath &path, qreal width, qreal miterLimit)
+{
+    if (path.isEmpty())
+        return QRectF();
+    return strokeBoundingRect(path.boundingRect(), width, miterLimit);
+}
+
+// 按描边宽度由路径外接矩形估算描边后的外接矩形，用于增量维护外接矩形的路径
+QRectF XYChart::strokeBoundingRect(const QRectF &bounds, qreal width, qreal miterLimit)
+{
+    const qreal extent = width * qMax(qreal(1), miterLimit);
+    return bounds.adjusted(-extent, -extent, extent, extent);
+}
+
+// 序列外观更新信号响应槽
+// 抽稀、点和点标签的可见性决定了能否使用最值金字塔，变化时需要重新换算几何点集
+void XYChart::handleSeriesUpdated()
+{
+    if (m_reduced || m_series->d_func()->useReducedPoints())
+        handleDomainUpdated();
+}
+
 // 图表项是否为空
 bool XYChart::isEmpty()
 {
-    return domain()->isEmpty() || m_series->points().isEmpty();
+    return domain()->isEmpty() || m_series->count() == 0;
 }
 
 #include "moc_xychart_p.cpp"
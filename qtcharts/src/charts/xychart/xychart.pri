@@ -1,8 +1,18 @@
-INCLUDEPATH += $$PWD
+﻿INCLUDEPATH += $$PWD
 
 SOURCES += \
     $$PWD/xychart.cpp \
     $$PWD/qxyseries.cpp \
+    $$PWD/xyseriesbuffer.cpp \
+    $$PWD/xydecimator.cpp \
+    $$PWD/xyserieslod.cpp \
+    $$PWD/xyserieslogcache.cpp \
+    $$PWD/xygeometryworkers.cpp \
+    $$PWD/xygeometryjob.cpp \
+    $$PWD/xyseriesingestqueue.cpp \
+    $$PWD/xypointlabels.cpp \
+    $$PWD/xypointgrid.cpp \
+    $$PWD/xypointindex.cpp \
     $$PWD/qxymodelmapper.cpp \
     $$PWD/qvxymodelmapper.cpp \
     $$PWD/qhxymodelmapper.cpp  \
@@ -11,6 +21,16 @@ SOURCES += \
 PRIVATE_HEADERS += \
     $$PWD/xychart_p.h \
     $$PWD/qxyseries_p.h \
+    $$PWD/xyseriesbuffer_p.h \
+    $$PWD/xydecimator_p.h \
+    $$PWD/xyserieslod_p.h \
+    $$PWD/xyserieslogcache_p.h \
+    $$PWD/xygeometryworkers_p.h \
+    $$PWD/xygeometryjob_p.h \
+    $$PWD/xyseriesingestqueue_p.h \
+    $$PWD/xypointlabels_p.h \
+    $$PWD/xypointgrid_p.h \
+    $$PWD/xypointindex_p.h \
     $$PWD/qxymodelmapper_p.h \
     $$PWD/glxyseriesdata_p.h
 
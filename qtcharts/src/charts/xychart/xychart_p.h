@@ -42,25 +42,41 @@
 #include <QtCharts/QChartGlobal>
 #include <private/chartitem_p.h>
 #include <private/xyanimation_p.h>
+#include <private/xygeometryjob_p.h>
 #include <QtCharts/QValueAxis>
 #include <QtCharts/private/qchartglobal_p.h>
 #include <QtGui/QPen>
+#include <QtCore/QTimer>
+#include <QtCore/QSharedPointer>
 
 QT_CHARTS_BEGIN_NAMESPACE
 
 class ChartPresenter;
 class QXYSeries;
 
+// 几何点集的增量变化：去掉开头dropped个点后，从index开始的removed个点换为added个新点。
+// dropped为-1表示几何点集重新换算，新旧点集之间没有对应关系
+struct XYGeometryChange
+{
+    int dropped; // 从开头淘汰的点数，-1表示重新换算
+    int index; // 变化的起始索引，对应淘汰之后的点集
+    int removed; // 移除的点数
+    int added; // 新增的点数
+};
+
 // x、y图表项
 class QT_CHARTS_PRIVATE_EXPORT XYChart :  public ChartItem
 {
     Q_OBJECT
 public:
     explicit XYChart(QXYSeries *series,QGraphicsItem *item = 0); // 构造
-    ~XYChart() {} // 析构
+    ~XYChart(); // 析构
 
     void setGeometryPoints(const QVector<QPointF> &points); // 设置几何点集
     QVector<QPointF> geometryPoints() const { return m_points; } // 获取几何点集
+    void swapGeometryPoints(QVector<QPointF> &points) { m_points.swap(points); } // 与几何点集交换，动画借此在两个缓冲之间轮换而不必每帧分配
+    int firstIndex() const { return m_firstIndex; } // 首个几何点对应的序列点索引
+    const XYSeriesBuffer &geometrySource() const; // 几何点集换算自的点缓冲，firstIndex() 为其中的索引
 
     void setAnimation(XYAnimation *animation); // 设置动画
     ChartAnimation *animation() const { return m_animation; } // 获取动画
@@ -74,11 +90,18 @@ public:
 
 public Q_SLOTS:
     void handlePointAdded(int index); // 点增加信号响应槽
+    void handlePointsAdded(int index, int count); // 点集增加信号响应槽
+    void handlePointsAdvanced(int removedCount, int addedCount); // 点集推进信号响应槽
     void handlePointRemoved(int index); // 点移除信号响应槽
     void handlePointsRemoved(int index, int count); // 点集移除信号响应槽
     void handlePointReplaced(int index); // 点替换信号响应槽
+    void handlePointRangeReplaced(int index, int count); // 点区间替换信号响应槽
     void handlePointsReplaced(); // 点集替换信号响应槽
     void handleDomainUpdated(); // 区域更新信号响应槽
+    void handleSeriesUpdated(); // 序列外观更新信号响应槽
+
+private Q_SLOTS:
+    void handleGeometryReady(); // 后台换算完成响应槽
 
 Q_SIGNALS:
     void clicked(const QPointF &point);
@@ -91,6 +114,25 @@ protected:
     virtual void updateChart(QVector<QPointF> &oldPoints, QVector<QPointF> &newPoints, int index = -1); // 更新图表
     virtual void updateGlChart(); // 更新OpenGL图表
     virtual void refreshGlChart(); // 刷新OpenGL图表
+    QVector<QPointF> seriesGeometryPoints(int index = 0, int count = -1); // 换算序列点集的几何位置
+    QVector<QPointF> visibleGeometryPoints(); // 换算可见窗口内序列点集的几何位置
+    bool geometryParameters(XYGeometryParameters &parameters); // 获取直角坐标区域的换算参数
+    void applyGeometryResult(const XYGeometryResult &result); // 记录换算结果的窗口、变换等信息
+    bool requestGeometry(); // 在后台换算可见窗口的几何点集，返回是否已发起
+    void startGeometryJob(const XYGeometryParameters &parameters); // 启动后台换算任务
+    void cancelGeometry(); // 取消后台换算
+    static QRectF strokeBoundingRect(const QPainterPath &path, qreal width,
+                                     qreal miterLimit); // 按描边宽度估算路径描边后的外接矩形
+    static QRectF strokeBoundingRect(const QRectF &bounds, qreal width,
+                                     qreal miterLimit); // 按描边宽度由路径外接矩形估算描边后的外接矩形
+    virtual bool acceptsGeometryTransform() const { return false; } // 交互时能否以图形项变换代替重新换算
+    virtual bool handleDataChanged(int appendedIndex) { Q_UNUSED(appendedIndex); return false; } // 派生类不换算几何点集而直接处理数据变化时返回true，appendedIndex为尾部追加的首个点的索引，其他变化为-1
+    virtual bool handleDomainChanged() { return false; } // 派生类不换算几何点集而直接处理区域变化时返回true
+    bool transformGeometry(); // 以图形项变换跟随交互平移、缩放，返回是否成功
+    void settleGeometryTransform(); // 把交互变换并入几何点集
+    bool canUpdatePoints(int countChange) const; // 几何点集能否按点数变化了countChange的数据变化增量更新
+    virtual void mapGeometry(const QTransform &transform); // 把线性变换作用于几何点集及其派生几何
+    void setGeometryChange(int dropped, int index, int removed, int added); // 记录下次更新图表的增量变化
 
 private:
     inline bool isEmpty(); // 是否为空
@@ -98,8 +140,24 @@ private:
 protected:
     QXYSeries *m_series; // 所属序列
     QVector<QPointF> m_points; // 存储点
+    int m_firstIndex; // 首个几何点对应的序列点索引
+    bool m_windowed; // 几何点集是否只包含可见窗口
+    bool m_reduced; // 几何点集是否由最值金字塔抽稀
     XYAnimation *m_animation; // 动画
     bool m_dirty; // 是否为脏数据
+    bool m_transformable; // 几何点集能否随交互变换
+    DomainTransform m_geometryTransform; // 换算几何点集时的线性变换
+    qreal m_coveredMinX; // 已换算的最小x
+    qreal m_coveredMaxX; // 已换算的最大x
+    QTimer m_settleTimer; // 交互停止后重新换算的定时器
+    QSharedPointer<XYGeometryBackBuffer> m_backBuffer; // 后台换算的后缓冲
+    bool m_geometryRunning; // 是否有后台换算任务正在进行
+    bool m_geometryRequested; // 任务进行期间是否又请求了换算
+    bool m_geometryPending; // 几何点集是否落后于数据和区域，等待后台换算
+    bool m_geometryAhead; // 几何点集是否在批量更新期间换算，已包含尚未通知的数据变化
+    XYSeriesBuffer m_geometrySnapshot; // 几何点集落后于序列时换算所用的快照
+    bool m_snapshotGeometry; // 几何点集是否换算自较旧的快照
+    XYGeometryChange m_geometryChange; // 传给 updateChart() 的新点集相对几何点集的变化
 
     friend class AreaChartItem;
 };
@@ -0,0 +1,77 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/xydecimator_p.h>
+#include <cmath>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 抽稀几何点集
+QVector<QPointF> XYDecimator::decimate(const QVector<QPointF> &points)
+{
+    const int count = points.count();
+    if (count <= 4)
+        return points;
+
+    QVector<QPointF> result;
+    const QPointF *data = points.constData();
+
+    int first = 0;
+    while (first < count) {
+        // 找出与首点落在同一像素列中的连续点，记录其中y最小、最大的点
+        const qreal column = std::floor(data[first].x());
+        int last = first;
+        int minIndex = first;
+        int maxIndex = first;
+        while (last + 1 < count && std::floor(data[last + 1].x()) == column) {
+            last++;
+            if (data[last].y() < data[minIndex].y())
+                minIndex = last;
+            if (data[last].y() > data[maxIndex].y())
+                maxIndex = last;
+        }
+
+        // 按原有顺序输出首点、极值点和末点，重复的点只输出一次
+        const int lower = qMin(minIndex, maxIndex);
+        const int upper = qMax(minIndex, maxIndex);
+        result.append(data[first]);
+        if (lower > first)
+            result.append(data[lower]);
+        if (upper > lower)
+            result.append(data[upper]);
+        if (last > upper)
+            result.append(data[last]);
+
+        first = last + 1;
+    }
+
+    return result;
+}
+
+QT_CHARTS_END_NAMESPACE
@@ -0,0 +1,61 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef XYDECIMATOR_P_H
+#define XYDECIMATOR_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <QtCore/QVector>
+#include <QtCore/QPointF>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// x、y几何点抽稀
+// 采用 M4 算法：相邻且落在同一像素列中的几何点只保留第一个、最后一个、
+// y最小和y最大的点，并保持原有顺序。抽稀后的折线与原折线覆盖相同的像素，
+// 而点数不超过像素列数的四倍。
+class QT_CHARTS_PRIVATE_EXPORT XYDecimator
+{
+public:
+    static QVector<QPointF> decimate(const QVector<QPointF> &points); // 抽稀几何点集
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // XYDECIMATOR_P_H
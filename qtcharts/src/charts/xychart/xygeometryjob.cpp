@@ -0,0 +1,195 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/xygeometryjob_p.h>
+#include <private/xygeometryworkers_p.h>
+#include <QtCore/QMetaObject>
+#include <QtCore/QtNumeric>
+#include <cmath>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 构造
+XYGeometryBackBuffer::XYGeometryBackBuffer(QObject *receiver)
+    : m_revision(0), // 最新修订号
+      m_receiver(receiver), // 接收者
+      m_resultRevision(-1) // 结果的修订号
+{
+}
+
+// 取消正在进行的换算
+void XYGeometryBackBuffer::cancel()
+{
+    m_revision.fetchAndAddOrdered(1);
+}
+
+// 写入结果并通知接收者，已被取消的结果直接丢弃
+void XYGeometryBackBuffer::publish(int revision, const XYGeometryResult &result)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!isCurrent(revision) || !m_receiver)
+        return;
+
+    m_result = result;
+    m_resultRevision = revision;
+    QMetaObject::invokeMethod(m_receiver, "handleGeometryReady", Qt::QueuedConnection);
+}
+
+// 取出未被取消的结果
+bool XYGeometryBackBuffer::take(XYGeometryResult &result)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_resultRevision < 0 || !isCurrent(m_resultRevision))
+        return false;
+
+    result = m_result;
+    m_result = XYGeometryResult();
+    m_resultRevision = -1;
+    return true;
+}
+
+// 接收者析构前断开，此后的结果不再通知；已排队的通知随接收者一起删除
+void XYGeometryBackBuffer::detach()
+{
+    cancel();
+    QMutexLocker locker(&m_mutex);
+    m_receiver = 0;
+    m_result = XYGeometryResult();
+    m_resultRevision = -1;
+}
+
+// 构造
+XYGeometryJob::XYGeometryJob(const QSharedPointer<XYGeometryBackBuffer> &backBuffer, int revision,
+                             const XYSeriesBuffer &buffer, const XYGeometryParameters &parameters)
+    : m_backBuffer(backBuffer), // 后缓冲
+      m_revision(revision), // 修订号
+      m_buffer(buffer), // 点缓冲快照
+      m_parameters(parameters) // 换算参数
+{
+}
+
+// 执行
+void XYGeometryJob::run()
+{
+    XYGeometryResult result;
+    if (!calculate(m_buffer, m_parameters, result, m_backBuffer.data(), m_revision))
+        return;
+
+    result.snapshot = m_buffer;
+    m_backBuffer->publish(m_revision, result);
+}
+
+// 换算几何点集
+// 序列点按x值有序时只换算区域x范围内的点，并各多保留一个相邻点以便连线延伸到区域边界；
+// 需要抽稀时由最值金字塔为每个像素列取出少量点后再换算。点数较多时分块并行换算。
+bool XYGeometryJob::calculate(const XYSeriesBuffer &buffer, const XYGeometryParameters &parameters,
+                              XYGeometryResult &result, const XYGeometryBackBuffer *backBuffer,
+                              int revision)
+{
+    const auto cancelled = [&]() { return backBuffer && !backBuffer->isCurrent(revision); };
+
+    // 可见窗口
+    int index = 0;
+    int count = buffer.count();
+    result.windowed = false;
+    if (parameters.windowing && count > 0 && buffer.isSorted()) {
+        const int first = qMax(0, buffer.lowerBound(parameters.minX) - 1);
+        const int last = qMin(count, buffer.upperBound(parameters.maxX) + 1);
+        if (first != 0 || last != count) {
+            index = first;
+            count = qMax(0, last - first);
+            result.windowed = true;
+        }
+    }
+    result.firstIndex = index;
+    result.reduced = false;
+    result.transform = parameters.transform;
+    result.coveredMinX = result.windowed && index > 0 ? buffer.xAt(index) : -qInf();
+    result.coveredMaxX = result.windowed && index + count < buffer.count()
+            ? buffer.xAt(index + count - 1) : qInf();
+
+    if (cancelled())
+        return false;
+
+    // 抽稀
+    if (parameters.buckets > 0) {
+        QVector<QPointF> points = buffer.lod().reducedPoints(buffer, index, count, parameters.buckets,
+                                                                 parameters.columnSpan, parameters.logBaseX);
+        if (!points.isEmpty()) {
+            if (parameters.logarithmic) {
+                const qreal log10BaseX = parameters.logBaseX > 0 ? std::log10(parameters.logBaseX) : 1;
+                const qreal log10BaseY = parameters.logBaseY > 0 ? std::log10(parameters.logBaseY) : 1;
+                for (int i = 0; i < points.count(); i++) {
+                    points[i] = XYSeriesLogCache::logPoint(points.at(i), parameters.logBaseX, log10BaseX,
+                                                           parameters.logBaseY, log10BaseY);
+                }
+            }
+            parameters.transform.mapPoints(points.constData(), points.count(), points.data());
+            result.windowed = true;
+            result.reduced = true;
+            result.points = points;
+            return !cancelled();
+        }
+    }
+
+    // 逐点换算
+    const QPointF *logPoints = parameters.logarithmic
+            ? buffer.logPoints(parameters.logBaseX, parameters.logBaseY) : 0;
+    if (cancelled())
+        return false;
+
+    result.points.resize(count);
+    QPointF *output = result.points.data();
+    const DomainTransform &transform = parameters.transform;
+    XYGeometryWorkers::run(count, XYGeometryWorkers::ChunkSize, [&](int offset, int n) {
+        if (cancelled())
+            return;
+        const int first = index + offset;
+        if (logPoints) {
+            transform.mapPoints(logPoints + first, n, output + offset);
+            return;
+        }
+        switch (buffer.layout()) {
+        case QXYSeries::StorageLayoutColumns: // 列布局直接换算x、y列
+            transform.mapColumns(buffer.xData() + first, buffer.yData() + first, n, output + offset);
+            break;
+        case QXYSeries::StorageLayoutUniformX: // 均匀采样布局只需换算y列
+            transform.mapUniform(buffer.xAt(0), buffer.samplingInterval(), first,
+                                 buffer.yData() + first, n, output + offset);
+            break;
+        default:
+            transform.mapPoints(buffer.constData() + first, n, output + offset);
+            break;
+        }
+    });
+
+    return !cancelled();
+}
+
+QT_CHARTS_END_NAMESPACE
@@ -0,0 +1,129 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef XYGEOMETRYJOB_P_H
+#define XYGEOMETRYJOB_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <private/xyseriesbuffer_p.h>
+#include <private/domaintransform_p.h>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 几何换算参数，直角坐标区域在换算时刻的状态
+struct XYGeometryParameters
+{
+    DomainTransform transform; // 区域（对数轴上为对数坐标）到几何坐标的线性变换
+    bool logarithmic; // 是否有对数轴
+    qreal logBaseX; // x对数轴的底，线性轴为0
+    qreal logBaseY; // y对数轴的底，线性轴为0
+    qreal minX; // 区域最小x
+    qreal maxX; // 区域最大x
+    bool windowing; // 是否只换算可见窗口
+    int buckets; // 抽稀时的像素列数，0表示不抽稀
+    qreal columnSpan; // 一个像素列的x跨度，对数x轴上为对数坐标的跨度
+};
+
+// 几何换算结果
+struct XYGeometryResult
+{
+    QVector<QPointF> points; // 几何点集
+    int firstIndex; // 首个几何点对应的序列点索引
+    bool windowed; // 几何点集是否只包含可见窗口
+    bool reduced; // 几何点集是否由最值金字塔抽稀
+    qreal coveredMinX; // 已换算的最小x
+    qreal coveredMaxX; // 已换算的最大x
+    DomainTransform transform; // 换算时的线性变换
+    XYSeriesBuffer snapshot; // 换算使用的点缓冲快照，其中构建的缓存可交还序列
+};
+
+// 几何换算的后缓冲，由图表项和后台任务共享
+// 任务完成后把结果写入后缓冲，以排队调用通知接收者的 handleGeometryReady() 槽，接收者在
+// 自己的线程中取出结果换入前缓冲。接收者改为同步换算或者析构时递增修订号，取消正在进行的
+// 任务：任务在各阶段之间检查修订号，提前结束，已完成的结果被丢弃。
+class QT_CHARTS_PRIVATE_EXPORT XYGeometryBackBuffer
+{
+public:
+    explicit XYGeometryBackBuffer(QObject *receiver); // 构造
+
+    int revision() const { return m_revision.load(); } // 当前修订号
+    bool isCurrent(int revision) const { return m_revision.load() == revision; } // 修订是否未被取消
+    void cancel(); // 取消正在进行的换算
+    void publish(int revision, const XYGeometryResult &result); // 写入结果并通知接收者
+    bool take(XYGeometryResult &result); // 取出未被取消的结果
+    void detach(); // 接收者析构前断开
+
+private:
+    QAtomicInt m_revision; // 当前修订号
+    QMutex m_mutex; // 保护以下成员
+    QObject *m_receiver; // 接收者
+    XYGeometryResult m_result; // 结果
+    int m_resultRevision; // 结果的修订号，-1表示没有结果
+};
+
+// 几何换算任务
+// 在线程池中对点缓冲快照换算可见窗口的几何点集，不访问序列和区域对象，
+// 因此数据和区域可以在换算期间继续变化，变化由接收者随后发起的任务换算。
+class QT_CHARTS_PRIVATE_EXPORT XYGeometryJob : public QRunnable
+{
+public:
+    XYGeometryJob(const QSharedPointer<XYGeometryBackBuffer> &backBuffer, int revision,
+                  const XYSeriesBuffer &buffer, const XYGeometryParameters &parameters); // 构造
+
+    void run(); // 执行
+
+    static bool calculate(const XYSeriesBuffer &buffer, const XYGeometryParameters &parameters,
+                          XYGeometryResult &result, const XYGeometryBackBuffer *backBuffer = 0,
+                          int revision = 0); // 换算几何点集，被取消时返回false
+
+private:
+    QSharedPointer<XYGeometryBackBuffer> m_backBuffer; // 后缓冲
+    int m_revision; // 修订号
+    XYSeriesBuffer m_buffer; // 点缓冲快照
+    XYGeometryParameters m_parameters; // 换算参数
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // XYGEOMETRYJOB_P_H
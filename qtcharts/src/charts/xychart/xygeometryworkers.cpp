@@ -0,0 +1,121 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/xygeometryworkers_p.h>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
+#include <QtCore/QWaitCondition>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+namespace {
+
+// 一次分块执行的共享状态，工作线程可能在 run() 返回后才开始，因此由共享指针持有
+struct Job
+{
+    std::function<void(int, int)> work; // 块处理函数
+    int count; // 总数
+    int chunkSize; // 每块大小
+    int chunkCount; // 块数
+    QAtomicInt next; // 下一个待领取的块
+    QAtomicInt remaining; // 未完成的块数
+    QMutex mutex; // 完成通知的互斥量
+    QWaitCondition finished; // 完成通知
+
+    // 领取并执行块，直到没有剩余的块
+    void runChunks()
+    {
+        int chunk;
+        while ((chunk = next.fetchAndAddOrdered(1)) < chunkCount) {
+            const int index = chunk * chunkSize;
+            work(index, qMin(chunkSize, count - index));
+            if (remaining.fetchAndAddOrdered(-1) == 1) {
+                QMutexLocker locker(&mutex);
+                finished.wakeAll();
+            }
+        }
+    }
+};
+
+// 线程池中的工作任务
+class Worker : public QRunnable
+{
+public:
+    explicit Worker(const QSharedPointer<Job> &job) : m_job(job) {}
+    void run() { m_job->runChunks(); }
+
+private:
+    QSharedPointer<Job> m_job;
+};
+
+} // namespace
+
+// 是否值得并行：至少两块，且线程池有多个线程
+bool XYGeometryWorkers::isParallel(int count, int chunkSize)
+{
+    return count > chunkSize && QThreadPool::globalInstance()->maxThreadCount() > 1;
+}
+
+// 分块执行
+void XYGeometryWorkers::run(int count, int chunkSize, const std::function<void(int, int)> &work)
+{
+    if (count <= 0)
+        return;
+
+    chunkSize = qMax(1, chunkSize);
+    if (!isParallel(count, chunkSize)) {
+        work(0, count);
+        return;
+    }
+
+    QSharedPointer<Job> job = QSharedPointer<Job>::create();
+    job->work = work;
+    job->count = count;
+    job->chunkSize = chunkSize;
+    job->chunkCount = (count + chunkSize - 1) / chunkSize;
+    job->next.store(0);
+    job->remaining.store(job->chunkCount);
+
+    // 调用线程也领取块，因此只需 chunkCount - 1 个工作线程
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int helpers = qMin(job->chunkCount - 1, pool->maxThreadCount());
+    for (int i = 0; i < helpers; i++)
+        pool->start(new Worker(job));
+
+    job->runChunks();
+
+    QMutexLocker locker(&job->mutex);
+    while (job->remaining.load() > 0)
+        job->finished.wait(&job->mutex);
+}
+
+QT_CHARTS_END_NAMESPACE
@@ -0,0 +1,64 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef XYGEOMETRYWORKERS_P_H
+#define XYGEOMETRYWORKERS_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <functional>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 几何计算的并行执行
+// 把 [0, count) 按 chunkSize 分块，由全局线程池中的线程和调用线程共同领取执行，
+// 全部块完成后 run() 才返回。块由调用线程和工作线程按序领取，线程池繁忙时调用线程独自
+// 完成全部块，因此在线程池线程中调用也不会死锁。work 需可并发调用，且各块只写入自己的区间。
+class QT_CHARTS_PRIVATE_EXPORT XYGeometryWorkers
+{
+public:
+    enum { ChunkSize = 16384 }; // 默认每块的点数
+
+    static bool isParallel(int count, int chunkSize = ChunkSize); // 是否值得并行
+    static void run(int count, int chunkSize,
+                    const std::function<void(int index, int count)> &work); // 分块执行
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // XYGEOMETRYWORKERS_P_H
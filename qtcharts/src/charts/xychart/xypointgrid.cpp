@@ -0,0 +1,164 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/xypointgrid_p.h>
+#include <private/charthelpers_p.h>
+#include <QtCore/QtMath>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 构造
+XYPointGrid::XYPointGrid()
+    : m_cellSize(1), // 单元边长
+      m_columns(0), // 列数
+      m_rows(0) // 行数
+{
+}
+
+// 清空
+void XYPointGrid::clear()
+{
+    m_area = QRectF();
+    m_columns = 0;
+    m_rows = 0;
+    m_cellStart.clear();
+    m_indices.clear();
+}
+
+// 点所在的单元，区域外或断点返回-1
+int XYPointGrid::cellOf(const QPointF &point) const
+{
+    if (isGapPoint(point) || !m_area.contains(point))
+        return -1;
+    const int column = qMin(int((point.x() - m_area.left()) / m_cellSize), m_columns - 1);
+    const int row = qMin(int((point.y() - m_area.top()) / m_cellSize), m_rows - 1);
+    return row * m_columns + column;
+}
+
+// 构建
+void XYPointGrid::build(const QVector<QPointF> &points, const QRectF &area, qreal cellSize)
+{
+    reset(area, cellSize);
+    if (points.isEmpty() || m_area.isEmpty())
+        return;
+
+    QVector<int> cells(points.size());
+    for (int i = 0; i < points.size(); i++)
+        cells[i] = cellOf(points.at(i));
+    fill(cells);
+}
+
+// 清空并设置区域和单元边长，单元数超过上限时放大单元
+void XYPointGrid::reset(const QRectF &area, qreal cellSize)
+{
+    clear();
+    if (area.isEmpty())
+        return;
+
+    m_area = area;
+    m_cellSize = qMax(cellSize, qreal(1));
+    while ((area.width() / m_cellSize + 1) * (area.height() / m_cellSize + 1) > MaxCells)
+        m_cellSize *= 2;
+    m_columns = int(area.width() / m_cellSize) + 1;
+    m_rows = int(area.height() / m_cellSize) + 1;
+}
+
+// 先统计各单元的点数得到起始位置，再按单元放置点索引，单元为-1的点不入网格
+void XYPointGrid::fill(const QVector<int> &cells)
+{
+    m_indices.clear();
+    if (m_area.isEmpty())
+        return;
+
+    m_cellStart.fill(0, m_columns * m_rows + 1);
+    for (int i = 0; i < cells.size(); i++) {
+        if (cells.at(i) >= 0)
+            m_cellStart[cells.at(i) + 1]++;
+    }
+    for (int cell = 0; cell < m_columns * m_rows; cell++)
+        m_cellStart[cell + 1] += m_cellStart.at(cell);
+
+    QVector<int> next = m_cellStart;
+    m_indices.resize(m_cellStart.last());
+    for (int i = 0; i < cells.size(); i++) {
+        if (cells.at(i) >= 0)
+            m_indices[next[cells.at(i)]++] = i;
+    }
+}
+
+// 把与矩形相交的单元中的点索引追加到result，同一单元内的索引递增
+void XYPointGrid::query(const QRectF &rect, QVector<int> &result) const
+{
+    if (m_indices.isEmpty())
+        return;
+
+    const int left = qMax(qFloor((rect.left() - m_area.left()) / m_cellSize), 0);
+    const int right = qMin(qFloor((rect.right() - m_area.left()) / m_cellSize), m_columns - 1);
+    const int top = qMax(qFloor((rect.top() - m_area.top()) / m_cellSize), 0);
+    const int bottom = qMin(qFloor((rect.bottom() - m_area.top()) / m_cellSize), m_rows - 1);
+    for (int row = top; row <= bottom; row++) {
+        for (int column = left; column <= right; column++)
+            appendCell(column, row, result);
+    }
+}
+
+// 把与center所在单元的行、列距离最大值恰为ring的单元中的点索引追加到result
+// 按ring从0递增查询即由近及远遍历网格，center可以在区域外。
+void XYPointGrid::queryRing(const QPointF &center, int ring, QVector<int> &result) const
+{
+    if (m_indices.isEmpty() || ring < 0)
+        return;
+
+    const int column = qFloor((center.x() - m_area.left()) / m_cellSize);
+    const int row = qFloor((center.y() - m_area.top()) / m_cellSize);
+    if (ring == 0) {
+        appendCell(column, row, result);
+        return;
+    }
+    for (int c = column - ring; c <= column + ring; c++) {
+        appendCell(c, row - ring, result);
+        appendCell(c, row + ring, result);
+    }
+    for (int r = row - ring + 1; r <= row + ring - 1; r++) {
+        appendCell(column - ring, r, result);
+        appendCell(column + ring, r, result);
+    }
+}
+
+// 把单元中的点索引追加到result，网格外的单元忽略
+void XYPointGrid::appendCell(int column, int row, QVector<int> &result) const
+{
+    if (column < 0 || column >= m_columns || row < 0 || row >= m_rows)
+        return;
+    const int cell = row * m_columns + column;
+    for (int i = m_cellStart.at(cell); i < m_cellStart.at(cell + 1); i++)
+        result.append(m_indices.at(i));
+}
+
+QT_CHARTS_END_NAMESPACE
@@ -0,0 +1,84 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef XYPOINTGRID_P_H
+#define XYPOINTGRID_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <QtCore/QVector>
+#include <QtCore/QPointF>
+#include <QtCore/QRectF>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 几何点集的均匀网格索引
+// 把区域内的点按所在单元做计数排序，每个单元的点索引连续存放，每点只占一个索引。
+// 查询时只遍历与矩形相交的单元，用于按位置查找点（命中检测等）。区域外的点和断点不入网格。
+class QT_CHARTS_PRIVATE_EXPORT XYPointGrid
+{
+public:
+    XYPointGrid(); // 构造
+
+    void clear(); // 清空
+    void build(const QVector<QPointF> &points, const QRectF &area, qreal cellSize); // 构建
+    void reset(const QRectF &area, qreal cellSize); // 清空并设置区域和单元边长，之后可由 cellOf() 和 fill() 分步构建
+    void fill(const QVector<int> &cells); // 按各点所在的单元放置点索引，cells[i]为第i个点的单元
+    int cellOf(const QPointF &point) const; // 点所在的单元，区域外或断点返回-1
+    QRectF area() const { return m_area; } // 获取区域
+    qreal cellSize() const { return m_cellSize; } // 获取单元边长
+    bool isEmpty() const { return m_indices.isEmpty(); } // 是否没有点
+    void query(const QRectF &rect, QVector<int> &result) const; // 把与矩形相交的单元中的点索引追加到result
+    void queryRing(const QPointF &center, int ring, QVector<int> &result) const; // 把与center所在单元相距ring个单元的一圈单元中的点索引追加到result
+
+private:
+    enum { MaxCells = 1 << 20 }; // 单元数上限，超过时放大单元
+
+    void appendCell(int column, int row, QVector<int> &result) const; // 把单元中的点索引追加到result
+
+    QRectF m_area; // 区域
+    qreal m_cellSize; // 单元边长
+    int m_columns; // 列数
+    int m_rows; // 行数
+    QVector<int> m_cellStart; // 各单元的点索引在 m_indices 中的起始位置，末尾为点索引总数
+    QVector<int> m_indices; // 按单元排列的点索引
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // XYPOINTGRID_P_H
@@ -0,0 +1,257 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <private/xypointindex_p.h>
+#include <private/qxyseries_p.h>
+#include <private/abstractdomain_p.h>
+#include <private/xygeometryworkers_p.h>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QtMath>
+#include <algorithm>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 复用网格时相对建立网格时允许的最大缩放，超过后单元相对像素过大或过小
+static const qreal MaxIndexScale = 2.0;
+
+// 构造
+XYPointIndex::XYPointIndex()
+    : m_valid(false), // 网格是否有效
+      m_revision(0), // 序列修订号
+      m_count(0), // 点数
+      m_domain(0), // 区域
+      m_linear(false), // 区域是否为线性
+      m_logBaseX(0), // x轴对数的底
+      m_logBaseY(0), // y轴对数的底
+      m_minX(0), // 最小x
+      m_maxX(0), // 最大x
+      m_minY(0), // 最小y
+      m_maxY(0), // 最大y
+      m_reverseX(false), // 是否逆向x
+      m_reverseY(false) // 是否逆向y
+{
+}
+
+// 清空
+void XYPointIndex::clear()
+{
+    m_grid.clear();
+    m_candidates.clear();
+    m_valid = false;
+    m_domain = 0;
+}
+
+// 网格是否仍对应序列和区域，线性区域的范围变化由 prepare() 以变换处理
+bool XYPointIndex::matches(const QXYSeriesPrivate *series, const AbstractDomain *domain) const
+{
+    const XYSeriesBuffer &buffer = series->pointBuffer();
+    if (!m_valid || buffer.revision() != m_revision || buffer.count() != m_count
+            || domain != m_domain || domain->size() != m_size) {
+        return false;
+    }
+
+    qreal logBaseX = 0;
+    qreal logBaseY = 0;
+    domain->logBases(logBaseX, logBaseY);
+    if (logBaseX != m_logBaseX || logBaseY != m_logBaseY)
+        return false;
+
+    if (m_linear)
+        return true;
+    return domain->minX() == m_minX && domain->maxX() == m_maxX
+            && domain->minY() == m_minY && domain->maxY() == m_maxY
+            && domain->isReverseX() == m_reverseX && domain->isReverseY() == m_reverseY;
+}
+
+// 必要时重建网格，并求当前几何坐标到网格几何坐标的变换
+// 线性区域上当前绘图区域仍在网格区域内且缩放不多时复用网格。
+bool XYPointIndex::prepare(const QXYSeriesPrivate *series, const AbstractDomain *domain)
+{
+    if (domain->size().isEmpty())
+        return false;
+
+    if (matches(series, domain)) {
+        if (!m_linear)
+            return true;
+
+        DomainTransform current;
+        if (domain->geometryTransform(current)) {
+            m_toGrid = m_transform.transformFrom(current);
+            const qreal scaleX = qAbs(m_toGrid.m11());
+            const qreal scaleY = qAbs(m_toGrid.m22());
+            const QRectF plotArea = m_toGrid.mapRect(QRectF(QPointF(0, 0), domain->size()));
+            if (scaleX >= 1 / MaxIndexScale && scaleX <= MaxIndexScale
+                    && scaleY >= 1 / MaxIndexScale && scaleY <= MaxIndexScale
+                    && m_grid.area().contains(plotArea)) {
+                return true;
+            }
+        }
+    }
+    return build(series, domain);
+}
+
+// 建立网格
+// 网格区域在绘图区域四周各扩展一个绘图区域的大小，以便交互平移后仍可复用。点数较多时分块并行
+// 换算几何位置和所在单元，不保存整个序列的几何点集。
+bool XYPointIndex::build(const QXYSeriesPrivate *series, const AbstractDomain *domain)
+{
+    clear();
+    const XYSeriesBuffer &buffer = series->pointBuffer();
+    const QSizeF size = domain->size();
+    m_grid.reset(QRectF(-size.width(), -size.height(), 3 * size.width(), 3 * size.height()),
+                 CellSize);
+
+    const int count = buffer.count();
+    QVector<int> cells(count);
+    int *cellData = cells.data();
+    QAtomicInt failed(0);
+    auto work = [&](int index, int chunkCount) {
+        QVector<QPointF> block(chunkCount);
+        if (!series->calculateGeometryPoints(domain, index, chunkCount, block.data())) {
+            failed.storeRelease(1);
+            return;
+        }
+        for (int i = 0; i < chunkCount; i++)
+            cellData[index + i] = m_grid.cellOf(block.at(i));
+    };
+    if (XYGeometryWorkers::isParallel(count)) {
+        // 先在本线程换算一个点，建立各块共享的缓存（如点集的对数）
+        QPointF point;
+        if (series->calculateGeometryPoints(domain, 0, 1, &point))
+            XYGeometryWorkers::run(count, XYGeometryWorkers::ChunkSize, work);
+        else
+            failed.storeRelease(1);
+    } else if (count > 0) {
+        work(0, count);
+    }
+    if (failed.loadAcquire()) {
+        clear();
+        return false;
+    }
+    m_grid.fill(cells);
+
+    m_valid = true;
+    m_revision = buffer.revision();
+    m_count = count;
+    m_domain = domain;
+    m_size = size;
+    m_logBaseX = 0;
+    m_logBaseY = 0;
+    domain->logBases(m_logBaseX, m_logBaseY);
+    m_linear = domain->geometryTransform(m_transform);
+    m_minX = domain->minX();
+    m_maxX = domain->maxX();
+    m_minY = domain->minY();
+    m_maxY = domain->maxY();
+    m_reverseX = domain->isReverseX();
+    m_reverseY = domain->isReverseY();
+    m_toGrid.reset();
+    return true;
+}
+
+// 换算单个点的几何位置，绘图区域外或无法换算时返回false
+// 对数轴上的非正值换算为NaN断点，不在绘图区域内
+bool XYPointIndex::geometryPoint(const QXYSeriesPrivate *series, const AbstractDomain *domain,
+                                 int index, QPointF &point) const
+{
+    const bool ok = series->calculateGeometryPoints(domain, index, 1, &point);
+    const QSizeF size = domain->size();
+    return ok && point.x() >= 0 && point.x() <= size.width()
+            && point.y() >= 0 && point.y() <= size.height();
+}
+
+// 查找离几何位置最近且不超过maxDistance的点，距离相同时取索引较小者，没有时返回-1
+// 由近及远逐圈查询网格单元；一圈查完后，未查到的点在网格坐标中至少相距ring个单元，
+// 折算到当前几何坐标后若已不小于找到的距离或maxDistance即可停止。
+int XYPointIndex::nearest(const QXYSeriesPrivate *series, const AbstractDomain *domain,
+                          const QPointF &position, qreal maxDistance)
+{
+    if (maxDistance < 0 || !prepare(series, domain) || m_grid.isEmpty())
+        return -1;
+
+    const QPointF center = m_toGrid.map(position);
+    const qreal scale = qMax(qAbs(m_toGrid.m11()), qAbs(m_toGrid.m22()));
+    const qreal cellDistance = m_grid.cellSize() / scale;
+    // 超过maxDistance或覆盖整个网格后不再向外查询
+    const QRectF area = m_grid.area();
+    const qreal farthest = qMax(qMax(qAbs(center.x() - area.left()), qAbs(center.x() - area.right())),
+                                qMax(qAbs(center.y() - area.top()), qAbs(center.y() - area.bottom())));
+    const int maxRing = qCeil(qMin(maxDistance / cellDistance, farthest / m_grid.cellSize())) + 1;
+
+    int nearestIndex = -1;
+    qreal nearestDistance = maxDistance * maxDistance;
+    for (int ring = 0; ring <= maxRing; ring++) {
+        m_candidates.clear();
+        m_grid.queryRing(center, ring, m_candidates);
+        for (int i = 0; i < m_candidates.size(); i++) {
+            const int index = m_candidates.at(i);
+            QPointF point;
+            if (!geometryPoint(series, domain, index, point))
+                continue;
+            const qreal dx = point.x() - position.x();
+            const qreal dy = point.y() - position.y();
+            const qreal distance = dx * dx + dy * dy;
+            if (distance < nearestDistance
+                    || (distance == nearestDistance && (nearestIndex < 0 || index < nearestIndex))) {
+                nearestIndex = index;
+                nearestDistance = distance;
+            }
+        }
+        const qreal reached = ring * cellDistance;
+        if (reached * reached >= nearestDistance)
+            break;
+    }
+    return nearestIndex;
+}
+
+// 查找几何矩形内的点，索引递增
+QVector<int> XYPointIndex::pointsIn(const QXYSeriesPrivate *series, const AbstractDomain *domain,
+                                    const QRectF &rect)
+{
+    QVector<int> result;
+    const QRectF normalized = rect.normalized();
+    if (!prepare(series, domain) || m_grid.isEmpty())
+        return result;
+
+    m_candidates.clear();
+    m_grid.query(m_toGrid.mapRect(normalized), m_candidates);
+    for (int i = 0; i < m_candidates.size(); i++) {
+        QPointF point;
+        if (geometryPoint(series, domain, m_candidates.at(i), point)
+                && point.x() >= normalized.left() && point.x() <= normalized.right()
+                && point.y() >= normalized.top() && point.y() <= normalized.bottom()) {
+            result.append(m_candidates.at(i));
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+QT_CHARTS_END_NAMESPACE
@@ -0,0 +1,101 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef XYPOINTINDEX_P_H
+#define XYPOINTINDEX_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <private/xypointgrid_p.h>
+#include <private/domaintransform_p.h>
+#include <QtCore/QVector>
+#include <QtCore/QSizeF>
+#include <QtGui/QTransform>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+class QXYSeriesPrivate;
+class AbstractDomain;
+
+// 序列点集的几何位置索引
+// 按需把整个序列换算为几何点并建立均匀网格，只保存按单元排列的点索引，候选点的几何位置在查询时
+// 逐点换算。序列修改或区域变化后下次查询时重建；线性区域上平移、缩放不多时把查询位置变换到
+// 建立网格时的几何坐标中复用网格，因此交互时也不必每次重建。只查找绘图区域内的点。
+class QT_CHARTS_PRIVATE_EXPORT XYPointIndex
+{
+public:
+    XYPointIndex(); // 构造
+
+    void clear(); // 清空
+    int nearest(const QXYSeriesPrivate *series, const AbstractDomain *domain,
+                const QPointF &position, qreal maxDistance); // 查找离几何位置最近且不超过maxDistance的点，没有时返回-1
+    QVector<int> pointsIn(const QXYSeriesPrivate *series, const AbstractDomain *domain,
+                          const QRectF &rect); // 查找几何矩形内的点，索引递增
+
+private:
+    enum { CellSize = 8 }; // 单元边长（像素）
+
+    bool prepare(const QXYSeriesPrivate *series, const AbstractDomain *domain); // 必要时重建网格，并求当前几何坐标到网格几何坐标的变换
+    bool build(const QXYSeriesPrivate *series, const AbstractDomain *domain); // 建立网格
+    bool matches(const QXYSeriesPrivate *series, const AbstractDomain *domain) const; // 网格是否仍对应序列和区域（线性区域不比较范围）
+    bool geometryPoint(const QXYSeriesPrivate *series, const AbstractDomain *domain, int index,
+                       QPointF &point) const; // 换算单个点的几何位置，区域外或无法换算时返回false
+
+    XYPointGrid m_grid; // 网格
+    bool m_valid; // 网格是否有效
+    uint m_revision; // 建立网格时的序列修订号
+    int m_count; // 建立网格时的点数
+    const AbstractDomain *m_domain; // 建立网格时的区域
+    QSizeF m_size; // 建立网格时的区域尺寸
+    bool m_linear; // 建立网格时区域是否为线性
+    DomainTransform m_transform; // 线性区域建立网格时的变换
+    qreal m_logBaseX; // 建立网格时x轴对数的底
+    qreal m_logBaseY; // 建立网格时y轴对数的底
+    qreal m_minX; // 建立网格时的最小x
+    qreal m_maxX; // 建立网格时的最大x
+    qreal m_minY; // 建立网格时的最小y
+    qreal m_maxY; // 建立网格时的最大y
+    bool m_reverseX; // 建立网格时是否逆向x
+    bool m_reverseY; // 建立网格时是否逆向y
+    QTransform m_toGrid; // 当前几何坐标到网格几何坐标的变换
+    QVector<int> m_candidates; // 查询的候选点索引，重复使用以免分配内存
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // XYPOINTINDEX_P_H
@@ -0,0 +1,194 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/xypointlabels_p.h>
+#include <private/xyseriesbuffer_p.h>
+#include <private/chartpresenter_p.h>
+#include <private/charthelpers_p.h>
+#include <QtGui/QPainter>
+#include <QtGui/QFontMetrics>
+#include <QtCore/QtMath>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 格式标记字符串
+static const QLatin1String xPointTag("@xPoint");
+static const QLatin1String yPointTag("@yPoint");
+
+// 构造
+XYPointLabels::XYPointLabels()
+    : m_maxWidth(0), // 最大宽度
+      m_revision(0), // 点集修订号
+      m_localizeNumbers(false), // 数字本地化设置
+      m_valid(false) // 是否有效
+{
+}
+
+// 失效
+void XYPointLabels::invalidate()
+{
+    m_labels.clear();
+    m_maxWidth = 0;
+    m_valid = false;
+}
+
+// 数据或设置改变时清空缓存。最大宽度以最长数字的样例标签作为初值，用于在生成标签之前
+// 估计可见区域外的点的标签能否伸入可见区域。样例数字的指数取三位，各位换成字体中最宽的数字，
+// 使任何标签都不宽于样例，可见区域外标签可能伸入的点不会被提前剔除
+void XYPointLabels::validate(ChartPresenter *presenter, const XYSeriesBuffer &buffer,
+                             const QString &format, const QFont &font,
+                             const QFontMetrics &metrics)
+{
+    if (m_valid && m_revision == buffer.revision() && m_format == format && m_font == font
+            && m_localizeNumbers == presenter->localizeNumbers()
+            && m_locale == presenter->locale()) {
+        if (m_labels.size() > MaxCachedLabels)
+            m_labels.clear();
+        return;
+    }
+
+    invalidate();
+    m_revision = buffer.revision();
+    m_format = format;
+    m_font = font;
+    m_localizeNumbers = presenter->localizeNumbers();
+    m_locale = presenter->locale();
+    m_valid = true;
+
+    const QChar zero = m_localizeNumbers ? m_locale.zeroDigit() : QLatin1Char('0');
+    QChar widestDigit = zero;
+    for (int digit = 1; digit < 10; digit++) {
+        const QChar c(zero.unicode() + digit);
+        if (metrics.width(c) > metrics.width(widestDigit))
+            widestDigit = c;
+    }
+    QString widest = presenter->numberToString(-8.88888e+288);
+    for (int i = 0; i < widest.size(); i++) {
+        if (widest.at(i).isDigit())
+            widest[i] = widestDigit;
+    }
+    QString sample = format;
+    sample.replace(xPointTag, widest);
+    sample.replace(yPointTag, widest);
+    m_maxWidth = metrics.width(sample);
+}
+
+// 获取标签，未缓存时格式化并测量宽度。返回的引用在下次生成标签前有效
+const XYPointLabels::Label &XYPointLabels::label(ChartPresenter *presenter,
+                                                 const XYSeriesBuffer &buffer, int index,
+                                                 const QFontMetrics &metrics)
+{
+    QHash<int, Label>::iterator it = m_labels.find(index);
+    if (it == m_labels.end()) {
+        Label label;
+        label.text = m_format;
+        label.text.replace(xPointTag, presenter->numberToString(buffer.xAt(index)));
+        label.text.replace(yPointTag, presenter->numberToString(buffer.yAt(index)));
+        label.width = metrics.width(label.text);
+        m_maxWidth = qMax(m_maxWidth, label.width);
+        it = m_labels.insert(index, label);
+    }
+    return it.value();
+}
+
+// 绘制标签
+// 标签水平居中于点的上方。先按点的位置粗略剔除标签不可能进入可见区域的点，再以标签矩形精确判断；
+// 网格单元与样例标签等大，已放置的标签记录在其覆盖的单元中，新标签只与所在单元中的标签比较。
+void XYPointLabels::draw(QPainter *painter, ChartPresenter *presenter,
+                         const XYSeriesBuffer &buffer, const QVector<QPointF> &points,
+                         int firstIndex, int offset, const QString &format)
+{
+    const QFontMetrics metrics(painter->font());
+    validate(presenter, buffer, format, painter->font(), metrics);
+
+    // 可见区域：剪裁区域，未剪裁时为绘图设备的范围
+    QRectF visible;
+    if (painter->hasClipping()) {
+        visible = painter->clipBoundingRect();
+    } else {
+        const QRectF deviceRect(0, 0, painter->device()->width(), painter->device()->height());
+        visible = painter->combinedTransform().inverted().mapRect(deviceRect);
+    }
+    if (visible.isEmpty())
+        return;
+
+    const int labelOffset = offset + 2;
+    const qreal height = metrics.height();
+    const qreal ascent = metrics.ascent();
+    const qreal cellWidth = qMax(m_maxWidth, 1);
+    const qreal cellHeight = qMax(height, qreal(1));
+    QHash<quint64, QVector<QRectF> > grid;
+
+    // m_points is used for the label here as it has the series point information
+    // points variable passed is used for positioning because it has the coordinates
+    const int pointCount = qMin(points.size(), buffer.count() - firstIndex);
+    for (int i = 0; i < pointCount; i++) {
+        const QPointF &point = points.at(i);
+        // 跳过断点以及标签不可能进入可见区域的点
+        const qreal margin = m_maxWidth / 2 + 1;
+        const qreal rise = labelOffset + ascent;
+        if (isGapPoint(point)
+                || !(point.x() >= visible.left() - margin && point.x() <= visible.right() + margin)
+                || !(point.y() >= visible.top() + rise - height - 1
+                     && point.y() <= visible.bottom() + rise + 1)) {
+            continue;
+        }
+
+        const Label &pointLabel = label(presenter, buffer, firstIndex + i, metrics);
+        const QRectF rect(point.x() - pointLabel.width / 2, point.y() - labelOffset - ascent,
+                          pointLabel.width, height);
+        if (!rect.intersects(visible))
+            continue;
+
+        // 与已放置的标签重叠时跳过
+        const int left = qFloor((rect.left() - visible.left()) / cellWidth);
+        const int right = qFloor((rect.right() - visible.left()) / cellWidth);
+        const int top = qFloor((rect.top() - visible.top()) / cellHeight);
+        const int bottom = qFloor((rect.bottom() - visible.top()) / cellHeight);
+        bool overlaps = false;
+        for (int x = left; x <= right && !overlaps; x++) {
+            for (int y = top; y <= bottom && !overlaps; y++) {
+                const QVector<QRectF> placed = grid.value(quint64(quint32(x)) << 32 | quint32(y));
+                for (int j = 0; j < placed.size() && !overlaps; j++)
+                    overlaps = placed.at(j).intersects(rect);
+            }
+        }
+        if (overlaps)
+            continue;
+        for (int x = left; x <= right; x++) {
+            for (int y = top; y <= bottom; y++)
+                grid[quint64(quint32(x)) << 32 | quint32(y)].append(rect);
+        }
+
+        // Position text in relation to the point
+        painter->drawText(QPointF(rect.left(), point.y() - labelOffset), pointLabel.text);
+    }
+}
+
+QT_CHARTS_END_NAMESPACE
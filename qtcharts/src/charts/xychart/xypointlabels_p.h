@@ -0,0 +1,102 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef XYPOINTLABELS_P_H
+#define XYPOINTLABELS_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <QtCore/QHash>
+#include <QtCore/QLocale>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+#include <QtGui/QFont>
+
+QT_BEGIN_NAMESPACE
+class QPainter;
+class QFontMetrics;
+QT_END_NAMESPACE
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+class ChartPresenter;
+class XYSeriesBuffer;
+
+// 序列点标签层
+// 按点索引缓存格式化后的标签文本及其宽度，点集修订号、标签格式、字体或者数字本地化设置改变时失效。
+// 绘制时只为落在可见区域内的点生成标签，并以均匀网格记录已放置标签的矩形，跳过与之重叠的标签，
+// 因此开销只取决于实际可见的标签数。
+class QT_CHARTS_PRIVATE_EXPORT XYPointLabels
+{
+public:
+    XYPointLabels(); // 构造
+
+    void invalidate(); // 失效
+    void draw(QPainter *painter, ChartPresenter *presenter, const XYSeriesBuffer &buffer,
+              const QVector<QPointF> &points, int firstIndex, int offset,
+              const QString &format); // 绘制标签，points[0] 对应序列中索引为 firstIndex 的点
+    int cachedLabelCount() const { return m_labels.size(); } // 已缓存的标签数
+
+private:
+    struct Label
+    {
+        QString text; // 文本
+        int width; // 宽度
+    };
+
+    enum { MaxCachedLabels = 65536 }; // 缓存的标签数上限，超过时清空
+
+    void validate(ChartPresenter *presenter, const XYSeriesBuffer &buffer, const QString &format,
+                  const QFont &font, const QFontMetrics &metrics); // 数据或设置改变时清空缓存
+    const Label &label(ChartPresenter *presenter, const XYSeriesBuffer &buffer, int index,
+                       const QFontMetrics &metrics); // 获取标签，未缓存时生成
+
+    QHash<int, Label> m_labels; // 已生成的标签，键为序列点索引
+    int m_maxWidth; // 已生成标签及样例标签的最大宽度
+    uint m_revision; // 缓存对应的点集修订号
+    QString m_format; // 缓存对应的标签格式
+    QFont m_font; // 缓存对应的字体
+    bool m_localizeNumbers; // 缓存对应的数字本地化设置
+    QLocale m_locale; // 缓存对应的区域设置
+    bool m_valid; // 是否有效
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // XYPOINTLABELS_P_H
@@ -0,0 +1,549 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/xyseriesbuffer_p.h>
+#include <algorithm>
+#include <cmath>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 构造
+XYSeriesBuffer::XYSeriesBuffer()
+    : m_layout(QXYSeries::StorageLayoutPoints), // 存储布局
+      m_x0(0), // 均匀采样起始x值
+      m_dx(1), // 均匀采样x间隔
+      m_sorted(true), // x值有序
+      m_start(0), // 逻辑起始位置
+      m_count(0), // 点数量
+      m_capacity(0), // 容量
+      m_revision(0) // 修订号
+{
+}
+
+// 设置存储布局
+void XYSeriesBuffer::setLayout(QXYSeries::StorageLayout layout)
+{
+    if (layout == m_layout)
+        return;
+
+    const QVector<QPointF> points = toVector();
+
+    // 切换到均匀采样布局时，由首尾点推算采样参数
+    if (layout == QXYSeries::StorageLayoutUniformX && !points.isEmpty()) {
+        m_x0 = points.first().x();
+        if (points.count() > 1)
+            m_dx = (points.last().x() - m_x0) / (points.count() - 1);
+    }
+
+    m_layout = layout;
+    m_points = QVector<QPointF>();
+    m_x = QVector<qreal>();
+    m_y = QVector<qreal>();
+    if (isBounded())
+        reserveSlots();
+    setPoints(points);
+}
+
+// 获取点
+QPointF XYSeriesBuffer::at(int index) const
+{
+    if (m_layout == QXYSeries::StorageLayoutPoints)
+        return m_points.at(m_start + index);
+    return QPointF(xAt(index), m_y.at(m_start + index));
+}
+
+// 获取点x值
+qreal XYSeriesBuffer::xAt(int index) const
+{
+    if (m_layout == QXYSeries::StorageLayoutPoints)
+        return m_points.at(m_start + index).x();
+    if (m_layout == QXYSeries::StorageLayoutUniformX)
+        return m_x0 + index * m_dx;
+    return m_x.at(m_start + index);
+}
+
+// 获取点y值
+qreal XYSeriesBuffer::yAt(int index) const
+{
+    if (m_layout == QXYSeries::StorageLayoutPoints)
+        return m_points.at(m_start + index).y();
+    return m_y.at(m_start + index);
+}
+
+// 连续点集首地址
+const QPointF *XYSeriesBuffer::constData() const
+{
+    if (m_layout != QXYSeries::StorageLayoutPoints)
+        return 0;
+    return m_points.constData() + m_start;
+}
+
+// 连续x值首地址
+const qreal *XYSeriesBuffer::xData() const
+{
+    if (m_layout != QXYSeries::StorageLayoutColumns)
+        return 0;
+    return m_x.constData() + m_start;
+}
+
+// 连续y值首地址
+const qreal *XYSeriesBuffer::yData() const
+{
+    if (m_layout == QXYSeries::StorageLayoutPoints)
+        return 0;
+    return m_y.constData() + m_start;
+}
+
+// 查找点
+int XYSeriesBuffer::indexOf(const QPointF &point) const
+{
+    if (m_layout == QXYSeries::StorageLayoutPoints) {
+        const QPointF *points = constData();
+        for (int i = 0; i < m_count; i++) {
+            if (points[i] == point)
+                return i;
+        }
+        return -1;
+    }
+
+    // 均匀采样布局，由x值直接算出候选位置
+    if (m_layout == QXYSeries::StorageLayoutUniformX) {
+        if (m_count == 0)
+            return -1;
+        const int index = m_dx != 0 ? qRound((point.x() - m_x0) / m_dx) : 0;
+        if (index < 0 || index >= m_count || !(at(index) == point))
+            return -1;
+        return index;
+    }
+
+    const qreal *x = xData();
+    const qreal *y = yData();
+    for (int i = 0; i < m_count; i++) {
+        if (QPointF(x[i], y[i]) == point)
+            return i;
+    }
+    return -1;
+}
+
+// 获取点集范围
+bool XYSeriesBuffer::extents(qreal &minX, qreal &maxX, qreal &minY, qreal &maxY) const
+{
+    return extents(0, m_count, minX, maxX, minY, maxY);
+}
+
+// 获取区间范围
+// 由最值金字塔合并得出，首次查询后随追加、替换和头尾移除增量维护，不再逐点扫描
+bool XYSeriesBuffer::extents(int index, int count,
+                             qreal &minX, qreal &maxX, qreal &minY, qreal &maxY) const
+{
+    return m_lod.extents(*this, index, count, minX, maxX, minY, maxY);
+}
+
+// x值是否单调不减
+bool XYSeriesBuffer::isSorted() const
+{
+    if (m_layout == QXYSeries::StorageLayoutUniformX)
+        return m_dx >= 0;
+    return m_sorted;
+}
+
+// 首个x值不小于x的点索引
+int XYSeriesBuffer::lowerBound(qreal x) const
+{
+    // 均匀采样布局，由采样参数算出位置后修正舍入误差
+    if (m_layout == QXYSeries::StorageLayoutUniformX) {
+        if (m_dx == 0)
+            return x <= m_x0 ? 0 : m_count;
+        int index = int(qBound(qreal(0), std::ceil((x - m_x0) / m_dx), qreal(m_count)));
+        while (index > 0 && xAt(index - 1) >= x)
+            index--;
+        while (index < m_count && xAt(index) < x)
+            index++;
+        return index;
+    }
+
+    // 列布局，二分查找x列
+    if (m_layout == QXYSeries::StorageLayoutColumns)
+        return std::lower_bound(xData(), xData() + m_count, x) - xData();
+
+    // 点布局，按x值二分查找
+    return std::lower_bound(constData(), constData() + m_count, x,
+                            [](const QPointF &point, qreal value) { return point.x() < value; })
+            - constData();
+}
+
+// 首个x值大于x的点索引
+int XYSeriesBuffer::upperBound(qreal x) const
+{
+    // 均匀采样布局，由采样参数算出位置后修正舍入误差
+    if (m_layout == QXYSeries::StorageLayoutUniformX) {
+        if (m_dx == 0)
+            return x < m_x0 ? 0 : m_count;
+        int index = int(qBound(qreal(0), std::floor((x - m_x0) / m_dx) + 1, qreal(m_count)));
+        while (index > 0 && xAt(index - 1) > x)
+            index--;
+        while (index < m_count && xAt(index) <= x)
+            index++;
+        return index;
+    }
+
+    // 列布局，二分查找x列
+    if (m_layout == QXYSeries::StorageLayoutColumns)
+        return std::upper_bound(xData(), xData() + m_count, x) - xData();
+
+    // 点布局，按x值二分查找
+    return std::upper_bound(constData(), constData() + m_count, x,
+                            [](qreal value, const QPointF &point) { return value < point.x(); })
+            - constData();
+}
+
+// 接收快照中构建的缓存
+// 快照与当前点集为同一修订时，快照中构建或更新的最值金字塔和对数坐标缓存同样适用于当前点集。
+void XYSeriesBuffer::adoptCaches(const XYSeriesBuffer &snapshot)
+{
+    if (snapshot.m_revision != m_revision)
+        return;
+    m_lod = snapshot.m_lod;
+    m_logCache = snapshot.m_logCache;
+}
+
+// 获取点集
+QVector<QPointF> XYSeriesBuffer::toVector() const
+{
+    // 无容量限制的点布局直接共享存储
+    if (m_layout == QXYSeries::StorageLayoutPoints && !isBounded())
+        return m_points;
+    return mid(0);
+}
+
+// 获取部分点集
+QVector<QPointF> XYSeriesBuffer::mid(int index, int length) const
+{
+    if (m_layout == QXYSeries::StorageLayoutPoints && !isBounded())
+        return m_points.mid(index, length);
+
+    if (length < 0 || index + length > m_count)
+        length = m_count - index;
+    if (index < 0 || length <= 0)
+        return QVector<QPointF>();
+
+    QVector<QPointF> result(length);
+    if (m_layout == QXYSeries::StorageLayoutPoints) {
+        std::copy(constData() + index, constData() + index + length, result.begin());
+    } else if (m_layout == QXYSeries::StorageLayoutColumns) {
+        const qreal *x = xData() + index;
+        const qreal *y = yData() + index;
+        QPointF *points = result.data();
+        for (int i = 0; i < length; i++)
+            points[i] = QPointF(x[i], y[i]);
+    } else {
+        const qreal *y = yData() + index;
+        QPointF *points = result.data();
+        for (int i = 0; i < length; i++)
+            points[i] = QPointF(m_x0 + (index + i) * m_dx, y[i]);
+    }
+    return result;
+}
+
+// 设置点集
+void XYSeriesBuffer::setPoints(const QVector<QPointF> &points)
+{
+    m_revision++;
+    m_start = 0;
+    m_lod.invalidate();
+    m_logCache.invalidate();
+
+    // 检查保留的点是否按x值有序
+    const int first = isBounded() ? qMax(0, points.count() - m_capacity) : 0;
+    m_sorted = true;
+    if (m_layout != QXYSeries::StorageLayoutUniformX) {
+        for (int i = first + 1; i < points.count() && m_sorted; i++)
+            m_sorted = points.at(i - 1).x() <= points.at(i).x();
+    }
+
+    // 无容量限制
+    if (!isBounded()) {
+        m_count = points.count();
+        if (m_layout == QXYSeries::StorageLayoutPoints) {
+            m_points = points;
+        } else {
+            // 均匀采样布局只保存y值，x值由采样参数决定
+            if (m_layout == QXYSeries::StorageLayoutColumns)
+                m_x.resize(m_count);
+            m_y.resize(m_count);
+            qreal *x = m_x.data();
+            qreal *y = m_y.data();
+            for (int i = 0; i < m_count; i++) {
+                if (m_layout == QXYSeries::StorageLayoutColumns)
+                    x[i] = points.at(i).x();
+                y[i] = points.at(i).y();
+            }
+        }
+        return;
+    }
+
+    // 只保留最新的 capacity 个点
+    advanceOrigin(first);
+    m_count = points.count() - first;
+    for (int i = 0; i < m_count; i++)
+        write(i, points.at(first + i));
+}
+
+// 追加点
+bool XYSeriesBuffer::append(const QPointF &point)
+{
+    m_revision++;
+    if (m_sorted && !fitsOrder(m_count - 1, point.x(), -1))
+        m_sorted = false;
+
+    // 无容量限制
+    if (!isBounded()) {
+        if (m_layout == QXYSeries::StorageLayoutPoints) {
+            m_points.append(point);
+        } else {
+            if (m_layout == QXYSeries::StorageLayoutColumns)
+                m_x.append(point.x());
+            m_y.append(point.y());
+        }
+        m_count++;
+        m_lod.pointAppended(*this);
+        m_logCache.pointAppended(*this);
+        return false;
+    }
+
+    // 未满，写入下一个空闲槽位
+    if (m_count < m_capacity) {
+        write((m_start + m_count) % m_capacity, point);
+        m_count++;
+        m_lod.pointAppended(*this);
+        m_logCache.pointAppended(*this);
+        return false;
+    }
+
+    // 已满，覆盖最旧的槽位并前移起始位置
+    write(m_start, point);
+    m_start = (m_start + 1) % m_capacity;
+    advanceOrigin(1);
+    m_lod.pointsRemovedFromFront(*this, 1);
+    m_logCache.pointsRemovedFromFront(*this, 1);
+    m_lod.pointAppended(*this);
+    m_logCache.pointAppended(*this);
+    return true;
+}
+
+// 替换点
+void XYSeriesBuffer::replace(int index, const QPointF &point)
+{
+    m_revision++;
+    if (m_sorted && !fitsOrder(index - 1, point.x(), index + 1))
+        m_sorted = false;
+
+    if (isBounded()) {
+        write((m_start + index) % m_capacity, point);
+    } else if (m_layout == QXYSeries::StorageLayoutPoints) {
+        m_points[index] = point;
+    } else {
+        if (m_layout == QXYSeries::StorageLayoutColumns)
+            m_x[index] = point.x();
+        m_y[index] = point.y();
+    }
+    m_lod.pointReplaced(*this, index);
+    m_logCache.pointReplaced(*this, index);
+}
+
+// 插入点
+void XYSeriesBuffer::insert(int index, const QPointF &point)
+{
+    m_revision++;
+    if (m_sorted && !fitsOrder(index - 1, point.x(), index))
+        m_sorted = false;
+
+    // 无容量限制
+    if (!isBounded()) {
+        if (m_layout == QXYSeries::StorageLayoutPoints) {
+            m_points.insert(index, point);
+        } else {
+            if (m_layout == QXYSeries::StorageLayoutColumns)
+                m_x.insert(index, point.x());
+            m_y.insert(index, point.y());
+        }
+        m_count++;
+        // 插入到末尾等同于追加，否则其后各点的索引都已改变
+        if (index == m_count - 1) {
+            m_lod.pointAppended(*this);
+            m_logCache.pointAppended(*this);
+        } else {
+            m_lod.invalidate();
+            m_logCache.invalidate();
+        }
+        return;
+    }
+
+    // 环形缓冲中插入需要重新排列
+    QVector<QPointF> points = toVector();
+    points.insert(index, point);
+    setPoints(points);
+}
+
+// 移除点集
+void XYSeriesBuffer::remove(int index, int count)
+{
+    m_revision++;
+    // 无容量限制
+    if (!isBounded()) {
+        if (m_layout == QXYSeries::StorageLayoutPoints) {
+            m_points.remove(index, count);
+        } else {
+            if (m_layout == QXYSeries::StorageLayoutColumns)
+                m_x.remove(index, count);
+            m_y.remove(index, count);
+        }
+        // 移除头部时保持其余点的x值不变
+        if (index == 0)
+            advanceOrigin(count);
+        m_count -= count;
+        if (index == 0) {
+            m_lod.pointsRemovedFromFront(*this, count);
+            m_logCache.pointsRemovedFromFront(*this, count);
+        } else if (index == m_count) {
+            m_lod.pointsRemovedFromBack(*this);
+            m_logCache.pointsRemovedFromBack(*this);
+        } else {
+            m_lod.invalidate();
+            m_logCache.invalidate();
+        }
+        return;
+    }
+
+    // 移除头部只需前移起始位置
+    if (index == 0) {
+        m_start = (m_start + count) % m_capacity;
+        advanceOrigin(count);
+        m_count -= count;
+        m_lod.pointsRemovedFromFront(*this, count);
+        m_logCache.pointsRemovedFromFront(*this, count);
+    }
+    // 移除尾部只需减少数量
+    else if (index + count == m_count) {
+        m_count -= count;
+        m_lod.pointsRemovedFromBack(*this);
+        m_logCache.pointsRemovedFromBack(*this);
+    }
+    // 移除中间点需要重新排列
+    else {
+        QVector<QPointF> points = toVector();
+        points.remove(index, count);
+        setPoints(points);
+    }
+}
+
+// 清除
+void XYSeriesBuffer::clear()
+{
+    m_revision++;
+    if (!isBounded()) {
+        m_points.clear();
+        m_x.clear();
+        m_y.clear();
+    }
+    m_start = 0;
+    m_count = 0;
+    m_sorted = true;
+    m_lod.invalidate();
+    m_logCache.invalidate();
+}
+
+// 设置容量
+int XYSeriesBuffer::setCapacity(int capacity)
+{
+    capacity = qMax(0, capacity);
+    if (capacity == m_capacity)
+        return 0;
+
+    const QVector<QPointF> points = toVector();
+    const int evicted = capacity > 0 ? qMax(0, points.count() - capacity) : 0;
+
+    m_capacity = capacity;
+    m_points = QVector<QPointF>();
+    m_x = QVector<qreal>();
+    m_y = QVector<qreal>();
+    if (isBounded())
+        reserveSlots();
+    setPoints(points);
+
+    return evicted;
+}
+
+// 按容量分配环形存储
+void XYSeriesBuffer::reserveSlots()
+{
+    if (m_layout == QXYSeries::StorageLayoutPoints) {
+        m_points.resize(2 * m_capacity);
+    } else {
+        if (m_layout == QXYSeries::StorageLayoutColumns)
+            m_x.resize(2 * m_capacity);
+        m_y.resize(2 * m_capacity);
+    }
+}
+
+// 均匀采样布局时将起始x值前移指定点数
+void XYSeriesBuffer::advanceOrigin(int count)
+{
+    if (m_layout == QXYSeries::StorageLayoutUniformX)
+        m_x0 += count * m_dx;
+}
+
+// x值是否不小于before处的点且不大于after处的点，索引越界时不作比较
+bool XYSeriesBuffer::fitsOrder(int before, qreal x, int after) const
+{
+    if (before >= 0 && before < m_count && xAt(before) > x)
+        return false;
+    if (after >= 0 && after < m_count && xAt(after) < x)
+        return false;
+    return true;
+}
+
+// 写入环形槽位，同时写入镜像位置
+void XYSeriesBuffer::write(int slot, const QPointF &point)
+{
+    if (m_layout == QXYSeries::StorageLayoutPoints) {
+        QPointF *points = m_points.data();
+        points[slot] = point;
+        points[slot + m_capacity] = point;
+    } else {
+        if (m_layout == QXYSeries::StorageLayoutColumns) {
+            qreal *x = m_x.data();
+            x[slot] = x[slot + m_capacity] = point.x();
+        }
+        qreal *y = m_y.data();
+        y[slot] = y[slot + m_capacity] = point.y();
+    }
+}
+
+QT_CHARTS_END_NAMESPACE
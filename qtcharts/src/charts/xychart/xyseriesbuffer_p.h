@@ -0,0 +1,133 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef XYSERIESBUFFER_P_H
+#define XYSERIESBUFFER_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <QtCharts/QXYSeries>
+#include <private/xyserieslod_p.h>
+#include <private/xyserieslogcache_p.h>
+#include <QtCore/QVector>
+#include <QtCore/QPointF>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// x、y序列点缓冲
+// 无容量限制时为普通的连续点集；设置容量后为环形缓冲，每个槽位同时
+// 存储在 [0, capacity) 和 [capacity, 2 * capacity) 两处，因此逻辑上
+// 的点集始终是一段连续内存，淘汰最旧的点只需移动起始位置。
+// 列布局时x、y分别存储在两个连续数组中，at() 按值返回组装的点。
+// 均匀采样布局时只存储y列，第i个点的x值为 x0 + i * dx。
+// 复制缓冲只增加存储的引用计数，可作为快照交给其他线程单独使用。
+class QT_CHARTS_PRIVATE_EXPORT XYSeriesBuffer
+{
+public:
+    XYSeriesBuffer(); // 构造
+
+    QXYSeries::StorageLayout layout() const { return m_layout; } // 获取存储布局
+    void setLayout(QXYSeries::StorageLayout layout); // 设置存储布局
+    qreal samplingOrigin() const { return m_x0; } // 均匀采样的起始x值
+    qreal samplingInterval() const { return m_dx; } // 均匀采样的x间隔
+    void setSampling(qreal x0, qreal dx) { m_x0 = x0; m_dx = dx; m_revision++; m_lod.invalidate(); m_logCache.invalidate(); } // 设置均匀采样参数
+
+    int count() const { return m_count; } // 点计数
+    int size() const { return m_count; } // 点计数
+    bool isEmpty() const { return m_count == 0; } // 是否为空
+    QPointF at(int index) const; // 获取点
+    qreal xAt(int index) const; // 获取点x值
+    qreal yAt(int index) const; // 获取点y值
+    const QPointF *constData() const; // 连续点集首地址，仅点布局有效
+    const qreal *xData() const; // 连续x值首地址，仅列布局有效
+    const qreal *yData() const; // 连续y值首地址，列布局及均匀采样布局有效
+    int indexOf(const QPointF &point) const; // 查找点
+    bool extents(qreal &minX, qreal &maxX, qreal &minY, qreal &maxY) const; // 获取点集范围，空时返回false
+    bool extents(int index, int count,
+                 qreal &minX, qreal &maxX, qreal &minY, qreal &maxY) const; // 获取区间范围，空时返回false
+
+    bool isSorted() const; // x值是否单调不减
+    int lowerBound(qreal x) const; // 首个x值不小于x的点索引，仅有序时有效
+    int upperBound(qreal x) const; // 首个x值大于x的点索引，仅有序时有效
+    const XYSeriesLod &lod() const { return m_lod; } // 多分辨率最值金字塔
+    const QPointF *logPoints(qreal logBaseX, qreal logBaseY) const
+    { return m_logCache.points(*this, logBaseX, logBaseY); } // 对数坐标点集首地址，底为0表示线性轴
+    uint revision() const { return m_revision; } // 修订号，每次修改点集后递增
+    void adoptCaches(const XYSeriesBuffer &snapshot); // 接收同一修订的快照中构建的缓存
+
+    QVector<QPointF> toVector() const; // 获取点集
+    QVector<QPointF> mid(int index, int length = -1) const; // 获取部分点集
+    QList<QPointF> toList() const { return toVector().toList(); } // 获取点集
+
+    void setPoints(const QVector<QPointF> &points); // 设置点集
+    bool append(const QPointF &point); // 追加点，返回是否淘汰了最旧的点
+    void replace(int index, const QPointF &point); // 替换点
+    void insert(int index, const QPointF &point); // 插入点
+    void remove(int index, int count = 1); // 移除点集
+    void clear(); // 清除
+
+    int capacity() const { return m_capacity; } // 获取容量
+    bool isBounded() const { return m_capacity > 0; } // 是否有容量限制
+    bool isFull() const { return isBounded() && m_count == m_capacity; } // 是否已满
+    int setCapacity(int capacity); // 设置容量，返回被淘汰的最旧点数
+
+private:
+    void reserveSlots(); // 按容量分配环形存储
+    void advanceOrigin(int count); // 前移均匀采样的起始x值
+    bool fitsOrder(int before, qreal x, int after) const; // x值是否介于两个相邻点之间
+    void write(int slot, const QPointF &point); // 写入环形槽位
+
+private:
+    QXYSeries::StorageLayout m_layout; // 存储布局
+    QVector<QPointF> m_points; // 点存储（点布局）
+    QVector<qreal> m_x; // x值存储（列布局）
+    QVector<qreal> m_y; // y值存储（列布局、均匀采样布局）
+    qreal m_x0; // 均匀采样时首个点的x值
+    qreal m_dx; // 均匀采样时的x间隔
+    bool m_sorted; // x值是否单调不减，均匀采样布局不使用
+    XYSeriesLod m_lod; // 多分辨率最值金字塔
+    XYSeriesLogCache m_logCache; // 对数坐标缓存
+    int m_start; // 逻辑起始位置
+    int m_count; // 点数量
+    int m_capacity; // 容量，0 表示无限制
+    uint m_revision; // 修订号
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // XYSERIESBUFFER_P_H
@@ -0,0 +1,118 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/xyseriesingestqueue_p.h>
+#include <QtCore/QtMath>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 构造
+XYSeriesIngestQueue::XYSeriesIngestQueue()
+    : m_capacity(0), // 容量
+      m_mask(0), // 位置掩码
+      m_tail(0), // 下一个写入位置
+      m_head(0), // 下一个读取位置
+      m_scheduled(0) // 是否已安排取出
+{
+}
+
+// 设置容量，向上取整到2的幂，未取出的点被丢弃
+void XYSeriesIngestQueue::setCapacity(int capacity)
+{
+    m_capacity = capacity > 0 ? qNextPowerOfTwo(quint32(capacity - 1)) : 0;
+    m_mask = m_capacity > 0 ? m_capacity - 1 : 0;
+    m_slots.reset(m_capacity > 0 ? new Slot[m_capacity] : 0);
+    for (quint32 i = 0; i < m_capacity; i++)
+        m_slots[i].sequence.store(i);
+    m_tail.store(0);
+    m_head.store(0);
+}
+
+// 写入点集，返回写入的点数
+// 用一次比较交换预留连续的写入位置，队列剩余空间不足时只写入能容纳的部分
+int XYSeriesIngestQueue::push(const QPointF *points, int count)
+{
+    if (m_capacity == 0 || !points || count <= 0)
+        return 0;
+
+    quint32 position = m_tail.loadAcquire();
+    quint32 reserved = 0;
+    forever {
+        // 读取位置只会增加，据此得出的剩余空间偏保守
+        const quint32 used = position - m_head.loadAcquire();
+        reserved = qMin(quint32(count), m_capacity - qMin(used, m_capacity));
+        if (reserved == 0)
+            return 0;
+        if (m_tail.testAndSetOrdered(position, position + reserved, position))
+            break;
+    }
+
+    // 写入并逐个发布槽位
+    for (quint32 i = 0; i < reserved; i++) {
+        Slot &slot = m_slots[(position + i) & m_mask];
+        slot.point = points[i];
+        slot.sequence.storeRelease(position + i + 1);
+    }
+    return int(reserved);
+}
+
+// 取出所有已写入的点
+// 遇到仍在写入的槽位即停止，其后的点留待下次取出
+void XYSeriesIngestQueue::drain(QVector<QPointF> &points)
+{
+    points.clear();
+    if (m_capacity == 0)
+        return;
+
+    quint32 head = m_head.load();
+    forever {
+        Slot &slot = m_slots[head & m_mask];
+        if (slot.sequence.loadAcquire() != head + 1)
+            break;
+        points.append(slot.point);
+        slot.sequence.storeRelease(head + m_capacity);
+        head++;
+    }
+    m_head.storeRelease(head);
+}
+
+// 标记需要取出，返回是否由本次调用标记
+// 只有把标记从0改为1的生产者需要通知消费者，其余写入合并到同一次取出中
+bool XYSeriesIngestQueue::schedule()
+{
+    return m_scheduled.testAndSetOrdered(0, 1);
+}
+
+// 清除取出标记，消费者在取出之前调用，此后写入的点会再次安排取出
+void XYSeriesIngestQueue::unschedule()
+{
+    m_scheduled.storeRelease(0);
+}
+
+QT_CHARTS_END_NAMESPACE
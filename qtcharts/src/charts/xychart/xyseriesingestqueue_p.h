@@ -0,0 +1,88 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef XYSERIESINGESTQUEUE_P_H
+#define XYSERIESINGESTQUEUE_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <QtCore/QAtomicInteger>
+#include <QtCore/QScopedArrayPointer>
+#include <QtCore/QVector>
+#include <QtCore/QPointF>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// x、y序列接收队列
+// 固定容量的无锁多生产者、单消费者环形队列。采集线程调用 push() 写入点，不加锁也不分配内存；
+// 界面线程调用 drain() 一次取出所有已写入的点。每个槽位有一个序号：空闲时等于槽位的写入位置，
+// 写入完成后加一，消费者只读取已写入完成的连续槽位，读取后把序号推进一圈释放槽位。
+class QT_CHARTS_PRIVATE_EXPORT XYSeriesIngestQueue
+{
+public:
+    XYSeriesIngestQueue(); // 构造
+
+    void setCapacity(int capacity); // 设置容量，不可与 push()、drain() 并发调用
+    int capacity() const { return int(m_capacity); } // 获取容量
+
+    int push(const QPointF *points, int count); // 写入点集，返回写入的点数，线程安全
+    void drain(QVector<QPointF> &points); // 取出所有已写入的点，只能由消费者调用
+
+    bool schedule(); // 标记需要取出，返回是否由本次调用标记
+    void unschedule(); // 清除取出标记
+
+private:
+    // 槽位
+    struct Slot {
+        QAtomicInteger<quint32> sequence; // 序号
+        QPointF point; // 点
+    };
+
+    QScopedArrayPointer<Slot> m_slots; // 槽位
+    quint32 m_capacity; // 容量，2的幂
+    quint32 m_mask; // 位置掩码
+    QAtomicInteger<quint32> m_tail; // 下一个写入位置
+    QAtomicInteger<quint32> m_head; // 下一个读取位置
+    QAtomicInt m_scheduled; // 是否已安排取出
+
+    Q_DISABLE_COPY(XYSeriesIngestQueue)
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // XYSERIESINGESTQUEUE_P_H
@@ -0,0 +1,359 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/xyserieslod_p.h>
+#include <private/xyseriesbuffer_p.h>
+#include <cmath>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 空桶
+const XYSeriesLod::Bucket XYSeriesLod::EmptyBucket = { -1, -1, -1, -1 };
+
+// 构造
+XYSeriesLod::XYSeriesLod()
+    : m_origin(0), // 逻辑索引0对应的绝对索引
+      m_valid(false) // 是否有效
+{
+}
+
+// 失效
+void XYSeriesLod::invalidate()
+{
+    m_levels.clear();
+    m_origin = 0;
+    m_valid = false;
+}
+
+// 追加点后更新
+void XYSeriesLod::pointAppended(const XYSeriesBuffer &buffer)
+{
+    if (m_valid)
+        update(buffer, m_origin + buffer.count() - 1);
+}
+
+// 替换点后更新
+void XYSeriesLod::pointReplaced(const XYSeriesBuffer &buffer, int index)
+{
+    if (m_valid)
+        update(buffer, m_origin + index);
+}
+
+// 移除头部点后更新
+void XYSeriesLod::pointsRemovedFromFront(const XYSeriesBuffer &buffer, int count)
+{
+    if (!m_valid)
+        return;
+
+    m_origin += count;
+
+    // 已移除的点多于剩余的点时重建，重建的开销分摊到每次移除上为常数
+    if (buffer.isEmpty() || m_origin > buffer.count()) {
+        invalidate();
+        return;
+    }
+
+    // 更新跨越新起点的桶
+    update(buffer, m_origin);
+}
+
+// 移除尾部点后更新
+void XYSeriesLod::pointsRemovedFromBack(const XYSeriesBuffer &buffer)
+{
+    if (!m_valid)
+        return;
+
+    if (buffer.isEmpty()) {
+        invalidate();
+        return;
+    }
+
+    // 删除完全位于末尾之后的桶，并更新跨越末尾的桶
+    const int end = m_origin + buffer.count();
+    for (int level = 0; level < m_levels.count(); level++) {
+        const int shift = BaseShift + level;
+        m_levels[level].resize(((end - 1) >> shift) + 1);
+    }
+    update(buffer, end - 1);
+}
+
+// 获取区间的范围
+bool XYSeriesLod::extents(const XYSeriesBuffer &buffer, int index, int count,
+                          qreal &minX, qreal &maxX, qreal &minY, qreal &maxY) const
+{
+    if (count <= 0 || index < 0 || index + count > buffer.count())
+        return false;
+
+    if (!m_valid)
+        build(buffer);
+
+    Bucket bucket = EmptyBucket;
+    rangeExtremes(buffer, m_origin + index, m_origin + index + count, bucket);
+    minX = buffer.xAt(bucket.minX - m_origin);
+    maxX = buffer.xAt(bucket.maxX - m_origin);
+    minY = buffer.yAt(bucket.minY - m_origin);
+    maxY = buffer.yAt(bucket.maxY - m_origin);
+    return true;
+}
+
+// 获取区间的抽稀点集
+// 选择桶数不少于 buckets 的最粗一层，对区间内的每个桶按原有顺序输出首点、y最小点、y最大点和末点。
+// 桶按索引划分，x间隔不均匀时稀疏处的一个桶可能跨越多个像素列，只保留其中的最值会丢掉其他像素列
+// 的极值，因此x跨度超过一个像素列（columnSpan，对数x轴上为对数坐标的跨度）的桶拆分到下一层，
+// 底层的桶仍然过宽时输出其中的全部点。这样每组被合并的点都落在一个像素列宽度之内，被略去的点
+// 与保留的最值相距不超过一个像素列。区间太小，无法分出足够的桶时返回空点集。
+QVector<QPointF> XYSeriesLod::reducedPoints(const XYSeriesBuffer &buffer, int index, int count,
+                                            int buckets, qreal columnSpan, qreal logBaseX) const
+{
+    if (buckets <= 0 || count < (buckets << BaseShift)
+            || index < 0 || index + count > buffer.count()) {
+        return QVector<QPointF>();
+    }
+
+    if (!m_valid)
+        build(buffer);
+
+    // 选择最粗的一层
+    int level = 0;
+    while (level + 1 < m_levels.count() && (count >> (BaseShift + level + 1)) >= buckets)
+        level++;
+    const int shift = BaseShift + level;
+
+    const int first = m_origin + index;
+    const int end = first + count;
+
+    QVector<QPointF> result;
+    result.reserve(4 * ((count >> shift) + 2));
+
+    for (int start = first; start < end;) {
+        const int stop = qMin(((start >> shift) + 1) << shift, end);
+        appendReduced(buffer, start, stop, shift, columnSpan, logBaseX, result);
+        start = stop;
+    }
+
+    return result;
+}
+
+// 一个像素列的x跨度
+// 线性x轴上为可见x范围除以像素列数，对数x轴上为对数坐标（以logBaseX为底）的范围除以像素列数。
+qreal XYSeriesLod::columnSpan(qreal minX, qreal maxX, qreal logBaseX, qreal width)
+{
+    if (width <= 0)
+        return 0;
+    if (logBaseX > 0) {
+        if (minX <= 0 || maxX <= 0)
+            return 0;
+        return (std::log(maxX) - std::log(minX)) / std::log(logBaseX) / width;
+    }
+    return (maxX - minX) / width;
+}
+
+// 绝对索引区间 [first, last) 的x跨度是否不超过一个像素列
+// 只用于x值有序的序列，跨度即首末点x之差；对数x轴上有非正值的区间视为过宽。
+bool XYSeriesLod::fitsColumn(const XYSeriesBuffer &buffer, int first, int last,
+                             qreal columnSpan, qreal logBaseX) const
+{
+    const qreal firstX = buffer.xAt(first - m_origin);
+    const qreal lastX = buffer.xAt(last - 1 - m_origin);
+    if (logBaseX > 0) {
+        if (firstX <= 0)
+            return false;
+        return std::log(lastX / firstX) <= columnSpan * std::log(logBaseX);
+    }
+    return lastX - firstX <= columnSpan;
+}
+
+// 输出绝对索引区间 [first, last) 内一个 2^shift 点的桶的抽稀点
+// 桶的x跨度超过一个像素列时拆分为下一层的桶，底层仍然过宽时输出全部点。
+void XYSeriesLod::appendReduced(const XYSeriesBuffer &buffer, int first, int last, int shift,
+                                qreal columnSpan, qreal logBaseX,
+                                QVector<QPointF> &result) const
+{
+    if (!fitsColumn(buffer, first, last, columnSpan, logBaseX)) {
+        if (shift > BaseShift) {
+            for (int start = first; start < last;) {
+                const int stop = qMin(((start >> (shift - 1)) + 1) << (shift - 1), last);
+                appendReduced(buffer, start, stop, shift - 1, columnSpan, logBaseX, result);
+                start = stop;
+            }
+        } else {
+            for (int i = first; i < last; i++)
+                result.append(QPointF(buffer.xAt(i - m_origin), buffer.yAt(i - m_origin)));
+        }
+        return;
+    }
+
+    Bucket bucket = EmptyBucket;
+    rangeExtremes(buffer, first, last, bucket);
+
+    // 按原有顺序输出，重复的点只输出一次
+    const int lower = qMin(bucket.minY, bucket.maxY);
+    const int upper = qMax(bucket.minY, bucket.maxY);
+    result.append(QPointF(buffer.xAt(first - m_origin), buffer.yAt(first - m_origin)));
+    if (lower > first)
+        result.append(QPointF(buffer.xAt(lower - m_origin), buffer.yAt(lower - m_origin)));
+    if (upper > lower)
+        result.append(QPointF(buffer.xAt(upper - m_origin), buffer.yAt(upper - m_origin)));
+    if (last - 1 > upper)
+        result.append(QPointF(buffer.xAt(last - 1 - m_origin), buffer.yAt(last - 1 - m_origin)));
+}
+
+// 构建
+void XYSeriesLod::build(const XYSeriesBuffer &buffer) const
+{
+    m_levels.clear();
+    m_origin = 0;
+    m_valid = true;
+
+    const int count = buffer.count();
+    if (count == 0)
+        return;
+
+    // 底层，逐桶扫描
+    QVector<Bucket> base(((count - 1) >> BaseShift) + 1);
+    for (int i = 0; i < base.count(); i++) {
+        base[i] = EmptyBucket;
+        scan(buffer, i << BaseShift, qMin((i + 1) << BaseShift, count), base[i]);
+    }
+    m_levels.append(base);
+
+    // 上层，逐层合并相邻的两个桶，直到只剩一个桶
+    while (m_levels.last().count() > 1) {
+        const QVector<Bucket> &lower = m_levels.last();
+        QVector<Bucket> upper((lower.count() + 1) / 2);
+        for (int i = 0; i < upper.count(); i++) {
+            upper[i] = lower.at(2 * i);
+            if (2 * i + 1 < lower.count())
+                merge(buffer, lower.at(2 * i + 1), upper[i]);
+        }
+        m_levels.append(upper);
+    }
+}
+
+// 更新包含指定点的各层桶
+void XYSeriesLod::update(const XYSeriesBuffer &buffer, int absolute) const
+{
+    const int end = m_origin + buffer.count();
+
+    // 底层，重新扫描桶内的有效点
+    int bucketIndex = absolute >> BaseShift;
+    if (m_levels.isEmpty())
+        m_levels.append(QVector<Bucket>());
+    if (m_levels[0].count() <= bucketIndex)
+        m_levels[0].resize(bucketIndex + 1);
+    Bucket &base = m_levels[0][bucketIndex];
+    base = EmptyBucket;
+    scan(buffer, qMax(bucketIndex << BaseShift, m_origin),
+         qMin((bucketIndex + 1) << BaseShift, end), base);
+
+    // 上层，由下层的两个桶重新合并，必要时增加新的一层
+    for (int level = 1; level < m_levels.count() || m_levels.last().count() > 1; level++) {
+        if (level == m_levels.count())
+            m_levels.append(QVector<Bucket>());
+        const QVector<Bucket> &lower = m_levels.at(level - 1);
+        QVector<Bucket> &upper = m_levels[level];
+        bucketIndex >>= 1;
+        upper.resize((lower.count() + 1) / 2);
+        Bucket &bucket = upper[bucketIndex];
+        bucket = EmptyBucket;
+        merge(buffer, lower.at(2 * bucketIndex), bucket);
+        if (2 * bucketIndex + 1 < lower.count())
+            merge(buffer, lower.at(2 * bucketIndex + 1), bucket);
+    }
+}
+
+// 扫描绝对索引区间 [first, last) 内的点
+void XYSeriesLod::scan(const XYSeriesBuffer &buffer, int first, int last, Bucket &bucket) const
+{
+    for (int i = first; i < last; i++) {
+        const qreal x = buffer.xAt(i - m_origin);
+        const qreal y = buffer.yAt(i - m_origin);
+        if (bucket.minY < 0) {
+            bucket.minX = bucket.maxX = bucket.minY = bucket.maxY = i;
+            continue;
+        }
+        if (x < buffer.xAt(bucket.minX - m_origin))
+            bucket.minX = i;
+        if (x > buffer.xAt(bucket.maxX - m_origin))
+            bucket.maxX = i;
+        if (y < buffer.yAt(bucket.minY - m_origin))
+            bucket.minY = i;
+        if (y > buffer.yAt(bucket.maxY - m_origin))
+            bucket.maxY = i;
+    }
+}
+
+// 将桶 from 合并到桶 to
+// 空桶以及完全位于头部已移除部分的桶被忽略
+void XYSeriesLod::merge(const XYSeriesBuffer &buffer, const Bucket &from, Bucket &to) const
+{
+    if (from.minY < m_origin)
+        return;
+    if (to.minY < 0) {
+        to = from;
+        return;
+    }
+    if (buffer.xAt(from.minX - m_origin) < buffer.xAt(to.minX - m_origin))
+        to.minX = from.minX;
+    if (buffer.xAt(from.maxX - m_origin) > buffer.xAt(to.maxX - m_origin))
+        to.maxX = from.maxX;
+    if (buffer.yAt(from.minY - m_origin) < buffer.yAt(to.minY - m_origin))
+        to.minY = from.minY;
+    if (buffer.yAt(from.maxY - m_origin) > buffer.yAt(to.maxY - m_origin))
+        to.maxY = from.maxY;
+}
+
+// 绝对索引区间 [first, last) 的最值
+// 从左到右每次取起点对齐且完全位于区间内的最大的桶，不足一个底层桶的部分直接扫描。
+void XYSeriesLod::rangeExtremes(const XYSeriesBuffer &buffer, int first, int last,
+                                Bucket &bucket) const
+{
+    const int baseSize = 1 << BaseShift;
+    int i = first;
+    while (i < last) {
+        if ((i & (baseSize - 1)) != 0 || i + baseSize > last) {
+            const int stop = qMin(last, (i | (baseSize - 1)) + 1);
+            scan(buffer, i, stop, bucket);
+            i = stop;
+            continue;
+        }
+
+        int level = 0;
+        while (level + 1 < m_levels.count()) {
+            const int size = 1 << (BaseShift + level + 1);
+            if ((i & (size - 1)) != 0 || i + size > last)
+                break;
+            level++;
+        }
+        merge(buffer, m_levels.at(level).at(i >> (BaseShift + level)), bucket);
+        i += 1 << (BaseShift + level);
+    }
+}
+
+QT_CHARTS_END_NAMESPACE
@@ -0,0 +1,105 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef XYSERIESLOD_P_H
+#define XYSERIESLOD_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <QtCore/QVector>
+#include <QtCore/QPointF>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+class XYSeriesBuffer;
+
+// x、y序列多分辨率最值金字塔
+// 第k层把点按 2^(BaseShift + k) 个一组分桶，记录每个桶中x、y最小、最大点的索引，
+// 顶层只有一个桶。任意区间的范围由 O(log n) 个桶合并得出。索引为绝对索引，即逻辑索引加上 m_origin，因此移除头部的点
+// 只需增加 m_origin。金字塔在首次查询时构建，此后随追加、替换以及头尾移除
+// 增量维护；在中间插入或移除点时失效，待下次查询时重建。
+class QT_CHARTS_PRIVATE_EXPORT XYSeriesLod
+{
+public:
+    enum { BaseShift = 4 }; // 底层桶大小为 2^BaseShift 个点
+
+    XYSeriesLod(); // 构造
+
+    void invalidate(); // 失效
+    void pointAppended(const XYSeriesBuffer &buffer); // 追加点后更新
+    void pointReplaced(const XYSeriesBuffer &buffer, int index); // 替换点后更新
+    void pointsRemovedFromFront(const XYSeriesBuffer &buffer, int count); // 移除头部点后更新
+    void pointsRemovedFromBack(const XYSeriesBuffer &buffer); // 移除尾部点后更新
+
+    bool extents(const XYSeriesBuffer &buffer, int index, int count,
+                 qreal &minX, qreal &maxX, qreal &minY, qreal &maxY) const; // 获取区间的范围
+    QVector<QPointF> reducedPoints(const XYSeriesBuffer &buffer, int index, int count,
+                                   int buckets, qreal columnSpan,
+                                   qreal logBaseX = 0) const; // 获取区间的抽稀点集
+    static qreal columnSpan(qreal minX, qreal maxX, qreal logBaseX, qreal width); // 一个像素列的x跨度
+
+private:
+    // 桶，记录x、y最小、最大点的绝对索引，空桶为-1
+    struct Bucket {
+        int minX;
+        int maxX;
+        int minY;
+        int maxY;
+    };
+    static const Bucket EmptyBucket; // 空桶
+
+    void build(const XYSeriesBuffer &buffer) const; // 构建
+    void update(const XYSeriesBuffer &buffer, int absolute) const; // 更新包含指定点的各层桶
+    void scan(const XYSeriesBuffer &buffer, int first, int last, Bucket &bucket) const; // 扫描区间内的点
+    void merge(const XYSeriesBuffer &buffer, const Bucket &from, Bucket &to) const; // 合并桶
+    void rangeExtremes(const XYSeriesBuffer &buffer, int first, int last, Bucket &bucket) const; // 区间最值
+    bool fitsColumn(const XYSeriesBuffer &buffer, int first, int last, qreal columnSpan,
+                    qreal logBaseX) const; // 区间的x跨度是否不超过一个像素列
+    void appendReduced(const XYSeriesBuffer &buffer, int first, int last, int shift,
+                       qreal columnSpan, qreal logBaseX,
+                       QVector<QPointF> &result) const; // 输出一个桶的抽稀点
+
+private:
+    mutable QVector<QVector<Bucket> > m_levels; // 各层桶
+    mutable int m_origin; // 逻辑索引0对应的绝对索引
+    mutable bool m_valid; // 是否有效
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // XYSERIESLOD_P_H
@@ -0,0 +1,143 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <private/xyserieslogcache_p.h>
+#include <private/xyseriesbuffer_p.h>
+#include <QtCore/QtNumeric>
+#include <cmath>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+// 构造
+XYSeriesLogCache::XYSeriesLogCache()
+    : m_origin(0), // 逻辑索引0对应的绝对索引
+      m_logBaseX(0), // x底
+      m_logBaseY(0), // y底
+      m_log10BaseX(1), // log10(x底)
+      m_log10BaseY(1), // log10(y底)
+      m_valid(false) // 是否有效
+{
+}
+
+// 失效
+void XYSeriesLogCache::invalidate()
+{
+    m_points.clear();
+    m_origin = 0;
+    m_valid = false;
+}
+
+// 追加点后更新
+void XYSeriesLogCache::pointAppended(const XYSeriesBuffer &buffer)
+{
+    if (m_valid)
+        m_points.append(logPoint(buffer.at(buffer.count() - 1)));
+}
+
+// 替换点后更新
+void XYSeriesLogCache::pointReplaced(const XYSeriesBuffer &buffer, int index)
+{
+    if (m_valid)
+        m_points[m_origin + index] = logPoint(buffer.at(index));
+}
+
+// 移除头部点后更新
+void XYSeriesLogCache::pointsRemovedFromFront(const XYSeriesBuffer &buffer, int count)
+{
+    if (!m_valid)
+        return;
+
+    m_origin += count;
+
+    // 已移除的点多于剩余的点时压缩，压缩的开销分摊到每次移除上为常数
+    if (m_origin > buffer.count()) {
+        m_points.remove(0, m_origin);
+        m_origin = 0;
+    }
+}
+
+// 移除尾部点后更新
+void XYSeriesLogCache::pointsRemovedFromBack(const XYSeriesBuffer &buffer)
+{
+    if (m_valid)
+        m_points.resize(m_origin + buffer.count());
+}
+
+// 对数坐标点集首地址
+const QPointF *XYSeriesLogCache::points(const XYSeriesBuffer &buffer,
+                                        qreal logBaseX, qreal logBaseY) const
+{
+    if (!m_valid || logBaseX != m_logBaseX || logBaseY != m_logBaseY) {
+        m_logBaseX = logBaseX;
+        m_logBaseY = logBaseY;
+        m_log10BaseX = logBaseX > 0 ? std::log10(logBaseX) : 1;
+        m_log10BaseY = logBaseY > 0 ? std::log10(logBaseY) : 1;
+        build(buffer);
+    }
+    return m_points.constData() + m_origin;
+}
+
+// 换算单个点
+QPointF XYSeriesLogCache::logPoint(const QPointF &point) const
+{
+    return logPoint(point, m_logBaseX, m_log10BaseX, m_logBaseY, m_log10BaseY);
+}
+
+// 换算单个点，对数轴上的非正值记为断点
+QPointF XYSeriesLogCache::logPoint(const QPointF &point, qreal logBaseX, qreal log10BaseX,
+                                   qreal logBaseY, qreal log10BaseY)
+{
+    qreal x = point.x();
+    qreal y = point.y();
+    if (logBaseX > 0) {
+        if (x <= 0)
+            return QPointF(qQNaN(), qQNaN());
+        x = std::log10(x) / log10BaseX;
+    }
+    if (logBaseY > 0) {
+        if (y <= 0)
+            return QPointF(qQNaN(), qQNaN());
+        y = std::log10(y) / log10BaseY;
+    }
+    return QPointF(x, y);
+}
+
+// 构建
+void XYSeriesLogCache::build(const XYSeriesBuffer &buffer) const
+{
+    const int count = buffer.count();
+    m_points.resize(count);
+    m_origin = 0;
+    QPointF *points = m_points.data();
+    for (int i = 0; i < count; i++)
+        points[i] = logPoint(QPointF(buffer.xAt(i), buffer.yAt(i)));
+    m_valid = true;
+}
+
+QT_CHARTS_END_NAMESPACE
@@ -0,0 +1,89 @@
+﻿/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt Chart API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#ifndef XYSERIESLOGCACHE_P_H
+#define XYSERIESLOGCACHE_P_H
+
+#include <QtCharts/QChartGlobal>
+#include <QtCharts/private/qchartglobal_p.h>
+#include <QtCore/QVector>
+#include <QtCore/QPointF>
+
+QT_CHARTS_BEGIN_NAMESPACE
+
+class XYSeriesBuffer;
+
+// x、y序列对数坐标缓存
+// 记录每个点在对数轴上的坐标 log(v) / log(底)，底为0的轴保留原值，非正值记为NaN，
+// 作为断点跳过。缓存在首次查询时按给定的底构建，此后随追加、替换以及头尾移除增量维护，
+// 区域范围变化时无需重新取对数。索引为绝对索引，即逻辑索引加上 m_origin，因此移除头部的点
+// 只需增加 m_origin；在中间插入或移除点、或者查询的底改变时失效，待下次查询时重建。
+class QT_CHARTS_PRIVATE_EXPORT XYSeriesLogCache
+{
+public:
+    XYSeriesLogCache(); // 构造
+
+    void invalidate(); // 失效
+    void pointAppended(const XYSeriesBuffer &buffer); // 追加点后更新
+    void pointReplaced(const XYSeriesBuffer &buffer, int index); // 替换点后更新
+    void pointsRemovedFromFront(const XYSeriesBuffer &buffer, int count); // 移除头部点后更新
+    void pointsRemovedFromBack(const XYSeriesBuffer &buffer); // 移除尾部点后更新
+
+    const QPointF *points(const XYSeriesBuffer &buffer,
+                          qreal logBaseX, qreal logBaseY) const; // 对数坐标点集首地址，底为0表示线性轴
+
+    static QPointF logPoint(const QPointF &point, qreal logBaseX, qreal log10BaseX,
+                            qreal logBaseY, qreal log10BaseY); // 换算单个点，底为0表示线性轴
+
+private:
+    QPointF logPoint(const QPointF &point) const; // 换算单个点
+    void build(const XYSeriesBuffer &buffer) const; // 构建
+
+private:
+    mutable QVector<QPointF> m_points; // 对数坐标点集
+    mutable int m_origin; // 逻辑索引0对应的绝对索引
+    mutable qreal m_logBaseX; // x底，0表示线性
+    mutable qreal m_logBaseY; // y底，0表示线性
+    mutable qreal m_log10BaseX; // log10(x底)
+    mutable qreal m_log10BaseY; // log10(y底)
+    mutable bool m_valid; // 是否有效
+};
+
+QT_CHARTS_END_NAMESPACE
+
+#endif // XYSERIESLOGCACHE_P_H
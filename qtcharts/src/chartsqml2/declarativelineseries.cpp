@@ -42,8 +42,11 @@ DeclarativeLineSeries::DeclarativeLineSeries(QObject *parent) :
     connect(m_axes, SIGNAL(axisXChanged(QAbstractAxis*)), this, SIGNAL(axisAngularChanged(QAbstractAxis*)));
     connect(m_axes, SIGNAL(axisYChanged(QAbstractAxis*)), this, SIGNAL(axisRadialChanged(QAbstractAxis*)));
     connect(this, SIGNAL(pointAdded(int)), this, SLOT(handleCountChanged(int)));
+    connect(this, SIGNAL(pointsAdded(int, int)), this, SLOT(handleCountChanged(int)));
+    connect(this, SIGNAL(pointsAdvanced(int, int)), this, SLOT(handleCountChanged(int)));
     connect(this, SIGNAL(pointRemoved(int)), this, SLOT(handleCountChanged(int)));
     connect(this, SIGNAL(pointsRemoved(int, int)), this, SLOT(handleCountChanged(int)));
+    connect(this, SIGNAL(pointsReplaced()), this, SLOT(handlePointsReplaced()));
 }
 
 void DeclarativeLineSeries::handleCountChanged(int index)
@@ -52,6 +55,11 @@ void DeclarativeLineSeries::handleCountChanged(int index)
     emit countChanged(points().count());
 }
 
+void DeclarativeLineSeries::handlePointsReplaced()
+{
+    emit countChanged(count());
+}
+
 qreal DeclarativeLineSeries::width() const
 {
     return pen().widthF();
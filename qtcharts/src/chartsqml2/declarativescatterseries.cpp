@@ -42,8 +42,11 @@ DeclarativeScatterSeries::DeclarativeScatterSeries(QObject *parent) :
     connect(m_axes, SIGNAL(axisXChanged(QAbstractAxis*)), this, SIGNAL(axisAngularChanged(QAbstractAxis*)));
     connect(m_axes, SIGNAL(axisYChanged(QAbstractAxis*)), this, SIGNAL(axisRadialChanged(QAbstractAxis*)));
     connect(this, SIGNAL(pointAdded(int)), this, SLOT(handleCountChanged(int)));
+    connect(this, SIGNAL(pointsAdded(int, int)), this, SLOT(handleCountChanged(int)));
+    connect(this, SIGNAL(pointsAdvanced(int, int)), this, SLOT(handleCountChanged(int)));
     connect(this, SIGNAL(pointRemoved(int)), this, SLOT(handleCountChanged(int)));
     connect(this, SIGNAL(pointsRemoved(int, int)), this, SLOT(handleCountChanged(int)));
+    connect(this, SIGNAL(pointsReplaced()), this, SLOT(handlePointsReplaced()));
     connect(this, SIGNAL(brushChanged()), this, SLOT(handleBrushChanged()));
 }
 
@@ -53,6 +56,11 @@ void DeclarativeScatterSeries::handleCountChanged(int index)
     emit countChanged(QScatterSeries::count());
 }
 
+void DeclarativeScatterSeries::handlePointsReplaced()
+{
+    emit countChanged(QScatterSeries::count());
+}
+
 qreal DeclarativeScatterSeries::borderWidth() const
 {
     return pen().widthF();
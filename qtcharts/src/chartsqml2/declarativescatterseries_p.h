@@ -119,6 +119,7 @@ Q_SIGNALS:
 public Q_SLOTS:
     static void appendDeclarativeChildren(QQmlListProperty<QObject> *list, QObject *element);
     void handleCountChanged(int index);
+    void handlePointsReplaced();
 
 private Q_SLOTS:
     void handleBrushChanged();
@@ -0,0 +1,241 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+#include <QtCharts/QChartView>
+#include <QtCharts/QAreaSeries>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QValueAxis>
+#include <QtCharts/QLogValueAxis>
+#include <private/qabstractseries_p.h>
+#include <private/abstractdomain_p.h>
+#include <private/areachartitem_p.h>
+
+QT_CHARTS_USE_NAMESPACE
+
+class tst_AreaChartItem : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void fillPolygon();
+    void fillPolygonBaseline();
+    void fillPolygonGaps();
+};
+
+// Area series giving access to its chart item
+class AreaSeries : public QAreaSeries
+{
+public:
+    AreaSeries(QLineSeries *upper, QLineSeries *lower = 0) : QAreaSeries(upper, lower) {}
+    AreaChartItem *item() { return static_cast<AreaChartItem *>(d_ptr->chartItem()); }
+};
+
+// Removes repeated consecutive points and the closing point of a polygon
+static QPolygonF normalized(const QPolygonF &polygon)
+{
+    QPolygonF result;
+    for (int i = 0; i < polygon.count(); i++) {
+        if (result.isEmpty() || polygon.at(i) != result.last())
+            result.append(polygon.at(i));
+    }
+    if (result.count() > 1 && result.first() == result.last())
+        result.removeLast();
+    return result;
+}
+
+// The fill polygon built from the paths of the edges as AreaChartItem::updatePath() does
+// when it cannot fill a polygon
+static QPolygonF pathPolygon(AreaChartItem *item)
+{
+    QPainterPath path = item->upperLineItem()->path();
+    if (item->lowerLineItem()) {
+        path.connectPath(item->lowerLineItem()->path().toReversed());
+    } else {
+        const qreal baseline = item->upperLineItem()->domain()->size().height();
+        const QPointF first = path.pointAtPercent(0);
+        const QPointF last = path.pointAtPercent(1);
+        path.lineTo(last.x(), baseline);
+        path.lineTo(first.x(), baseline);
+    }
+    path.closeSubpath();
+    return path.toFillPolygon();
+}
+
+// Compares the fill polygon of the item of series with the path based construction,
+// and its bounding rectangle with the bounds of that polygon
+static bool compareFill(AreaSeries *series)
+{
+    AreaChartItem *item = series->item();
+    const QPolygonF expected = pathPolygon(item);
+    const QPolygonF actual = QPolygonF(item->fillPoints());
+    if (normalized(actual) != normalized(expected)) {
+        qWarning() << "fill polygon" << actual << "expected" << expected;
+        return false;
+    }
+    const QRectF rect = item->boundingRect();
+    const QRectF expectedRect = expected.boundingRect();
+    if (qAbs(rect.left() - expectedRect.left()) > 1e-9
+            || qAbs(rect.top() - expectedRect.top()) > 1e-9
+            || qAbs(rect.right() - expectedRect.right()) > 1e-9
+            || qAbs(rect.bottom() - expectedRect.bottom()) > 1e-9) {
+        qWarning() << "bounding rect" << rect << "expected" << expectedRect;
+        return false;
+    }
+    return true;
+}
+
+// Adds the area series to the chart of view with fixed axes and shows the view
+static void showArea(QChartView &view, AreaSeries *series, QAbstractAxis *axisY)
+{
+    view.resize(800, 600);
+    view.chart()->addSeries(series);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(0, 100);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+}
+
+void tst_AreaChartItem::fillPolygon()
+{
+    QLineSeries *upper = new QLineSeries;
+    QLineSeries *lower = new QLineSeries;
+    for (int i = 0; i < 50; i++) {
+        upper->append(i, 60 + i % 7);
+        lower->append(i, 20 + i % 5);
+    }
+    AreaSeries *series = new AreaSeries(upper, lower);
+    QChartView view;
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setRange(0, 100);
+    showArea(view, series, axisY);
+    QVERIFY(!series->item()->fillPoints().isEmpty());
+    QVERIFY(compareFill(series));
+
+    // Appending to the upper edge moves the reversed lower edge after it
+    upper->append(50, 62);
+    QVERIFY(compareFill(series));
+    // An appended point beyond the bounds extends them
+    upper->append(51, 95);
+    QVERIFY(compareFill(series));
+    // Replacing rewrites the upper edge from the change on
+    upper->replace(25, QPointF(25, 80));
+    QVERIFY(compareFill(series));
+    // Shrinking the upper edge drops the extended bounds again
+    upper->removePoints(50, 2);
+    QVERIFY(compareFill(series));
+
+    // Changes of the lower edge rewrite its reversed copy
+    lower->append(50, 5);
+    QVERIFY(compareFill(series));
+    lower->replace(10, QPointF(10, 2));
+    QVERIFY(compareFill(series));
+    lower->replace(0, QPointF(0, 30));
+    QVERIFY(compareFill(series));
+    lower->removePoints(40, 11);
+    QVERIFY(compareFill(series));
+    lower->remove(0);
+    QVERIFY(compareFill(series));
+
+    // Both edges again, with the upper one shorter
+    upper->removePoints(0, 20);
+    QVERIFY(compareFill(series));
+    lower->append(45, 25);
+    QVERIFY(compareFill(series));
+}
+
+void tst_AreaChartItem::fillPolygonBaseline()
+{
+    QLineSeries *upper = new QLineSeries;
+    for (int i = 0; i < 50; i++)
+        upper->append(i, 60 + i % 7);
+    AreaSeries *series = new AreaSeries(upper);
+    QChartView view;
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setRange(0, 100);
+    showArea(view, series, axisY);
+
+    // Without a lower series the polygon is closed along the bottom of the plot area
+    const QVector<QPointF> fill = series->item()->fillPoints();
+    const qreal baseline = series->item()->upperLineItem()->domain()->size().height();
+    QCOMPARE(fill.count(), upper->count() + 2);
+    QCOMPARE(fill.at(fill.count() - 2).y(), baseline);
+    QCOMPARE(fill.last().y(), baseline);
+    QVERIFY(compareFill(series));
+
+    // The baseline ends follow the ends of the upper edge
+    upper->append(50, 70);
+    QVERIFY(compareFill(series));
+    upper->replace(0, QPointF(-5, 65));
+    QVERIFY(compareFill(series));
+    upper->removePoints(40, 11);
+    QVERIFY(compareFill(series));
+    // A point below the bottom of the plot area extends the bounds beyond the baseline
+    upper->append(45, -20);
+    QVERIFY(compareFill(series));
+}
+
+void tst_AreaChartItem::fillPolygonGaps()
+{
+    QLineSeries *upper = new QLineSeries;
+    QLineSeries *lower = new QLineSeries;
+    for (int i = 0; i < 50; i++) {
+        upper->append(i, 60 + i % 7);
+        lower->append(i, 20 + i % 5);
+    }
+    AreaSeries *series = new AreaSeries(upper, lower);
+    QChartView view;
+    QLogValueAxis *axisY = new QLogValueAxis;
+    axisY->setRange(1, 100);
+    showArea(view, series, axisY);
+    QVERIFY(!series->item()->fillPoints().isEmpty());
+    QVERIFY(compareFill(series));
+
+    // A non-positive value on the logarithmic axis is a gap, which the polygon cannot
+    // represent, so the area falls back to the paths of the edges
+    upper->replace(25, QPointF(25, 0));
+    QVERIFY(series->item()->fillPoints().isEmpty());
+    lower->replace(10, QPointF(10, -1));
+    QVERIFY(series->item()->fillPoints().isEmpty());
+
+    // Without gaps the polygon is built again from scratch
+    upper->replace(25, QPointF(25, 61));
+    QVERIFY(series->item()->fillPoints().isEmpty());
+    lower->replace(10, QPointF(10, 21));
+    QVERIFY(!series->item()->fillPoints().isEmpty());
+    QVERIFY(compareFill(series));
+    upper->append(50, 90);
+    QVERIFY(compareFill(series));
+}
+
+QTEST_MAIN(tst_AreaChartItem)
+#include "tst_areachartitem.moc"
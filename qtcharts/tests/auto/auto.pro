@@ -22,6 +22,12 @@ SUBDIRS += \
            qbarcategoryaxis \
            domain \
            chartdataset \
+           xychart \
+           splinechartitem \
+           areachartitem \
+           scatterchartitem \
+           xyanimation \
+           chartpresenter \
            qlegend \
            qareaseries \
            cmake \
@@ -41,5 +47,11 @@ qtHaveModule(quick) {
 
 !contains(QT_CONFIG, private_tests): SUBDIRS -= \
     domain \
-    chartdataset
+    chartdataset \
+    xychart \
+    splinechartitem \
+    areachartitem \
+    scatterchartitem \
+    xyanimation \
+    chartpresenter
 
@@ -0,0 +1,285 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QValueAxis>
+#include <private/qabstractaxis_p.h>
+#include <private/qabstractseries_p.h>
+#include <private/chartaxiselement_p.h>
+#include <private/chartpresenter_p.h>
+#include <private/xychart_p.h>
+
+QT_CHARTS_USE_NAMESPACE
+
+class tst_ChartPresenter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void deletedAnimations();
+    void interruptedFrames();
+};
+
+// Line series giving access to its chart item
+class LineSeries : public QLineSeries
+{
+public:
+    XYChart *item() { return static_cast<XYChart *>(d_ptr->chartItem()); }
+};
+
+// Value axis giving access to its axis element
+class ValueAxis : public QValueAxis
+{
+public:
+    ChartAxisElement *item() { return d_ptr->axisItem(); }
+};
+
+// Animation counting its starts and the frames applied to it
+class CountingAnimation : public ChartAnimation
+{
+public:
+    explicit CountingAnimation(ChartPresenter *presenter)
+        : m_presenter(presenter),
+          m_starts(0),
+          m_frames(0)
+    {
+        setDuration(1000);
+        setStartValue(qreal(0));
+        setEndValue(qreal(1));
+    }
+
+    int starts() const { return m_starts; }
+    int frames() const { return m_frames; }
+    void request() { requestFrame(m_presenter); }
+
+protected:
+    void updateCurrentValue(const QVariant &value) { Q_UNUSED(value); }
+    void updateState(QAbstractAnimation::State newState, QAbstractAnimation::State oldState)
+    {
+        if (oldState == QAbstractAnimation::Stopped && newState == QAbstractAnimation::Running)
+            m_starts++;
+    }
+    void applyFrame() { m_frames++; }
+
+private:
+    ChartPresenter *m_presenter;
+    int m_starts;
+    int m_frames;
+};
+
+// Points of a wavy line
+static QVector<QPointF> wave(int count, qreal phase)
+{
+    QVector<QPointF> points;
+    for (int i = 0; i < count; i++)
+        points.append(QPointF(i, 3 * qSin(i * 0.5 + phase)));
+    return points;
+}
+
+// Points linearly interpolated between start and end at progress
+static QVector<QPointF> lerp(const QVector<QPointF> &start, const QVector<QPointF> &end,
+                             qreal progress)
+{
+    QVector<QPointF> points;
+    for (int i = 0; i < end.count(); i++)
+        points.append(start.at(i) + (end.at(i) - start.at(i)) * progress);
+    return points;
+}
+
+// Compares points with a tolerance for the rounding of the interpolation
+static bool comparePoints(const QVector<QPointF> &actual, const QVector<QPointF> &expected)
+{
+    if (actual.count() != expected.count()) {
+        qWarning() << "got" << actual.count() << "points, expected" << expected.count();
+        return false;
+    }
+    for (int i = 0; i < actual.count(); i++) {
+        if (qAbs(actual.at(i).x() - expected.at(i).x()) > 1e-6
+                || qAbs(actual.at(i).y() - expected.at(i).y()) > 1e-6) {
+            qWarning() << "point" << i << "is" << actual.at(i) << "expected" << expected.at(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_ChartPresenter::deletedAnimations()
+{
+    QChartView view;
+    LineSeries *series = new LineSeries;
+    series->append(wave(10, 0));
+    view.chart()->addSeries(series);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    ChartPresenter *presenter = series->item()->presenter();
+
+    // Animations started by the same change start together with the next event loop pass,
+    // skipping those deleted in the meantime
+    CountingAnimation *first = new CountingAnimation(presenter);
+    CountingAnimation *deleted = new CountingAnimation(presenter);
+    CountingAnimation *destroyed = new CountingAnimation(presenter);
+    CountingAnimation *last = new CountingAnimation(presenter);
+    QPointer<CountingAnimation> destroyedGuard(destroyed);
+    presenter->startAnimation(first);
+    presenter->startAnimation(deleted);
+    presenter->startAnimation(destroyed);
+    presenter->startAnimation(last);
+    presenter->startAnimation(first);
+    QCOMPARE(first->state(), QAbstractAnimation::Stopped);
+    delete deleted;
+    destroyed->stopAndDestroyLater();
+    QTRY_COMPARE(first->state(), QAbstractAnimation::Running);
+    QCOMPARE(last->state(), QAbstractAnimation::Running);
+    QCOMPARE(first->starts(), 1);
+    QCOMPARE(last->starts(), 1);
+    QTRY_VERIFY(destroyedGuard.isNull());
+
+    // Frames are applied once per pass, skipping animations deleted while their frame was queued
+    first->stop();
+    last->stop();
+    CountingAnimation *queued = new CountingAnimation(presenter);
+    first->request();
+    queued->request();
+    last->request();
+    first->request();
+    QCOMPARE(first->frames(), 0);
+    delete queued;
+    QTRY_COMPARE(last->frames(), 1);
+    QCOMPARE(first->frames(), 1);
+
+    // A frame applied directly is not applied again by the pass
+    first->request();
+    first->updateFrame();
+    QCOMPARE(first->frames(), 2);
+    QTest::qWait(50);
+    QCOMPARE(first->frames(), 2);
+
+    delete first;
+    delete last;
+}
+
+void tst_ChartPresenter::interruptedFrames()
+{
+    // Two animated series and an animated axis sharing the chart
+    QChartView view;
+    view.resize(800, 600);
+    view.chart()->legend()->setVisible(false);
+    LineSeries *series1 = new LineSeries;
+    series1->append(wave(20, 0));
+    LineSeries *series2 = new LineSeries;
+    series2->append(wave(20, 1));
+    view.chart()->addSeries(series1);
+    view.chart()->addSeries(series2);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(-1, 21);
+    ValueAxis *axisY = new ValueAxis;
+    axisY->setRange(-6, 6);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series1->attachAxis(axisX);
+    series1->attachAxis(axisY);
+    series2->attachAxis(axisX);
+    series2->attachAxis(axisY);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    view.chart()->setAnimationDuration(1000);
+    view.chart()->setAnimationEasingCurve(QEasingCurve::Linear);
+    view.chart()->setAnimationOptions(QChart::AllAnimations);
+
+    XYChart *item1 = series1->item();
+    XYChart *item2 = series2->item();
+    ChartAnimation *animation1 = item1->animation();
+    ChartAnimation *animation2 = item2->animation();
+    ChartAnimation *axisAnimation = axisY->item()->animation();
+    QVERIFY(animation1);
+    QVERIFY(animation2);
+    QVERIFY(axisAnimation);
+
+    // Changing the axis range animates both series and the axis, starting together with the
+    // next event loop pass and advancing on the same timer ticks
+    const QVector<QPointF> start1 = item1->geometryPoints();
+    const QVector<QPointF> start2 = item2->geometryPoints();
+    axisY->setRange(-8, 8);
+    QCOMPARE(animation1->state(), QAbstractAnimation::Stopped);
+    QCOMPARE(animation2->state(), QAbstractAnimation::Stopped);
+    QCOMPARE(axisAnimation->state(), QAbstractAnimation::Stopped);
+    const QVector<QPointF> end1 = item1->geometryPoints();
+    const QVector<QPointF> end2 = item2->geometryPoints();
+    QTRY_COMPARE(animation1->state(), QAbstractAnimation::Running);
+    QCOMPARE(animation2->state(), QAbstractAnimation::Running);
+    QCOMPARE(axisAnimation->state(), QAbstractAnimation::Running);
+    QCOMPARE(animation2->currentTime(), animation1->currentTime());
+    QCOMPARE(axisAnimation->currentTime(), animation1->currentTime());
+
+    // Record frames halfway, which the presenter would apply with its next pass, and interrupt
+    // the animations with another change before that
+    animation1->setCurrentTime(500);
+    animation2->setCurrentTime(500);
+    axisAnimation->setCurrentTime(500);
+    axisY->setRange(-4, 4);
+    QCOMPARE(animation1->state(), QAbstractAnimation::Stopped);
+    QCOMPARE(animation2->state(), QAbstractAnimation::Stopped);
+    QCOMPARE(axisAnimation->state(), QAbstractAnimation::Stopped);
+
+    // The recorded frames were applied when the animations stopped, so the queued pass has
+    // nothing left to apply over the new animations
+    const QVector<QPointF> next1 = item1->geometryPoints();
+    const QVector<QPointF> next2 = item2->geometryPoints();
+    const QVector<qreal> axisLayout = axisY->item()->layout();
+    animation1->updateFrame();
+    animation2->updateFrame();
+    axisAnimation->updateFrame();
+    QCOMPARE(item1->geometryPoints(), next1);
+    QCOMPARE(item2->geometryPoints(), next2);
+    QCOMPARE(axisY->item()->layout(), axisLayout);
+
+    // The new series animations start from the frames displayed when they were interrupted
+    QTRY_COMPARE(animation1->state(), QAbstractAnimation::Running);
+    QCOMPARE(animation2->state(), QAbstractAnimation::Running);
+    QCOMPARE(axisAnimation->state(), QAbstractAnimation::Running);
+    animation1->setCurrentTime(0);
+    animation1->updateFrame();
+    animation2->setCurrentTime(0);
+    animation2->updateFrame();
+    QVERIFY(comparePoints(item1->geometryPoints(), lerp(start1, end1, 0.5)));
+    QVERIFY(comparePoints(item2->geometryPoints(), lerp(start2, end2, 0.5)));
+
+    // And end at the geometry of the last change
+    QSignalSpy finishedSpy1(animation1, SIGNAL(finished()));
+    QSignalSpy finishedSpy2(animation2, SIGNAL(finished()));
+    QTRY_COMPARE(finishedSpy1.count(), 1);
+    QTRY_COMPARE(finishedSpy2.count(), 1);
+    QVERIFY(comparePoints(item1->geometryPoints(), next1));
+    QVERIFY(comparePoints(item2->geometryPoints(), next2));
+}
+
+QTEST_MAIN(tst_ChartPresenter)
+#include "tst_chartpresenter.moc"
@@ -28,6 +28,8 @@
 ****************************************************************************/
 #include <QtTest/QtTest>
 #include <private/xydomain_p.h>
+#include <private/logxlogydomain_p.h>
+#include <private/domaintransform_p.h>
 #include <private/qabstractaxis_p.h>
 #include <tst_definitions.h>
 
@@ -128,6 +130,11 @@ private Q_SLOTS:
     void zoomOut();
     void move_data();
     void move();
+    void calculateGeometryPoints_data();
+    void calculateGeometryPoints();
+    void calculateLogGeometryPoints();
+    void geometryTransform_data();
+    void geometryTransform();
 };
 
 void tst_Domain::initTestCase()
@@ -728,5 +735,152 @@ void tst_Domain::move()
     TRY_COMPARE(spy2.count(), (dy != 0 ? 1 : 0));
 }
 
+void tst_Domain::calculateGeometryPoints_data()
+{
+    QTest::addColumn<bool>("reverseX");
+    QTest::addColumn<bool>("reverseY");
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("normal") << false << false << 101;
+    QTest::newRow("reverse x") << true << false << 7;
+    QTest::newRow("reverse y") << false << true << 6;
+    QTest::newRow("reverse xy") << true << true << 1;
+}
+
+void tst_Domain::calculateGeometryPoints()
+{
+    QFETCH(bool, reverseX);
+    QFETCH(bool, reverseY);
+    QFETCH(int, count);
+
+    XYDomain domain;
+    domain.setRange(1000000, 1000050, -20, 80);
+    domain.setSize(QSizeF(640, 480));
+    domain.setReverseX(reverseX);
+    domain.setReverseY(reverseY);
+
+    QVector<qreal> x(count);
+    QVector<qreal> y(count);
+    QVector<QPointF> points(count);
+    for (int i = 0; i < count; i++) {
+        x[i] = 1000000 + i * 0.5;
+        y[i] = (i % 13) * 7.5 - 20;
+        points[i] = QPointF(x[i], y[i]);
+    }
+
+    QVector<QPointF> vector = domain.calculateGeometryPoints(points);
+    QVector<QPointF> buffer(count);
+    QVector<QPointF> columns(count);
+    QVector<QPointF> uniform(count);
+    QVERIFY(domain.calculatePointsGeometry(points.constData(), count, buffer.data()));
+    QVERIFY(domain.calculateColumnsGeometry(x.constData(), y.constData(), count, columns.data()));
+    QVERIFY(domain.calculateUniformGeometry(x.first(), 0.5, 0, y.constData(), count, uniform.data()));
+    // Starting at an index maps the same x values as starting at the first point
+    const int index = count / 3;
+    QVector<QPointF> tail(count - index);
+    QVERIFY(domain.calculateUniformGeometry(x.first(), 0.5, index, y.constData() + index,
+                                            count - index, tail.data()));
+
+    QCOMPARE(vector.count(), count);
+    for (int i = 0; i < count; i++) {
+        bool ok;
+        const QPointF expected = domain.calculateGeometryPoint(points.at(i), ok);
+        QVERIFY(ok);
+        QCOMPARE(vector.at(i), expected);
+        QCOMPARE(buffer.at(i), expected);
+        QCOMPARE(columns.at(i), expected);
+        QCOMPARE(uniform.at(i), expected);
+        if (i >= index)
+            QCOMPARE(tail.at(i - index), expected);
+    }
+}
+
+void tst_Domain::calculateLogGeometryPoints()
+{
+    LogXLogYDomain domain;
+    domain.setRange(1, 1000, 1, 100);
+    domain.setSize(QSizeF(300, 200));
+
+    QVector<QPointF> points;
+    points << QPointF(1, 10) << QPointF(10, 0) << QPointF(100, 100)
+           << QPointF(-5, 1) << QPointF(1000, 1);
+
+    // Non-positive values become gaps instead of invalidating the whole series
+    const QVector<QPointF> result = domain.calculateGeometryPoints(points);
+    QCOMPARE(result.count(), points.count());
+    QVERIFY(qIsNaN(result.at(1).x()));
+    QVERIFY(qIsNaN(result.at(3).x()));
+
+    qreal logBaseX;
+    qreal logBaseY;
+    QVERIFY(domain.logBases(logBaseX, logBaseY));
+    QCOMPARE(logBaseX, qreal(10));
+    QCOMPARE(logBaseY, qreal(10));
+
+    // Points already in log space map with the affine transform only
+    QVector<QPointF> logPoints;
+    foreach (const QPointF &point, points) {
+        if (point.x() > 0 && point.y() > 0)
+            logPoints << QPointF(std::log10(point.x()), std::log10(point.y()));
+        else
+            logPoints << QPointF(qQNaN(), qQNaN());
+    }
+    QVector<QPointF> mapped(logPoints.count());
+    QVERIFY(domain.calculateLogPointsGeometry(logPoints.constData(), logPoints.count(), mapped.data()));
+
+    for (int i = 0; i < points.count(); i++) {
+        if (i == 1 || i == 3) {
+            QVERIFY(qIsNaN(mapped.at(i).x()));
+            continue;
+        }
+        bool ok;
+        const QPointF expected = domain.calculateGeometryPoint(points.at(i), ok);
+        QVERIFY(ok);
+        QCOMPARE(result.at(i), expected);
+        QCOMPARE(mapped.at(i), expected);
+    }
+}
+
+void tst_Domain::geometryTransform_data()
+{
+    QTest::addColumn<bool>("reverse");
+    QTest::addColumn<QRectF>("range");
+
+    QTest::newRow("pan") << false << QRectF(QPointF(20, -10), QPointF(120, 40));
+    QTest::newRow("zoom") << false << QRectF(QPointF(25, 5), QPointF(75, 30));
+    QTest::newRow("reversed pan and zoom") << true << QRectF(QPointF(-30, 0), QPointF(170, 25));
+}
+
+void tst_Domain::geometryTransform()
+{
+    QFETCH(bool, reverse);
+    QFETCH(QRectF, range);
+
+    XYDomain domain;
+    domain.setRange(0, 100, 0, 50);
+    domain.setSize(QSizeF(400, 300));
+    domain.setReverseX(reverse);
+    domain.setReverseY(reverse);
+
+    QVector<QPointF> points;
+    points << QPointF(0, 0) << QPointF(33, 12) << QPointF(100, 50) << QPointF(-40, 70);
+    DomainTransform before;
+    QVERIFY(domain.geometryTransform(before));
+    const QVector<QPointF> oldGeometry = domain.calculateGeometryPoints(points);
+
+    domain.setRange(range.left(), range.right(), range.top(), range.bottom());
+    DomainTransform after;
+    QVERIFY(domain.geometryTransform(after));
+    const QVector<QPointF> newGeometry = domain.calculateGeometryPoints(points);
+
+    // Old geometry maps onto new geometry without going through the domain again
+    const QTransform transform = after.transformFrom(before);
+    for (int i = 0; i < points.count(); i++) {
+        const QPointF mapped = transform.map(oldGeometry.at(i));
+        QVERIFY(qAbs(mapped.x() - newGeometry.at(i).x()) < 1e-9);
+        QVERIFY(qAbs(mapped.y() - newGeometry.at(i).y()) < 1e-9);
+    }
+}
+
 QTEST_MAIN(tst_Domain)
 #include "tst_domain.moc"
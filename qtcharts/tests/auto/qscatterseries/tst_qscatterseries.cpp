@@ -49,6 +49,7 @@ private slots:
     void pressedSignal();
     void releasedSignal();
     void doubleClickedSignal();
+    void densityRendering();
 
 protected:
     void pointsVisible_data();
@@ -140,6 +141,63 @@ void tst_QScatterSeries::scatterChangedSignals()
     TRY_COMPARE(colorSpy.count(), 2);
 }
 
+void tst_QScatterSeries::densityRendering()
+{
+    QScatterSeries *series = qobject_cast<QScatterSeries *>(m_series);
+    QVERIFY(series);
+    qRegisterMetaType<QGradientStops>("QGradientStops");
+    QSignalSpy renderingSpy(series, SIGNAL(densityRenderingChanged(bool)));
+    QSignalSpy cellSizeSpy(series, SIGNAL(densityCellSizeChanged(int)));
+    QSignalSpy gradientSpy(series, SIGNAL(densityGradientChanged(QGradientStops)));
+
+    QCOMPARE(series->densityRendering(), false);
+    QCOMPARE(series->densityCellSize(), 1);
+    QCOMPARE(series->densityGradient(), QGradientStops());
+
+    for (int i = 0; i < 1000; i++)
+        series->append(i % 37, i % 11);
+    m_chart->addSeries(series);
+    m_view->show();
+    QTest::qWaitForWindowShown(m_view);
+
+    // Rendering
+    series->setDensityRendering();
+    QCOMPARE(series->densityRendering(), true);
+    QCOMPARE(renderingSpy.count(), 1);
+    QCOMPARE(renderingSpy.takeFirst().at(0).toBool(), true);
+    series->setDensityRendering(true);
+    QCOMPARE(renderingSpy.count(), 0);
+
+    // Cell size, of at least one pixel
+    series->setDensityCellSize(0);
+    QCOMPARE(series->densityCellSize(), 1);
+    QCOMPARE(cellSizeSpy.count(), 0);
+    series->setProperty("densityCellSize", 4);
+    QCOMPARE(series->densityCellSize(), 4);
+    QCOMPARE(cellSizeSpy.count(), 1);
+    QCOMPARE(cellSizeSpy.takeFirst().at(0).toInt(), 4);
+
+    // Gradient
+    QGradientStops stops;
+    stops << QGradientStop(0.0, Qt::blue) << QGradientStop(1.0, Qt::red);
+    series->setProperty("densityGradient", QVariant::fromValue(stops));
+    QCOMPARE(series->densityGradient(), stops);
+    QCOMPARE(series->property("densityGradient").value<QGradientStops>(), stops);
+    QCOMPARE(gradientSpy.count(), 1);
+    QCOMPARE(gradientSpy.takeFirst().at(0).value<QGradientStops>(), stops);
+    series->setDensityGradient(stops);
+    QCOMPARE(gradientSpy.count(), 0);
+
+    series->append(1.0, 1.0);
+    QTest::qWait(50);
+    series->setDensityRendering(false);
+    QCOMPARE(series->densityRendering(), false);
+    QCOMPARE(renderingSpy.count(), 1);
+    QCOMPARE(renderingSpy.takeFirst().at(0).toBool(), false);
+    QTest::qWait(50);
+    m_chart->removeSeries(series);
+}
+
 void tst_QScatterSeries::pressedSignal()
 {
     SKIP_IF_CANNOT_TEST_MOUSE_EVENTS();
@@ -28,6 +28,7 @@
 ****************************************************************************/
 
 #include "tst_qxyseries.h"
+#include <QtCharts/QValueAxis>
 
 Q_DECLARE_METATYPE(QList<QPointF>)
 
@@ -206,9 +207,14 @@ void tst_QXYSeries::append_raw()
     QFETCH(QList<QPointF>, otherPoints);
     QSignalSpy spy0(m_series, SIGNAL(clicked(QPointF)));
     QSignalSpy addedSpy(m_series, SIGNAL(pointAdded(int)));
+    QSignalSpy bulkAddedSpy(m_series, SIGNAL(pointsAdded(int,int)));
     m_series->append(points);
     TRY_COMPARE(spy0.count(), 0);
-    TRY_COMPARE(addedSpy.count(), points.count());
+    TRY_COMPARE(addedSpy.count(), 0);
+    TRY_COMPARE(bulkAddedSpy.count(), 1);
+    QList<QVariant> arguments = bulkAddedSpy.takeFirst();
+    QCOMPARE(arguments.at(0).toInt(), 0);
+    QCOMPARE(arguments.at(1).toInt(), points.count());
     QCOMPARE(m_series->points(), points);
     QCOMPARE(m_series->pointsVector(), points.toVector());
 
@@ -219,6 +225,441 @@ void tst_QXYSeries::append_raw()
     }
 }
 
+void tst_QXYSeries::append_bulk_data()
+{
+    append_data();
+}
+
+void tst_QXYSeries::append_bulk()
+{
+    QFETCH(QList<QPointF>, points);
+    QFETCH(QList<QPointF>, otherPoints);
+    m_chart->addSeries(m_series);
+
+    QSignalSpy addedSpy(m_series, SIGNAL(pointAdded(int)));
+    QSignalSpy bulkAddedSpy(m_series, SIGNAL(pointsAdded(int,int)));
+
+    m_series->append(points.toVector());
+    TRY_COMPARE(bulkAddedSpy.count(), 1);
+    QList<QVariant> arguments = bulkAddedSpy.takeFirst();
+    QCOMPARE(arguments.at(0).toInt(), 0);
+    QCOMPARE(arguments.at(1).toInt(), points.count());
+
+    const QVector<QPointF> otherVector = otherPoints.toVector();
+    m_series->append(otherVector.constData(), otherVector.count());
+    TRY_COMPARE(bulkAddedSpy.count(), 1);
+    arguments = bulkAddedSpy.takeFirst();
+    QCOMPARE(arguments.at(0).toInt(), points.count());
+    QCOMPARE(arguments.at(1).toInt(), otherPoints.count());
+    QCOMPARE(m_series->points(), points + otherPoints);
+
+    // Invalid points are skipped and empty blocks do not emit anything
+    const QPointF invalid[] = { QPointF(qQNaN(), 1), QPointF(1, qInf()) };
+    m_series->append(invalid, 2);
+    m_series->append(QVector<QPointF>());
+    QCOMPARE(bulkAddedSpy.count(), 0);
+    QCOMPARE(addedSpy.count(), 0);
+    QCOMPARE(m_series->count(), points.count() + otherPoints.count());
+}
+
+void tst_QXYSeries::capacity()
+{
+    m_chart->addSeries(m_series);
+    QCOMPARE(m_series->capacity(), 0);
+
+    QSignalSpy addedSpy(m_series, SIGNAL(pointsAdded(int,int)));
+    QSignalSpy advancedSpy(m_series, SIGNAL(pointsAdvanced(int,int)));
+    QSignalSpy removedSpy(m_series, SIGNAL(pointsRemoved(int,int)));
+
+    QVector<QPointF> points;
+    for (int i = 0; i < 6; i++)
+        points << QPointF(i, i);
+    m_series->append(points);
+
+    // Shrinking below the current count removes the oldest points
+    m_series->setCapacity(4);
+    QCOMPARE(m_series->capacity(), 4);
+    TRY_COMPARE(removedSpy.count(), 1);
+    QList<QVariant> arguments = removedSpy.takeFirst();
+    QCOMPARE(arguments.at(0).toInt(), 0);
+    QCOMPARE(arguments.at(1).toInt(), 2);
+    QCOMPARE(m_series->pointsVector(), points.mid(2));
+
+    // Appending to a full series evicts the oldest points
+    m_series->append(QPointF(6, 6));
+    TRY_COMPARE(advancedSpy.count(), 1);
+    arguments = advancedSpy.takeFirst();
+    QCOMPARE(arguments.at(0).toInt(), 1);
+    QCOMPARE(arguments.at(1).toInt(), 1);
+    QCOMPARE(m_series->count(), 4);
+    QCOMPARE(m_series->at(0), QPointF(3, 3));
+    QCOMPARE(m_series->at(3), QPointF(6, 6));
+
+    // A block larger than the capacity keeps only its last points
+    addedSpy.clear();
+    QVector<QPointF> block;
+    for (int i = 7; i < 13; i++)
+        block << QPointF(i, i);
+    m_series->append(block);
+    TRY_COMPARE(advancedSpy.count(), 1);
+    arguments = advancedSpy.takeFirst();
+    QCOMPARE(arguments.at(0).toInt(), 4);
+    QCOMPARE(arguments.at(1).toInt(), 4);
+    QCOMPARE(addedSpy.count(), 0);
+    QCOMPARE(m_series->pointsVector(), block.mid(2));
+
+    // Edits keep the logical order of the points
+    m_series->replace(1, QPointF(20, 20));
+    QCOMPARE(m_series->at(1), QPointF(20, 20));
+    m_series->remove(0);
+    QCOMPARE(m_series->count(), 3);
+    QCOMPARE(m_series->at(0), QPointF(20, 20));
+    m_series->append(QList<QPointF>() << QPointF(13, 13));
+    QCOMPARE(addedSpy.count(), 1);
+    QCOMPARE(m_series->at(3), QPointF(13, 13));
+
+    // Removing the limit keeps the points
+    m_series->setCapacity(0);
+    QCOMPARE(m_series->capacity(), 0);
+    QCOMPARE(m_series->count(), 4);
+    QCOMPARE(m_series->at(0), QPointF(20, 20));
+}
+
+void tst_QXYSeries::storageLayout()
+{
+    m_chart->addSeries(m_series);
+    QCOMPARE(m_series->storageLayout(), QXYSeries::StorageLayoutPoints);
+    QVERIFY(!m_series->xData());
+    QVERIFY(!m_series->yData());
+
+    QVector<QPointF> points;
+    for (int i = 0; i < 5; i++)
+        points << QPointF(i, i * 10);
+    m_series->append(points);
+
+    // Switching the layout keeps the points
+    m_series->setStorageLayout(QXYSeries::StorageLayoutColumns);
+    QCOMPARE(m_series->storageLayout(), QXYSeries::StorageLayoutColumns);
+    QCOMPARE(m_series->pointsVector(), points);
+    QVERIFY(m_series->xData());
+    QVERIFY(m_series->yData());
+    for (int i = 0; i < points.count(); i++) {
+        QCOMPARE(m_series->xData()[i], points.at(i).x());
+        QCOMPARE(m_series->yData()[i], points.at(i).y());
+    }
+
+    // References returned by at() stay valid until the series is modified
+    const QPointF &first = m_series->at(0);
+    const QPointF &second = m_series->at(1);
+    QVERIFY(&first != &second);
+    QCOMPARE(first, points.at(0));
+    QCOMPARE(second, points.at(1));
+    QVERIFY(m_series->at(3) != m_series->at(4));
+
+    // Edits go through the columns
+    m_series->append(QPointF(5, 50));
+    m_series->insert(0, QPointF(-1, -10));
+    m_series->replace(1, QPointF(0, 1));
+    m_series->remove(2);
+    QCOMPARE(m_series->count(), 6);
+    QCOMPARE(m_series->at(0), QPointF(-1, -10));
+    QCOMPARE(m_series->at(1), QPointF(0, 1));
+    QCOMPARE(m_series->xData()[2], qreal(2));
+    QCOMPARE(m_series->yData()[5], qreal(50));
+
+    // Columns also work as a circular buffer
+    m_series->setCapacity(3);
+    m_series->append(QPointF(6, 60));
+    QCOMPARE(m_series->count(), 3);
+    QCOMPARE(m_series->xData()[0], qreal(4));
+    QCOMPARE(m_series->xData()[2], qreal(6));
+
+    m_series->setStorageLayout(QXYSeries::StorageLayoutPoints);
+    QCOMPARE(m_series->pointsVector(), QVector<QPointF>() << QPointF(4, 40) << QPointF(5, 50) << QPointF(6, 60));
+    QVERIFY(!m_series->xData());
+}
+
+void tst_QXYSeries::uniformSampling()
+{
+    m_chart->addSeries(m_series);
+    QSignalSpy replacedSpy(m_series, SIGNAL(pointsReplaced()));
+
+    QVector<QPointF> points;
+    for (int i = 0; i < 5; i++)
+        points << QPointF(10 + i * 2, i);
+    m_series->append(points);
+
+    // The sampling is derived from the first and last points
+    m_series->setStorageLayout(QXYSeries::StorageLayoutUniformX);
+    TRY_COMPARE(replacedSpy.count(), 1);
+    QCOMPARE(m_series->samplingOrigin(), qreal(10));
+    QCOMPARE(m_series->samplingInterval(), qreal(2));
+    QCOMPARE(m_series->pointsVector(), points);
+    QVERIFY(!m_series->xData());
+    QCOMPARE(m_series->yData()[4], qreal(4));
+
+    // Lookups compute the index from x
+    m_series->replace(QPointF(14, 2), QPointF(14, 20));
+    QCOMPARE(m_series->at(2), QPointF(14, 20));
+    m_series->remove(QPointF(15, 20));
+    QCOMPARE(m_series->count(), 5);
+
+    // The x coordinate of added points is implied
+    m_series->append(QPointF(0, 5));
+    QCOMPARE(m_series->at(5), QPointF(20, 5));
+
+    // Removing the first point keeps the x of the others
+    m_series->remove(0);
+    QCOMPARE(m_series->samplingOrigin(), qreal(12));
+    QCOMPARE(m_series->at(0), QPointF(12, 1));
+
+    // Evicting from a full series advances the origin
+    m_series->setCapacity(5);
+    m_series->append(QPointF(0, 6));
+    QCOMPARE(m_series->samplingOrigin(), qreal(14));
+    QCOMPARE(m_series->at(4), QPointF(22, 6));
+
+    m_series->setSampling(0, 0.5);
+    TRY_COMPARE(replacedSpy.count(), 2);
+    QCOMPARE(m_series->at(1), QPointF(0.5, 3));
+}
+
+void tst_QXYSeries::zoomSorted()
+{
+    QVector<QPointF> points;
+    for (int i = 0; i < 1000; i++)
+        points << QPointF(i, qreal(i % 10));
+    m_series->append(points);
+    m_series->setPointLabelsVisible(true);
+    m_chart->addSeries(m_series);
+    m_chart->createDefaultAxes();
+    m_view->show();
+    QTest::qWaitForWindowShown(m_view);
+
+    // Only a slice of the sorted series is visible
+    m_chart->axes(Qt::Horizontal).first()->setRange(500.5, 510.5);
+    QApplication::processEvents();
+
+    // Edits inside and outside of the visible slice
+    m_series->append(QPointF(1000, 0));
+    m_series->insert(505, QPointF(504.5, 5));
+    m_series->replace(0, QPointF(2000, 1));
+    m_series->remove(100);
+    m_series->removePoints(0, 10);
+    QApplication::processEvents();
+    QCOMPARE(m_series->count(), 991);
+    QCOMPARE(m_series->at(494), QPointF(504.5, 5));
+
+    m_chart->axes(Qt::Horizontal).first()->setRange(0, 2000);
+    QApplication::processEvents();
+}
+
+void tst_QXYSeries::extents()
+{
+    QVector<QPointF> points;
+    for (int i = 0; i < 100; i++)
+        points << QPointF(i, qreal(i % 10));
+    m_series->replace(points);
+    m_chart->addSeries(m_series);
+    m_chart->createDefaultAxes();
+
+    QValueAxis *axisX = qobject_cast<QValueAxis *>(m_chart->axes(Qt::Horizontal).first());
+    QValueAxis *axisY = qobject_cast<QValueAxis *>(m_chart->axes(Qt::Vertical).first());
+    QVERIFY(axisX);
+    QVERIFY(axisY);
+    QCOMPARE(axisX->min(), qreal(0));
+    QCOMPARE(axisX->max(), qreal(99));
+    QCOMPARE(axisY->min(), qreal(0));
+    QCOMPARE(axisY->max(), qreal(9));
+
+    // Modify the series after the extents have been computed once
+    m_series->replace(50, QPointF(50, 20));
+    m_series->remove(0);
+    m_series->remove(m_series->count() - 1);
+    m_series->append(QPointF(-5, -7));
+
+    m_chart->removeSeries(m_series);
+    m_chart->addSeries(m_series);
+    m_chart->createDefaultAxes();
+    axisX = qobject_cast<QValueAxis *>(m_chart->axes(Qt::Horizontal).first());
+    axisY = qobject_cast<QValueAxis *>(m_chart->axes(Qt::Vertical).first());
+    QVERIFY(axisX);
+    QVERIFY(axisY);
+    QCOMPARE(axisX->min(), qreal(-5));
+    QCOMPARE(axisX->max(), qreal(98));
+    QCOMPARE(axisY->min(), qreal(-7));
+    QCOMPARE(axisY->max(), qreal(20));
+}
+
+void tst_QXYSeries::ingestQueue()
+{
+    QCOMPARE(m_series->ingestCapacity(), 0);
+    QVERIFY(!m_series->enqueue(QPointF(0, 0)));
+
+    m_series->setIngestCapacity(1000);
+    QCOMPARE(m_series->ingestCapacity(), 1024);
+    m_chart->addSeries(m_series);
+
+    // Everything queued before the series thread gets to run is appended at once
+    QSignalSpy addedSpy(m_series, SIGNAL(pointsAdded(int,int)));
+    QVector<QPointF> points;
+    for (int i = 0; i < 1100; i++)
+        points << QPointF(i, i);
+    QCOMPARE(m_series->enqueue(points.constData(), 600), 600);
+    QCOMPARE(m_series->enqueue(points.constData() + 600, 500), 424);
+    QCOMPARE(m_series->count(), 0);
+    TRY_COMPARE(m_series->count(), 1024);
+    QCOMPARE(addedSpy.count(), 1);
+    QCOMPARE(m_series->at(1023), QPointF(1023, 1023));
+
+    // Producer thread
+    m_series->clear();
+    QThread *producer = QThread::create([this]() {
+        for (int i = 0; i < 5000; i++) {
+            while (!m_series->enqueue(QPointF(i, i)))
+                QThread::yieldCurrentThread();
+        }
+    });
+    producer->start();
+    TRY_COMPARE(m_series->count(), 5000);
+    QVERIFY(producer->wait());
+    delete producer;
+    for (int i = 0; i < 5000; i++)
+        QCOMPARE(m_series->at(i), QPointF(i, i));
+}
+
+void tst_QXYSeries::updateTransaction()
+{
+    QVector<QPointF> points;
+    for (int i = 0; i < 10; i++)
+        points << QPointF(i, i);
+    m_series->append(points);
+    m_chart->addSeries(m_series);
+
+    QSignalSpy replacedSpy(m_series, SIGNAL(pointReplaced(int)));
+    QSignalSpy rangeReplacedSpy(m_series, SIGNAL(pointRangeReplaced(int,int)));
+    QSignalSpy addedSpy(m_series, SIGNAL(pointsAdded(int,int)));
+    QSignalSpy allReplacedSpy(m_series, SIGNAL(pointsReplaced()));
+
+    // Replacements are merged into one range
+    QCOMPARE(m_series->isUpdating(), false);
+    m_series->beginUpdate();
+    QCOMPARE(m_series->isUpdating(), true);
+    for (int i = 5; i >= 2; i--)
+        m_series->replace(i, QPointF(i, -i));
+    QCOMPARE(m_series->at(3), QPointF(3, -3));
+    QCOMPARE(rangeReplacedSpy.count(), 0);
+    m_series->endUpdate();
+    QCOMPARE(m_series->isUpdating(), false);
+    QCOMPARE(replacedSpy.count(), 0);
+    QCOMPARE(rangeReplacedSpy.count(), 1);
+    QList<QVariant> arguments = rangeReplacedSpy.takeFirst();
+    QCOMPARE(arguments.at(0).toInt(), 2);
+    QCOMPARE(arguments.at(1).toInt(), 4);
+
+    // Nested transactions notify once at the outermost end
+    m_series->beginUpdate();
+    m_series->beginUpdate();
+    m_series->append(10, 10);
+    m_series->append(11, 11);
+    m_series->endUpdate();
+    m_series->append(12, 12);
+    QCOMPARE(addedSpy.count(), 0);
+    m_series->endUpdate();
+    QCOMPARE(addedSpy.count(), 1);
+    arguments = addedSpy.takeFirst();
+    QCOMPARE(arguments.at(0).toInt(), 10);
+    QCOMPARE(arguments.at(1).toInt(), 3);
+
+    // Changes that are not a single range replace all points
+    m_series->beginUpdate();
+    m_series->remove(0);
+    m_series->append(13, 13);
+    m_series->endUpdate();
+    QCOMPARE(allReplacedSpy.count(), 1);
+    QCOMPARE(m_series->count(), 13);
+
+    QTest::ignoreMessage(QtWarningMsg, "QAbstractSeries::endUpdate() called without a matching beginUpdate().");
+    m_series->endUpdate();
+    QCOMPARE(m_series->isUpdating(), false);
+}
+
+void tst_QXYSeries::asynchronousGeometry()
+{
+    // Large series compute their geometry on the thread pool
+    QVector<QPointF> points;
+    for (int i = 0; i < 100000; i++)
+        points << QPointF(i, qreal(i % 100));
+    m_series->append(points);
+    m_chart->addSeries(m_series);
+    m_chart->createDefaultAxes();
+    m_view->show();
+    QTest::qWaitForWindowShown(m_view);
+
+    // Changes arriving while a computation is in flight are merged
+    for (int i = 0; i < 10; i++) {
+        m_chart->axes(Qt::Horizontal).first()->setRange(i * 1000, i * 1000 + 50000);
+        m_series->replace(i, QPointF(i, -1));
+        m_view->resize(m_view->size() + QSize(1, 1));
+    }
+    m_series->append(QPointF(100000, 0));
+    QApplication::processEvents();
+    QCOMPARE(m_series->count(), 100001);
+    QCOMPARE(m_series->at(5), QPointF(5, -1));
+
+    // Items destroyed with a computation in flight discard its result
+    m_series->replace(points);
+    m_chart->removeSeries(m_series);
+    QThreadPool::globalInstance()->waitForDone();
+    QApplication::processEvents();
+    QCOMPARE(m_series->count(), 100000);
+}
+
+void tst_QXYSeries::nearestPoint()
+{
+    // Not in a chart
+    m_series->append(QPointF(0, 0));
+    QCOMPARE(m_series->nearestPoint(QPointF(0, 0), 10), -1);
+    QCOMPARE(m_series->pointsInRect(QRectF(-10, -10, 20, 20)), QVector<int>());
+    m_series->clear();
+
+    SKIP_ON_POLAR();
+
+    QVector<QPointF> points;
+    for (int i = 0; i < 100000; i++)
+        points << QPointF(i, qreal(i % 100));
+    m_series->append(points);
+    m_chart->addSeries(m_series);
+    m_chart->createDefaultAxes();
+    m_view->show();
+    QTest::qWaitForWindowShown(m_view);
+
+    QCOMPARE(m_series->nearestPoint(m_chart->mapToPosition(QPointF(0, 0), m_series), 1), 0);
+    const int index = m_series->nearestPoint(m_chart->mapToPosition(QPointF(5000, 0), m_series), 5);
+    QVERIFY(index >= 0);
+    QCOMPARE(m_series->at(index).y(), 0.0);
+
+    // Nothing within the distance above the series
+    const QPointF above = m_chart->mapToPosition(QPointF(50000, 100), m_series) - QPointF(0, 50);
+    QCOMPARE(m_series->nearestPoint(above, 10), -1);
+
+    // Points in a rectangle, in increasing index order
+    m_chart->axes(Qt::Horizontal).first()->setRange(0, 20);
+    QVector<int> inRect = m_series->pointsInRect(
+                QRectF(m_chart->mapToPosition(QPointF(9.5, 20), m_series),
+                       m_chart->mapToPosition(QPointF(12.5, 0), m_series)));
+    QCOMPARE(inRect, QVector<int>() << 10 << 11 << 12);
+
+    // The index follows the data and the axis ranges
+    m_series->replace(11, QPointF(11, 50));
+    inRect = m_series->pointsInRect(
+                QRectF(m_chart->mapToPosition(QPointF(9.5, 20), m_series),
+                       m_chart->mapToPosition(QPointF(12.5, 0), m_series)));
+    QCOMPARE(inRect, QVector<int>() << 10 << 12);
+    m_chart->axes(Qt::Horizontal).first()->setRange(5, 25);
+    QCOMPARE(m_series->nearestPoint(m_chart->mapToPosition(QPointF(12, 12), m_series), 1), 12);
+}
+
 void tst_QXYSeries::chart_append_data()
 {
     append_data();
@@ -65,6 +65,17 @@ private slots:
     void pointsVisible_raw();
     void append_raw_data();
     void append_raw();
+    void append_bulk_data();
+    void append_bulk();
+    void capacity();
+    void storageLayout();
+    void uniformSampling();
+    void zoomSorted();
+    void extents();
+    void ingestQueue();
+    void updateTransaction();
+    void asynchronousGeometry();
+    void nearestPoint();
     void append_chart_data();
     void append_chart();
     void append_chart_animation_data();
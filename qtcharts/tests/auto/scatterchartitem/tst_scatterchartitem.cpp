@@ -0,0 +1,291 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+#include <QtCharts/QChartView>
+#include <QtCharts/QScatterSeries>
+#include <QtCharts/QValueAxis>
+#include <private/qabstractseries_p.h>
+#include <private/qxyseries_p.h>
+#include <private/scatterchartitem_p.h>
+#include <private/scatterdensitygrid_p.h>
+#include <private/xydomain_p.h>
+#include <tst_definitions.h>
+
+QT_CHARTS_USE_NAMESPACE
+
+class tst_ScatterChartItem : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void stampsMarkers();
+    void markerAt();
+    void markerSignals();
+    void densityGrid();
+    void densityGridParallel();
+};
+
+// Scatter series giving access to its chart item
+class ScatterSeries : public QScatterSeries
+{
+public:
+    ScatterChartItem *item() { return static_cast<ScatterChartItem *>(d_ptr->chartItem()); }
+    const QXYSeriesPrivate *data() const
+    {
+        return static_cast<const QXYSeriesPrivate *>(d_ptr.data());
+    }
+};
+
+// Overlapping markers, of which the last one is on top, and a point off the x range whose
+// marker reaches into the plot area
+static const QPointF BottomPoint(5, 5);
+static const QPointF MiddlePoint(5, 5);
+static const QPointF TopPoint(5.1, 5);
+static const QPointF SinglePoint(2, 2);
+static const QPointF OffGridPoint(10.05, 8);
+
+// Adds a scatter series with the points above to the chart of view and shows the view
+static ScatterSeries *showSeries(QChartView &view)
+{
+    ScatterSeries *series = new ScatterSeries;
+    *series << BottomPoint << MiddlePoint << TopPoint << SinglePoint << OffGridPoint;
+    view.resize(800, 600);
+    view.chart()->legend()->setVisible(false);
+    view.chart()->addSeries(series);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(0, 10);
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setRange(0, 10);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    return series;
+}
+
+// Maps a series point to the item coordinates of the scatter item
+static QPointF itemPosition(QChartView &view, ScatterSeries *series, const QPointF &value)
+{
+    return series->item()->mapFromScene(
+                view.chart()->mapToScene(view.chart()->mapToPosition(value, series)));
+}
+
+// Maps a series point to the viewport of view
+static QPoint viewPosition(QChartView &view, ScatterSeries *series, const QPointF &value)
+{
+    return view.mapFromScene(view.chart()->mapToScene(view.chart()->mapToPosition(value, series)));
+}
+
+void tst_ScatterChartItem::stampsMarkers()
+{
+    // Plain and translating painters
+    QVERIFY(ScatterChartItem::stampsMarkers(QTransform(), 1));
+    QVERIFY(ScatterChartItem::stampsMarkers(QTransform::fromTranslate(10.5, 3), 1));
+    // High-DPI painters scale by the device pixel ratio
+    QVERIFY(ScatterChartItem::stampsMarkers(QTransform::fromScale(2, 2), 2));
+    QVERIFY(ScatterChartItem::stampsMarkers(QTransform::fromScale(1.5, 1.5).translate(4, 7), 1.5));
+    QVERIFY(!ScatterChartItem::stampsMarkers(QTransform::fromScale(2, 2), 1));
+    QVERIFY(!ScatterChartItem::stampsMarkers(QTransform(), 2));
+    // Views that zoom, mirror, rotate or shear paint the markers as shapes
+    QVERIFY(!ScatterChartItem::stampsMarkers(QTransform::fromScale(2, 1), 2));
+    QVERIFY(!ScatterChartItem::stampsMarkers(QTransform::fromScale(-1, 1), 1));
+    QVERIFY(!ScatterChartItem::stampsMarkers(QTransform().rotate(30), 1));
+    QVERIFY(!ScatterChartItem::stampsMarkers(QTransform::fromScale(2, 2).rotate(90), 2));
+    QVERIFY(!ScatterChartItem::stampsMarkers(QTransform().shear(0.5, 0), 1));
+}
+
+void tst_ScatterChartItem::markerAt()
+{
+    QChartView view;
+    ScatterSeries *series = showSeries(view);
+    ScatterChartItem *item = series->item();
+
+    // The last of the overlapping markers is painted on top
+    const QPointF top = itemPosition(view, series, TopPoint);
+    QCOMPARE(item->markerAt(QRectF(top, QSizeF(0, 0))), 2);
+    QVERIFY(item->contains(top));
+    // Next to the top marker only the two lower ones are hit
+    const QPointF bottom = itemPosition(view, series, BottomPoint);
+    const QPointF beside = bottom - QPointF(top.x() - bottom.x(), 0);
+    QCOMPARE(item->markerAt(QRectF(beside, QSizeF(0, 0))), 1);
+    QVERIFY(item->contains(beside));
+    QCOMPARE(item->markerAt(QRectF(itemPosition(view, series, SinglePoint), QSizeF(0, 0))), 3);
+    // A rectangle covering several markers hits the topmost one
+    QCOMPARE(item->markerAt(QRectF(itemPosition(view, series, SinglePoint), top).normalized()), 2);
+
+    // Markers of points off the axis ranges are not drawn and cannot be hit
+    const QPointF offGrid = itemPosition(view, series, OffGridPoint);
+    QCOMPARE(item->markerAt(QRectF(offGrid, QSizeF(0, 0))), -1);
+    QCOMPARE(item->markerAt(QRectF(offGrid - QPointF(4, 0), QSizeF(0, 0))), -1);
+    QVERIFY(!item->contains(offGrid));
+
+    // Empty space
+    const QPointF empty = itemPosition(view, series, QPointF(8, 2));
+    QCOMPARE(item->markerAt(QRectF(empty, QSizeF(0, 0))), -1);
+    QVERIFY(!item->contains(empty));
+
+    // Once the point is in range, its marker is hit
+    view.chart()->axes(Qt::Horizontal).first()->setRange(0, 11);
+    QCOMPARE(item->markerAt(QRectF(itemPosition(view, series, OffGridPoint), QSizeF(0, 0))), 4);
+}
+
+void tst_ScatterChartItem::markerSignals()
+{
+    SKIP_IF_CANNOT_TEST_MOUSE_EVENTS();
+
+    QChartView view;
+    ScatterSeries *series = showSeries(view);
+    QSignalSpy clickedSpy(series, SIGNAL(clicked(QPointF)));
+    QSignalSpy hoveredSpy(series, SIGNAL(hovered(QPointF,bool)));
+
+    // Clicks resolve to the topmost marker
+    QTest::mouseClick(view.viewport(), Qt::LeftButton, 0, viewPosition(view, series, TopPoint));
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1000);
+    QCOMPARE(clickedSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QPointF>(clickedSpy.takeFirst().at(0)), TopPoint);
+
+    QTest::mouseClick(view.viewport(), Qt::LeftButton, 0, viewPosition(view, series, SinglePoint));
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1000);
+    QCOMPARE(clickedSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QPointF>(clickedSpy.takeFirst().at(0)), SinglePoint);
+
+    // Off-grid markers do not take clicks
+    QTest::mouseClick(view.viewport(), Qt::LeftButton, 0, viewPosition(view, series, OffGridPoint));
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1000);
+    QCOMPARE(clickedSpy.count(), 0);
+
+    // Hovering enters and leaves the topmost marker under the cursor
+    hoveredSpy.clear();
+    QTest::mouseMove(view.viewport(), viewPosition(view, series, TopPoint));
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1000);
+    QTRY_COMPARE(hoveredSpy.count(), 1);
+    QList<QVariant> arguments = hoveredSpy.takeFirst();
+    QCOMPARE(qvariant_cast<QPointF>(arguments.at(0)), TopPoint);
+    QCOMPARE(arguments.at(1).toBool(), true);
+
+    QTest::mouseMove(view.viewport(), viewPosition(view, series, QPointF(8, 2)));
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1000);
+    QTRY_COMPARE(hoveredSpy.count(), 1);
+    arguments = hoveredSpy.takeFirst();
+    QCOMPARE(qvariant_cast<QPointF>(arguments.at(0)), TopPoint);
+    QCOMPARE(arguments.at(1).toBool(), false);
+}
+
+void tst_ScatterChartItem::densityGrid()
+{
+    // Plot area of 100 x 50 pixels showing the same ranges, counted in 10 x 5 cells
+    XYDomain domain;
+    domain.setSize(QSizeF(100, 50));
+    domain.setRange(0, 100, 0, 50);
+    ScatterSeries series;
+    series << QPointF(5, 45) << QPointF(2, 48) << QPointF(9, 41)  // top left cell
+           << QPointF(95, 5) << QPointF(100, 0)                    // bottom right cell
+           << QPointF(55, 25)                                      // middle cell
+           << QPointF(150, 10) << QPointF(50, -1);                 // outside the plot area
+
+    ScatterDensityGrid grid;
+    QVERIFY(!grid.isValid());
+    QVERIFY(grid.build(series.data(), &domain, 10));
+    QVERIFY(grid.isValid());
+    QCOMPARE(grid.columns(), 10);
+    QCOMPARE(grid.rows(), 5);
+    QCOMPARE(grid.pointCount(), 8);
+    QCOMPARE(grid.count(0, 0), quint32(3));
+    QCOMPARE(grid.count(9, 4), quint32(2));
+    QCOMPARE(grid.count(5, 2), quint32(1));
+    QCOMPARE(grid.maxCount(), quint32(3));
+    quint32 total = 0;
+    for (int row = 0; row < grid.rows(); row++) {
+        for (int column = 0; column < grid.columns(); column++)
+            total += grid.count(column, row);
+    }
+    QCOMPARE(total, quint32(6));
+
+    // Appended points are added to the counts
+    series << QPointF(51, 21) << QPointF(59, 29) << QPointF(58, 22) << QPointF(200, 200);
+    QVERIFY(grid.append(series.data(), &domain, 8));
+    QCOMPARE(grid.pointCount(), 12);
+    QCOMPARE(grid.count(5, 2), quint32(4));
+    QCOMPARE(grid.count(0, 0), quint32(3));
+    QCOMPARE(grid.maxCount(), quint32(4));
+
+    // The image has a pixel per cell, transparent where there are no points
+    const QImage image = grid.image(QGradientStops(), Qt::red);
+    QCOMPARE(image.size(), QSize(10, 5));
+    QVERIFY(qAlpha(image.pixel(5, 2)) > qAlpha(image.pixel(9, 4)));
+    QVERIFY(qAlpha(image.pixel(9, 4)) > 0);
+    QCOMPARE(qAlpha(image.pixel(1, 0)), 0);
+
+    // Appending anything but the points after the counted ones, or to a plot area of another
+    // size, has to build the grid again
+    QVERIFY(!grid.append(series.data(), &domain, 10));
+    QCOMPARE(grid.pointCount(), 12);
+    domain.setSize(QSizeF(100, 60));
+    QVERIFY(!grid.append(series.data(), &domain, 12));
+    QVERIFY(grid.build(series.data(), &domain, 10));
+    QCOMPARE(grid.rows(), 6);
+    grid.invalidate();
+    QVERIFY(!grid.isValid());
+    QVERIFY(!grid.append(series.data(), &domain, 12));
+    QVERIFY(grid.image(QGradientStops(), Qt::red).isNull());
+}
+
+void tst_ScatterChartItem::densityGridParallel()
+{
+    // Enough points to be counted in chunks, each cell of 10 x 10 pixels getting 2000 of them
+    XYDomain domain;
+    domain.setSize(QSizeF(100, 50));
+    domain.setRange(0, 100, 0, 50);
+    ScatterSeries series;
+    QVector<QPointF> points;
+    for (int i = 0; i < 100000; i++)
+        points << QPointF(i % 100 + 0.5, (i / 100) % 50 + 0.5);
+    series.replace(points);
+
+    ScatterDensityGrid grid;
+    QVERIFY(grid.build(series.data(), &domain, 10));
+    QCOMPARE(grid.pointCount(), points.count());
+    QCOMPARE(grid.maxCount(), quint32(2000));
+    for (int row = 0; row < grid.rows(); row++) {
+        for (int column = 0; column < grid.columns(); column++)
+            QCOMPARE(grid.count(column, row), quint32(2000));
+    }
+
+    // Appending a chunk's worth of points counts them as well
+    series.append(points);
+    QVERIFY(grid.append(series.data(), &domain, points.count()));
+    QCOMPARE(grid.pointCount(), 2 * points.count());
+    QCOMPARE(grid.maxCount(), quint32(4000));
+    QCOMPARE(grid.count(3, 2), quint32(4000));
+}
+
+QTEST_MAIN(tst_ScatterChartItem)
+#include "tst_scatterchartitem.moc"
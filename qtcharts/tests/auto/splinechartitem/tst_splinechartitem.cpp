@@ -0,0 +1,314 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+#include <QtCharts/QChartView>
+#include <QtCharts/QSplineSeries>
+#include <QtCharts/QValueAxis>
+#include <private/qabstractseries_p.h>
+#include <private/splinechartitem_p.h>
+
+QT_CHARTS_USE_NAMESPACE
+
+class tst_SplineChartItem : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void updateControlPoints_data();
+    void updateControlPoints();
+    void updateControlPointsFallback();
+    void seriesUpdates();
+    void lazyShape();
+};
+
+// Spline series giving access to its chart item
+class SplineSeries : public QSplineSeries
+{
+public:
+    SplineChartItem *item() { return static_cast<SplineChartItem *>(d_ptr->chartItem()); }
+};
+
+// Geometry points of a wavy line
+static QVector<QPointF> wave(int first, int count)
+{
+    QVector<QPointF> points;
+    for (int i = first; i < first + count; i++)
+        points.append(QPointF(i * 3.0, 200 + 150 * qSin(i * 0.37) + 40 * qCos(i * 1.3)));
+    return points;
+}
+
+// Compares control points with a tolerance relative to the geometry size
+static bool compareControlPoints(const QVector<QPointF> &actual, const QVector<QPointF> &expected)
+{
+    if (actual.count() != expected.count()) {
+        qWarning() << "got" << actual.count() << "control points, expected" << expected.count();
+        return false;
+    }
+    for (int i = 0; i < actual.count(); i++) {
+        if (qAbs(actual.at(i).x() - expected.at(i).x()) > 1e-9
+                || qAbs(actual.at(i).y() - expected.at(i).y()) > 1e-9) {
+            qWarning() << "control point" << i << "is" << actual.at(i) << "expected" << expected.at(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_SplineChartItem::updateControlPoints_data()
+{
+    QTest::addColumn<int>("dropped");
+    QTest::addColumn<int>("index");
+    QTest::addColumn<int>("removed");
+    QTest::addColumn<int>("added");
+    QTest::addColumn<bool>("copies");
+
+    // Changes from the tail, which only leave a head to take over
+    QTest::newRow("append") << 0 << 500 << 0 << 1 << false;
+    QTest::newRow("append many") << 0 << 500 << 0 << 40 << false;
+    QTest::newRow("remove last") << 0 << 499 << 1 << 0 << false;
+    QTest::newRow("replace last") << 0 << 499 << 1 << 1 << false;
+    QTest::newRow("replace near tail") << 0 << 490 << 1 << 1 << false;
+    // Local changes between a head and a tail
+    QTest::newRow("replace") << 0 << 250 << 1 << 1 << false;
+    QTest::newRow("replace range") << 0 << 200 << 10 << 10 << false;
+    QTest::newRow("insert") << 0 << 250 << 0 << 3 << false;
+    QTest::newRow("remove") << 0 << 250 << 2 << 0 << false;
+    // Changes at the head, which only leave a tail to take over
+    QTest::newRow("replace first") << 0 << 0 << 1 << 1 << false;
+    QTest::newRow("replace near head") << 0 << 5 << 1 << 1 << false;
+    QTest::newRow("insert first") << 0 << 0 << 0 << 1 << false;
+    QTest::newRow("remove first") << 0 << 0 << 1 << 0 << false;
+    // Points dropped from the head and appended, as in a ring buffer
+    QTest::newRow("advance") << 1 << 499 << 0 << 1 << false;
+    QTest::newRow("advance many") << 50 << 450 << 0 << 50 << false;
+    // Inserted copies of the neighbouring points, so that the unchanged head and tail
+    // overlap when aligned by comparing points
+    QTest::newRow("insert copies") << 0 << 250 << 0 << 2 << true;
+    QTest::newRow("remove copies") << 0 << 251 << 2 << 0 << true;
+}
+
+void tst_SplineChartItem::updateControlPoints()
+{
+    QFETCH(int, dropped);
+    QFETCH(int, index);
+    QFETCH(int, removed);
+    QFETCH(int, added);
+    QFETCH(bool, copies);
+
+    QVector<QPointF> oldPoints = wave(0, 500);
+    if (copies) {
+        // The points removed by the change are copies of their neighbours
+        for (int i = 0; i < removed; i++)
+            oldPoints.insert(index, oldPoints.at(index - 1));
+        oldPoints.remove(oldPoints.count() - removed, removed);
+    }
+
+    QVector<QPointF> newPoints = oldPoints.mid(dropped);
+    newPoints.remove(index, removed);
+    for (int i = 0; i < added; i++) {
+        const QPointF point = copies ? newPoints.at(index) : QPointF(index * 3.0 + i, 50.0 + 7 * i);
+        newPoints.insert(index + i, point);
+    }
+
+    QVector<QPointF> controlPoints = SplineChartItem::calculateControlPoints(oldPoints);
+    const XYGeometryChange change = { dropped, index, removed, added };
+    int firstRow = -1;
+    int lastRow = -1;
+    QVERIFY(SplineChartItem::updateControlPoints(newPoints, controlPoints, change,
+                                                 &firstRow, &lastRow));
+    QVERIFY(compareControlPoints(controlPoints,
+                                 SplineChartItem::calculateControlPoints(newPoints)));
+
+    // Only the segments next to a single change are solved again
+    QVERIFY(firstRow >= 0 && firstRow <= lastRow && lastRow < newPoints.count() - 1);
+    if (dropped == 0)
+        QVERIFY(lastRow - firstRow < 2 * 32 + 4 + added + removed);
+}
+
+void tst_SplineChartItem::updateControlPointsFallback()
+{
+    const QVector<QPointF> oldPoints = wave(0, 500);
+    QVector<QPointF> newPoints = oldPoints;
+    newPoints.append(QPointF(1500, 10));
+    const QVector<QPointF> oldControlPoints = SplineChartItem::calculateControlPoints(oldPoints);
+    int firstRow = -1;
+    int lastRow = -1;
+
+    // Recalculated points
+    QVector<QPointF> controlPoints = oldControlPoints;
+    XYGeometryChange change = { -1, 0, 0, 0 };
+    QVERIFY(!SplineChartItem::updateControlPoints(newPoints, controlPoints, change,
+                                                  &firstRow, &lastRow));
+
+    // A change not matching the number of points
+    controlPoints = oldControlPoints;
+    change.dropped = 0;
+    change.index = 500;
+    change.added = 2;
+    QVERIFY(!SplineChartItem::updateControlPoints(newPoints, controlPoints, change,
+                                                  &firstRow, &lastRow));
+
+    // A change covering most of the points
+    controlPoints = oldControlPoints;
+    newPoints = wave(1000, 500);
+    change.index = 0;
+    change.removed = 400;
+    change.added = 400;
+    QVERIFY(!SplineChartItem::updateControlPoints(newPoints, controlPoints, change,
+                                                  &firstRow, &lastRow));
+
+    // A gap next to the change
+    controlPoints = oldControlPoints;
+    newPoints = oldPoints;
+    newPoints[250] = QPointF(qQNaN(), qQNaN());
+    change.index = 250;
+    change.removed = 1;
+    change.added = 1;
+    QVERIFY(!SplineChartItem::updateControlPoints(newPoints, controlPoints, change,
+                                                  &firstRow, &lastRow));
+
+    // Too few points for the influence range
+    const QVector<QPointF> fewPoints = wave(0, 100);
+    controlPoints = SplineChartItem::calculateControlPoints(fewPoints);
+    newPoints = fewPoints;
+    newPoints.append(QPointF(300, 10));
+    change.index = 100;
+    change.removed = 0;
+    change.added = 1;
+    QVERIFY(!SplineChartItem::updateControlPoints(newPoints, controlPoints, change,
+                                                  &firstRow, &lastRow));
+}
+
+void tst_SplineChartItem::seriesUpdates()
+{
+    QChartView view;
+    view.resize(1200, 600);
+    SplineSeries *series = new SplineSeries;
+    for (int i = 0; i < 300; i++)
+        series->append(i, qSin(i * 0.37));
+    view.chart()->addSeries(series);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(-10, 400);
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setRange(-5, 5);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+
+    SplineChartItem *item = series->item();
+    QCOMPARE(item->geometryPoints().count(), series->count());
+
+    // Each change is applied incrementally and must give the control points of a full
+    // calculation, and bounds containing the whole spline
+    for (int step = 0; step < 7; step++) {
+        switch (step) {
+        case 0: series->append(300, 2); break;
+        case 1: series->append(301, -2); break;
+        case 2: series->replace(150, QPointF(150, 3)); break;
+        case 3: series->replace(299, QPointF(299, -3)); break;
+        case 4: series->insert(100, QPointF(99.5, 1)); break;
+        case 5: series->remove(200); break;
+        case 6: series->replace(0, QPointF(0, 4)); break;
+        }
+        const QVector<QPointF> points = item->geometryPoints();
+        QCOMPARE(points.count(), series->count());
+        const QVector<QPointF> controlPoints = item->controlGeometryPoints();
+        QVERIFY(compareControlPoints(controlPoints,
+                                     SplineChartItem::calculateControlPoints(points)));
+
+        QPainterPath path(points.first());
+        for (int i = 1; i < points.count(); i++)
+            path.cubicTo(controlPoints.at(2 * i - 2), controlPoints.at(2 * i - 1), points.at(i));
+        QVERIFY(item->boundingRect().contains(path.boundingRect()));
+    }
+}
+
+void tst_SplineChartItem::lazyShape()
+{
+    QChartView view;
+    view.resize(600, 400);
+    SplineSeries *series = new SplineSeries;
+    series->setPen(QPen(Qt::black, 4));
+    for (int i = 0; i < 100; i++)
+        series->append(i, qSin(i * 0.37));
+    view.chart()->addSeries(series);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(-10, 110);
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setRange(-5, 15);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+
+    SplineChartItem *item = series->item();
+    QPainterPathStroker stroker(series->pen());
+
+    // Nothing is connected to the interaction signals, so the item takes no part in hit testing
+    QVERIFY(item->shape().isEmpty());
+    QVERIFY(!item->boundingRect().isEmpty());
+    QVERIFY(item->boundingRect().contains(stroker.createStroke(item->path()).boundingRect()));
+
+    // Connecting clicked() builds the outline of the spline on demand
+    QMetaObject::Connection clicked = connect(series, &QXYSeries::clicked, this, [](const QPointF &) {});
+    QPainterPath shape = item->shape();
+    QVERIFY(!shape.isEmpty());
+    QVector<QPointF> points = item->geometryPoints();
+    QCOMPARE(points.count(), series->count());
+    for (const QPointF &point : points)
+        QVERIFY(shape.contains(point));
+    const QPointF oldPoint = points.at(50);
+
+    // Replacing the points rebuilds the outline at the new points
+    QVector<QPointF> replacement;
+    for (int i = 0; i < 100; i++)
+        replacement.append(QPointF(i, 10 + qSin(i * 0.37)));
+    series->replace(replacement);
+    shape = item->shape();
+    points = item->geometryPoints();
+    QCOMPARE(points.count(), replacement.count());
+    for (const QPointF &point : points)
+        QVERIFY(shape.contains(point));
+    QVERIFY(!shape.contains(oldPoint));
+    QVERIFY(item->boundingRect().contains(stroker.createStroke(item->path()).boundingRect()));
+
+    // Only interaction receivers matter, hovered() counts as well
+    disconnect(clicked);
+    QVERIFY(item->shape().isEmpty());
+    connect(series, &QXYSeries::hovered, this, [](const QPointF &, bool) {});
+    QVERIFY(item->shape().contains(points.at(50)));
+}
+
+QTEST_MAIN(tst_SplineChartItem)
+#include "tst_splinechartitem.moc"
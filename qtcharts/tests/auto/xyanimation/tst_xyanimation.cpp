@@ -0,0 +1,456 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QSplineSeries>
+#include <QtCharts/QValueAxis>
+#include <private/qabstractseries_p.h>
+#include <private/splinechartitem_p.h>
+#include <private/xyanimation_p.h>
+
+QT_CHARTS_USE_NAMESPACE
+
+class tst_XYAnimation : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void interpolate_data();
+    void interpolate();
+    void finalGeometry_data();
+    void finalGeometry();
+    void interruptedRemove_data();
+    void interruptedRemove();
+    void frameBuffers();
+    void splineFrames();
+};
+
+// Series giving access to its chart item
+template <class T>
+class Series : public T
+{
+public:
+    XYChart *item() { return static_cast<XYChart *>(this->d_ptr->chartItem()); }
+};
+typedef Series<QLineSeries> LineSeries;
+typedef Series<QSplineSeries> SplineSeries;
+
+// Animation giving access to the interpolation and the animation types
+class TestAnimation : public XYAnimation
+{
+public:
+    using XYAnimation::interpolate;
+    enum Type {
+        Add = AddPointAnimation,
+        Remove = RemovePointAnimation,
+        Replace = ReplacePointAnimation,
+        New = NewAnimation
+    };
+};
+
+// Changes applied alike to an animated and a non-animated series
+enum Operation {
+    Append,
+    AppendBlock,
+    Insert,
+    Remove,
+    RemoveFirst,
+    RemoveBlock,
+    Replace,
+    ReplaceAll
+};
+
+Q_DECLARE_METATYPE(Operation)
+
+static const int Duration = 100;
+
+// Points of a wavy line
+static QVector<QPointF> wave(int count)
+{
+    QVector<QPointF> points;
+    for (int i = 0; i < count; i++)
+        points.append(QPointF(i, 4 * qSin(i * 0.5)));
+    return points;
+}
+
+// Adds a line or spline series of a wavy line to the chart of view and shows the view. The
+// series animations are enabled afterwards if animated, so that the series appears at once.
+static QXYSeries *showSeries(QChartView &view, bool spline, bool animated,
+                             int duration = Duration)
+{
+    QXYSeries *series = spline ? static_cast<QXYSeries *>(new SplineSeries)
+                               : static_cast<QXYSeries *>(new LineSeries);
+    series->append(wave(20));
+    view.resize(800, 600);
+    view.chart()->legend()->setVisible(false);
+    view.chart()->addSeries(series);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(-1, 25);
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setRange(-6, 6);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    if (animated) {
+        view.chart()->setAnimationDuration(duration);
+        view.chart()->setAnimationEasingCurve(QEasingCurve::Linear);
+        view.chart()->setAnimationOptions(QChart::SeriesAnimations);
+    }
+    return series;
+}
+
+static XYChart *chartItem(QXYSeries *series)
+{
+    if (series->type() == QAbstractSeries::SeriesTypeSpline)
+        return static_cast<SplineSeries *>(series)->item();
+    return static_cast<LineSeries *>(series)->item();
+}
+
+static XYAnimation *animation(QXYSeries *series)
+{
+    return static_cast<XYAnimation *>(chartItem(series)->animation());
+}
+
+static void apply(QXYSeries *series, Operation operation)
+{
+    switch (operation) {
+    case Append:
+        series->append(20, 1.5);
+        break;
+    case AppendBlock:
+        series->append(QVector<QPointF>() << QPointF(20, 1) << QPointF(21, -1) << QPointF(22, 2));
+        break;
+    case Insert:
+        series->insert(7, QPointF(6.5, 3));
+        break;
+    case Remove:
+        series->remove(9);
+        break;
+    case RemoveFirst:
+        series->remove(0);
+        break;
+    case RemoveBlock:
+        series->removePoints(4, 3);
+        break;
+    case Replace:
+        series->replace(5, QPointF(5, 5));
+        break;
+    case ReplaceAll: {
+        QVector<QPointF> points = wave(12);
+        for (int i = 0; i < points.count(); i++)
+            points[i].ry() = -points.at(i).y();
+        series->replace(points);
+        break;
+    }
+    }
+}
+
+// Compares points with a tolerance for the rounding of the interpolation
+static bool comparePoints(const QVector<QPointF> &actual, const QVector<QPointF> &expected)
+{
+    if (actual.count() != expected.count()) {
+        qWarning() << "got" << actual.count() << "points, expected" << expected.count();
+        return false;
+    }
+    for (int i = 0; i < actual.count(); i++) {
+        if (qAbs(actual.at(i).x() - expected.at(i).x()) > 1e-6
+                || qAbs(actual.at(i).y() - expected.at(i).y()) > 1e-6) {
+            qWarning() << "point" << i << "is" << actual.at(i) << "expected" << expected.at(i);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Positions of the elements of path
+static QVector<QPointF> pathElements(const QPainterPath &path)
+{
+    QVector<QPointF> elements;
+    for (int i = 0; i < path.elementCount(); i++)
+        elements.append(path.elementAt(i));
+    return elements;
+}
+
+// Points linearly interpolated between start and end at progress, as the scalar code does
+static QVector<QPointF> lerp(const QVector<QPointF> &start, const QVector<QPointF> &end,
+                             qreal progress)
+{
+    QVector<QPointF> points;
+    for (int i = 0; i < end.count(); i++) {
+        points.append(QPointF(start.at(i).x() + (end.at(i).x() - start.at(i).x()) * progress,
+                              start.at(i).y() + (end.at(i).y() - start.at(i).y()) * progress));
+    }
+    return points;
+}
+
+void tst_XYAnimation::interpolate_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("offset");
+
+    // Odd counts leave a tail after the pairs of points processed as vectors
+    for (int count = 0; count <= 9; count++) {
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 points").arg(count))) << count << 0;
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 points, offset").arg(count)))
+                << count << 1;
+    }
+    QTest::newRow("33 points") << 33 << 0;
+    QTest::newRow("1001 points, offset") << 1001 << 1;
+}
+
+void tst_XYAnimation::interpolate()
+{
+    QFETCH(int, count);
+    QFETCH(int, offset);
+
+    QVector<QPointF> start;
+    QVector<QPointF> end;
+    for (int i = 0; i < count + offset; i++) {
+        start.append(QPointF(i * 1.5 - 7, 100 * qSin(i * 0.3)));
+        end.append(QPointF(i * 0.25 + 3, -50 * qCos(i * 0.7)));
+    }
+
+    const QPointF sentinel(-12345, 12345);
+    const qreal progresses[] = { 0, 0.3, 0.5, 0.999, 1 };
+    for (const qreal progress : progresses) {
+        // The points after the count must not be written
+        QVector<QPointF> result(count + offset + 1, sentinel);
+        TestAnimation::interpolate(start.constData() + offset, end.constData() + offset, count,
+                               progress, result.data() + offset);
+        const QVector<QPointF> expected = lerp(start, end, progress);
+        for (int i = 0; i < offset; i++)
+            QCOMPARE(result.at(i), sentinel);
+        for (int i = offset; i < count + offset; i++) {
+            QCOMPARE(result.at(i).x(), expected.at(i).x());
+            QCOMPARE(result.at(i).y(), expected.at(i).y());
+        }
+        QCOMPARE(result.last(), sentinel);
+    }
+}
+
+void tst_XYAnimation::finalGeometry_data()
+{
+    QTest::addColumn<bool>("spline");
+    QTest::addColumn<Operation>("operation");
+    QTest::addColumn<int>("type");
+
+    for (int spline = 0; spline <= 1; spline++) {
+        const char *name = spline ? "spline" : "line";
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 append").arg(name)))
+                << bool(spline) << Append << int(TestAnimation::Add);
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 append block").arg(name)))
+                << bool(spline) << AppendBlock << int(TestAnimation::Add);
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 insert").arg(name)))
+                << bool(spline) << Insert << int(TestAnimation::Add);
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 remove").arg(name)))
+                << bool(spline) << Remove << int(TestAnimation::Remove);
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 remove first").arg(name)))
+                << bool(spline) << RemoveFirst << int(TestAnimation::Remove);
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 remove block").arg(name)))
+                << bool(spline) << RemoveBlock << int(TestAnimation::New);
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 replace").arg(name)))
+                << bool(spline) << Replace << int(TestAnimation::Replace);
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 replace all").arg(name)))
+                << bool(spline) << ReplaceAll << int(TestAnimation::New);
+    }
+}
+
+void tst_XYAnimation::finalGeometry()
+{
+    QFETCH(bool, spline);
+    QFETCH(Operation, operation);
+    QFETCH(int, type);
+
+    QChartView view;
+    QChartView animatedView;
+    QXYSeries *series = showSeries(view, spline, false);
+    QXYSeries *animated = showSeries(animatedView, spline, true);
+    QVERIFY(animation(animated));
+    QCOMPARE(chartItem(animated)->geometryPoints(), chartItem(series)->geometryPoints());
+
+    // The animation starts with the next event loop pass, so the spy cannot miss its end
+    apply(series, operation);
+    apply(animated, operation);
+    QSignalSpy finishedSpy(animation(animated), SIGNAL(finished()));
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(int(animation(animated)->animationType()), type);
+
+    // The last frame, and for removals the point that was kept to animate them, end at the
+    // geometry of the series updated without an animation
+    QVERIFY(comparePoints(chartItem(animated)->geometryPoints(),
+                          chartItem(series)->geometryPoints()));
+    if (spline) {
+        SplineChartItem *animatedItem = static_cast<SplineChartItem *>(chartItem(animated));
+        SplineChartItem *item = static_cast<SplineChartItem *>(chartItem(series));
+        QVERIFY(comparePoints(animatedItem->controlGeometryPoints(), item->controlGeometryPoints()));
+    }
+}
+
+void tst_XYAnimation::interruptedRemove_data()
+{
+    QTest::addColumn<bool>("spline");
+
+    QTest::newRow("line") << false;
+    QTest::newRow("spline") << true;
+}
+
+void tst_XYAnimation::interruptedRemove()
+{
+    QFETCH(bool, spline);
+
+    QChartView view;
+    QChartView animatedView;
+    QXYSeries *series = showSeries(view, spline, false);
+    QXYSeries *animated = showSeries(animatedView, spline, true, 2000);
+    XYAnimation *xyAnimation = animation(animated);
+
+    // Remove a point and interrupt its animation halfway with another removal, which first
+    // drops the point kept to animate the first one
+    series->remove(9);
+    animated->remove(9);
+    QTRY_COMPARE(chartItem(animated)->geometryPoints().count(), series->count() + 1);
+    QCOMPARE(xyAnimation->state(), QAbstractAnimation::Running);
+
+    series->remove(2);
+    animated->remove(2);
+    QCOMPARE(chartItem(animated)->geometryPoints().count(), series->count());
+    QSignalSpy finishedSpy(xyAnimation, SIGNAL(finished()));
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(int(xyAnimation->animationType()), int(TestAnimation::Remove));
+    QVERIFY(comparePoints(chartItem(animated)->geometryPoints(),
+                          chartItem(series)->geometryPoints()));
+}
+
+void tst_XYAnimation::frameBuffers()
+{
+    QChartView view;
+    QChartView animatedView;
+    QXYSeries *series = showSeries(view, false, false);
+    QXYSeries *animated = showSeries(animatedView, false, true, 1000);
+    XYChart *item = chartItem(animated);
+    XYAnimation *xyAnimation = animation(animated);
+
+    const QVector<QPointF> start = item->geometryPoints();
+    series->replace(5, QPointF(5, 5));
+    animated->replace(5, QPointF(5, 5));
+    const QVector<QPointF> end = chartItem(series)->geometryPoints();
+
+    // Apply the frames of a paused animation one by one
+    QTRY_COMPARE(xyAnimation->state(), QAbstractAnimation::Running);
+    xyAnimation->pause();
+    const QPointF *buffers[4];
+    for (int frame = 0; frame < 4; frame++) {
+        const qreal progress = (frame + 1) / 8.0;
+        xyAnimation->setCurrentTime(qRound(1000 * progress));
+        xyAnimation->updateFrame();
+        // No copy of the frame may outlive the check, or the next frame could not reuse it
+        const QVector<QPointF> points = item->geometryPoints();
+        QVERIFY(comparePoints(points, lerp(start, end, progress)));
+        buffers[frame] = points.constData();
+    }
+    // Once the first two frames have replaced the points of the series, the frames alternate
+    // between two buffers
+    QVERIFY(buffers[1] != buffers[0]);
+    QCOMPARE(buffers[2], buffers[0]);
+    QCOMPARE(buffers[3], buffers[1]);
+
+    // Running to the end applies the last frame
+    xyAnimation->resume();
+    xyAnimation->setCurrentTime(xyAnimation->duration());
+    QCOMPARE(xyAnimation->state(), QAbstractAnimation::Stopped);
+    QVERIFY(comparePoints(item->geometryPoints(), end));
+}
+
+void tst_XYAnimation::splineFrames()
+{
+    QChartView view;
+    QChartView animatedView;
+    SplineSeries *series = static_cast<SplineSeries *>(showSeries(view, true, false));
+    SplineSeries *animated = static_cast<SplineSeries *>(showSeries(animatedView, true, true,
+                                                                    1000));
+    SplineChartItem *item = static_cast<SplineChartItem *>(animated->item());
+    XYAnimation *xyAnimation = animation(animated);
+
+    const QVector<QPointF> start = item->geometryPoints();
+    const QVector<QPointF> startControls = item->controlGeometryPoints();
+    series->replace(5, QPointF(5, 5));
+    animated->replace(5, QPointF(5, 5));
+    const QVector<QPointF> end = series->item()->geometryPoints();
+    const QVector<QPointF> endControls =
+            static_cast<SplineChartItem *>(series->item())->controlGeometryPoints();
+
+    QTRY_COMPARE(xyAnimation->state(), QAbstractAnimation::Running);
+    xyAnimation->pause();
+    const QPointF *controlBuffers[4];
+    QPainterPath previousPath;
+    QVector<QPointF> previousElements;
+    for (int frame = 0; frame < 4; frame++) {
+        const qreal progress = (frame + 1) / 8.0;
+        xyAnimation->setCurrentTime(qRound(1000 * progress));
+        xyAnimation->updateFrame();
+
+        const QVector<QPointF> points = lerp(start, end, progress);
+        const QVector<QPointF> controlPoints = lerp(startControls, endControls, progress);
+        QVERIFY(comparePoints(item->geometryPoints(), points));
+        const QVector<QPointF> frameControls = item->controlGeometryPoints();
+        QVERIFY(comparePoints(frameControls, controlPoints));
+        controlBuffers[frame] = frameControls.constData();
+
+        // The path has a curve for every segment in every frame, and its elements are moved in
+        // place without changing a copy taken of it in the previous frame
+        QVector<QPointF> elements;
+        elements.append(points.first());
+        for (int i = 1; i < points.count(); i++) {
+            elements << controlPoints.at(2 * i - 2) << controlPoints.at(2 * i - 1)
+                     << points.at(i);
+        }
+        QVERIFY(comparePoints(pathElements(item->path()), elements));
+        if (frame > 0)
+            QVERIFY(comparePoints(pathElements(previousPath), previousElements));
+        previousPath = item->path();
+        previousElements = elements;
+    }
+    QVERIFY(controlBuffers[1] != controlBuffers[0]);
+    QCOMPARE(controlBuffers[2], controlBuffers[0]);
+    QCOMPARE(controlBuffers[3], controlBuffers[1]);
+
+    xyAnimation->resume();
+    xyAnimation->setCurrentTime(xyAnimation->duration());
+    QCOMPARE(xyAnimation->state(), QAbstractAnimation::Stopped);
+    QVERIFY(comparePoints(item->geometryPoints(), end));
+    QVERIFY(comparePoints(item->controlGeometryPoints(), endControls));
+}
+
+QTEST_MAIN(tst_XYAnimation)
+#include "tst_xyanimation.moc"
@@ -0,0 +1,963 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt Charts module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <QtTest/QtTest>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QAbstractAxis>
+#include <QtCharts/QValueAxis>
+#include <QtCharts/QLogValueAxis>
+#include <QtCore/QThreadPool>
+#include <QtWidgets/QStyleOptionGraphicsItem>
+#include <QtGui/QPaintEngine>
+#include <private/qabstractseries_p.h>
+#include <private/qxyseries_p.h>
+#include <private/abstractdomain_p.h>
+#include <private/xydomain_p.h>
+#include <private/xlogydomain_p.h>
+#include <private/xychart_p.h>
+#include <private/xydecimator_p.h>
+#include <private/xyseriesbuffer_p.h>
+#include <private/xygeometryworkers_p.h>
+#include <private/linechartitem_p.h>
+#include <private/splinechartitem_p.h>
+#include <private/xypointlabels_p.h>
+#include <private/chartpresenter_p.h>
+
+QT_CHARTS_USE_NAMESPACE
+
+class tst_XYChart: public QObject
+{
+Q_OBJECT
+
+private Q_SLOTS:
+    void decimation();
+    void levelOfDetail();
+    void updateTransaction();
+    void logarithmicGaps();
+    void intermediateGeometry();
+    void parallelGeometry();
+    void lazyShape();
+    void polylineBatches();
+    void pointLabels();
+};
+
+// Line series giving access to its chart item
+class LineSeries : public QLineSeries
+{
+public:
+    XYChart *item() { return static_cast<XYChart *>(d_ptr->chartItem()); }
+    const XYSeriesBuffer &buffer() { return static_cast<QXYSeriesPrivate *>(d_ptr.data())->pointBuffer(); }
+    const QXYSeriesPrivate *d() { return static_cast<QXYSeriesPrivate *>(d_ptr.data()); }
+    ChartPresenter *presenter() { return d_ptr->presenter(); }
+};
+
+// Paint engine recording the text it is asked to draw
+class LabelEngine : public QPaintEngine
+{
+public:
+    LabelEngine() : QPaintEngine(QPaintEngine::AllFeatures) {}
+    bool begin(QPaintDevice *) { return true; }
+    bool end() { return true; }
+    void updateState(const QPaintEngineState &) {}
+    void drawPixmap(const QRectF &, const QPixmap &, const QRectF &) {}
+    void drawTextItem(const QPointF &, const QTextItem &textItem) { texts.append(textItem.text()); }
+    Type type() const { return QPaintEngine::User; }
+
+    QStringList texts;
+};
+
+// Paint device of the given size drawing through a LabelEngine
+class LabelDevice : public QPaintDevice
+{
+public:
+    LabelDevice(int width, int height) : m_width(width), m_height(height) {}
+    QPaintEngine *paintEngine() const { return &engine; }
+
+    mutable LabelEngine engine;
+
+protected:
+    int metric(PaintDeviceMetric metric) const
+    {
+        switch (metric) {
+        case PdmWidth:
+            return m_width;
+        case PdmHeight:
+            return m_height;
+        case PdmWidthMM:
+            return m_width * 254 / 960;
+        case PdmHeightMM:
+            return m_height * 254 / 960;
+        case PdmDpiX:
+        case PdmDpiY:
+        case PdmPhysicalDpiX:
+        case PdmPhysicalDpiY:
+            return 96;
+        case PdmDepth:
+            return 32;
+        case PdmNumColors:
+            return INT_MAX;
+        default:
+            return QPaintDevice::metric(metric);
+        }
+    }
+
+private:
+    int m_width;
+    int m_height;
+};
+
+// Compares two sets of geometry points exactly, gaps must be gaps in both
+static bool sameGeometry(const QVector<QPointF> &actual, const QVector<QPointF> &expected)
+{
+    if (actual.count() != expected.count()) {
+        qWarning() << "geometry has" << actual.count() << "points, expected" << expected.count();
+        return false;
+    }
+    for (int i = 0; i < actual.count(); i++) {
+        const QPointF &a = actual.at(i);
+        const QPointF &e = expected.at(i);
+        const bool sameX = a.x() == e.x() || (qIsNaN(a.x()) && qIsNaN(e.x()));
+        const bool sameY = a.y() == e.y() || (qIsNaN(a.y()) && qIsNaN(e.y()));
+        if (!sameX || !sameY) {
+            qWarning() << "geometry point" << i << "is" << a << "expected" << e;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Fills the parameters of a background geometry job for domain, without windowing or reduction
+static void geometryParameters(const AbstractDomain &domain, XYGeometryParameters &parameters)
+{
+    domain.geometryTransform(parameters.transform);
+    parameters.logarithmic = domain.logBases(parameters.logBaseX, parameters.logBaseY);
+    if (!parameters.logarithmic)
+        parameters.logBaseX = parameters.logBaseY = 0;
+    parameters.minX = domain.minX();
+    parameters.maxX = domain.maxX();
+    parameters.windowing = false;
+    parameters.buckets = 0;
+    parameters.columnSpan = 0;
+}
+
+// Compares the geometry points of the item of series with its points mapped one by one.
+// Points that cannot be mapped, such as non-positive values on a log axis, must be gaps.
+static bool compareGeometry(LineSeries *series)
+{
+    XYChart *item = series->item();
+    const QVector<QPointF> geometry = item->geometryPoints();
+    if (geometry.count() != series->count()) {
+        qWarning() << "geometry has" << geometry.count() << "points, series" << series->count();
+        return false;
+    }
+    for (int i = 0; i < geometry.count(); i++) {
+        bool ok;
+        const QPointF expected = item->domain()->calculateGeometryPoint(series->at(i), ok);
+        if (!ok) {
+            if (!qIsNaN(geometry.at(i).x()) && !qIsNaN(geometry.at(i).y())) {
+                qWarning() << "geometry point" << i << "is" << geometry.at(i) << "expected a gap";
+                return false;
+            }
+            continue;
+        }
+        if (qAbs(geometry.at(i).x() - expected.x()) > 1e-6
+                || qAbs(geometry.at(i).y() - expected.y()) > 1e-6) {
+            qWarning() << "geometry point" << i << "is" << geometry.at(i) << "expected" << expected;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Appends the reduced points of the bucket [start, stop) of points, scanning every point.
+// Buckets wider than columnSpan in x are split in halves down to the finest level,
+// where all their points are kept.
+static void reduceBucket(const QVector<QPointF> &points, int origin, int start, int stop,
+                         int shift, qreal columnSpan, qreal logBaseX, QVector<QPointF> &result)
+{
+    const qreal firstX = points.at(start - origin).x();
+    const qreal lastX = points.at(stop - 1 - origin).x();
+    const bool fits = logBaseX > 0
+            ? firstX > 0 && std::log(lastX / firstX) <= columnSpan * std::log(logBaseX)
+            : lastX - firstX <= columnSpan;
+    if (!fits) {
+        if (shift > XYSeriesLod::BaseShift) {
+            const int half = qMin(((start >> (shift - 1)) + 1) << (shift - 1), stop);
+            reduceBucket(points, origin, start, half, shift - 1, columnSpan, logBaseX, result);
+            if (half < stop)
+                reduceBucket(points, origin, half, stop, shift - 1, columnSpan, logBaseX, result);
+        } else {
+            for (int i = start; i < stop; i++)
+                result << points.at(i - origin);
+        }
+        return;
+    }
+
+    int minIndex = start;
+    int maxIndex = start;
+    for (int i = start + 1; i < stop; i++) {
+        if (points.at(i - origin).y() < points.at(minIndex - origin).y())
+            minIndex = i;
+        if (points.at(i - origin).y() > points.at(maxIndex - origin).y())
+            maxIndex = i;
+    }
+    const int lower = qMin(minIndex, maxIndex);
+    const int upper = qMax(minIndex, maxIndex);
+    result << points.at(start - origin);
+    if (lower > start)
+        result << points.at(lower - origin);
+    if (upper > lower)
+        result << points.at(upper - origin);
+    if (stop - 1 > upper)
+        result << points.at(stop - 1 - origin);
+}
+
+// Reduces count points from index of points the way XYSeriesLod does, scanning every bucket.
+// Buckets are aligned to the absolute index, which is origin for the first logical point.
+static QVector<QPointF> reducePoints(const QVector<QPointF> &points, int origin, int index,
+                                     int count, int buckets, qreal columnSpan, qreal logBaseX)
+{
+    if (count < (buckets << XYSeriesLod::BaseShift))
+        return QVector<QPointF>();
+
+    int shift = XYSeriesLod::BaseShift;
+    while ((count >> (shift + 1)) >= buckets)
+        shift++;
+
+    QVector<QPointF> result;
+    const int end = origin + index + count;
+    for (int start = origin + index; start < end;) {
+        const int stop = qMin(((start >> shift) + 1) << shift, end);
+        reduceBucket(points, origin, start, stop, shift, columnSpan, logBaseX, result);
+        start = stop;
+    }
+    return result;
+}
+
+// Checks that every point of points lies between the y values of two reduced points
+// that are at most columnSpan away from it in x, so that dropping it cannot change
+// the drawn pixels by more than one column.
+static bool coversPoints(const QVector<QPointF> &points, const QVector<QPointF> &reduced,
+                         qreal columnSpan)
+{
+    for (const QPointF &point : points) {
+        bool below = false;
+        bool above = false;
+        for (const QPointF &kept : reduced) {
+            if (qAbs(kept.x() - point.x()) > columnSpan)
+                continue;
+            below = below || kept.y() <= point.y();
+            above = above || kept.y() >= point.y();
+        }
+        if (!below || !above) {
+            qWarning() << "point" << point << "is not covered by the reduced points";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Compares the reduced points of buffer with a full scan over a few windows
+static bool compareReducedPoints(const XYSeriesBuffer &buffer, int origin,
+                                 qreal columnSpan = qInf(), qreal logBaseX = 0)
+{
+    const QVector<QPointF> points = buffer.toVector();
+    const int count = points.count();
+    const int windows[][3] = {
+        { 0, count, 100 },
+        { 123, count / 2, 37 },
+        { count / 3, 513, 32 },
+        { count - 700, 700, 5 },
+        { 17, 16 * 9 + 3, 9 },
+        { 0, 16 * 10 - 1, 10 }
+    };
+    for (const auto &window : windows) {
+        const QVector<QPointF> expected = reducePoints(points, origin, window[0], window[1],
+                                                       window[2], columnSpan, logBaseX);
+        const QVector<QPointF> actual = buffer.lod().reducedPoints(buffer, window[0], window[1],
+                                                                   window[2], columnSpan, logBaseX);
+        if (actual != expected) {
+            qWarning() << "reduced points differ for window" << window[0] << window[1] << window[2];
+            return false;
+        }
+    }
+    return true;
+}
+
+// Checks that the off-grid flags follow the geometry points and that the points of
+// the buffer the geometry was calculated from map to the geometry points.
+static bool compareGeometrySource(LineSeries *series)
+{
+    XYChart *item = series->item();
+    const QVector<QPointF> geometry = item->geometryPoints();
+    const QVector<bool> offGrid = item->offGridStatusVector();
+    const XYSeriesBuffer &source = item->geometrySource();
+    const QSizeF size = item->domain()->size();
+    const QRectF plotArea(-1e-6, -1e-6, size.width() + 2e-6, size.height() + 2e-6);
+    if (geometry.isEmpty() || offGrid.count() != geometry.count()
+            || item->firstIndex() + geometry.count() > source.count()) {
+        qWarning() << "geometry has" << geometry.count() << "points, flags" << offGrid.count()
+                   << "source" << source.count() << "first index" << item->firstIndex();
+        return false;
+    }
+    for (int i = 0; i < geometry.count(); i++) {
+        if (offGrid.at(i) == plotArea.contains(geometry.at(i))) {
+            qWarning() << "geometry point" << i << "is" << geometry.at(i) << "off grid" << offGrid.at(i);
+            return false;
+        }
+        bool ok;
+        const QPointF expected = item->domain()->calculateGeometryPoint(
+                    source.at(item->firstIndex() + i), ok);
+        if (!ok || qAbs(expected.x() - geometry.at(i).x()) > 1e-6
+                || qAbs(expected.y() - geometry.at(i).y()) > 1e-6) {
+            qWarning() << "geometry point" << i << "is" << geometry.at(i) << "expected" << expected;
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_XYChart::decimation()
+{
+    // Up to four points are returned as they are
+    QVector<QPointF> points;
+    points << QPointF(0.1, 5) << QPointF(0.2, 1) << QPointF(0.3, 9) << QPointF(0.4, 4);
+    QCOMPARE(XYDecimator::decimate(points), points);
+
+    // Each pixel column keeps its first, lowest, highest and last point in order
+    points.clear();
+    points << QPointF(0.1, 5) << QPointF(0.3, 1) << QPointF(0.4, 3) << QPointF(0.5, 9)
+           << QPointF(0.6, 6) << QPointF(0.7, 4)                        // column 0
+           << QPointF(1.2, 3) << QPointF(1.8, 7)                        // column 1
+           << QPointF(2.5, 2)                                           // column 2
+           << QPointF(3.0, 6) << QPointF(3.1, 8) << QPointF(3.2, 2)
+           << QPointF(3.3, 2) << QPointF(3.4, 5)                        // column 3
+           << QPointF(4.0, 1) << QPointF(4.5, 1) << QPointF(4.9, 1);    // column 4
+    QVector<QPointF> expected;
+    expected << QPointF(0.1, 5) << QPointF(0.3, 1) << QPointF(0.5, 9) << QPointF(0.7, 4)
+             << QPointF(1.2, 3) << QPointF(1.8, 7)
+             << QPointF(2.5, 2)
+             << QPointF(3.0, 6) << QPointF(3.1, 8) << QPointF(3.2, 2) << QPointF(3.4, 5)
+             << QPointF(4.0, 1) << QPointF(4.9, 1);
+    QCOMPARE(XYDecimator::decimate(points), expected);
+
+    // Negative x values fall into their own columns
+    points.clear();
+    points << QPointF(-0.5, 1) << QPointF(-0.4, 0) << QPointF(-0.2, 2) << QPointF(0.0, 3)
+           << QPointF(0.9, 0) << QPointF(0.95, 4);
+    expected.clear();
+    expected << QPointF(-0.5, 1) << QPointF(-0.4, 0) << QPointF(-0.2, 2) << QPointF(0.0, 3)
+             << QPointF(0.9, 0) << QPointF(0.95, 4);
+    QCOMPARE(XYDecimator::decimate(points), expected);
+    points.removeAt(1);
+    points.insert(1, QPointF(-0.4, 1.5));
+    expected.clear();
+    expected << QPointF(-0.5, 1) << QPointF(-0.2, 2) << QPointF(0.0, 3) << QPointF(0.9, 0)
+             << QPointF(0.95, 4);
+    QCOMPARE(XYDecimator::decimate(points), expected);
+
+    // A dense column is reduced to its first, lowest, highest and last point
+    points.clear();
+    for (int i = 0; i < 1000; i++)
+        points << QPointF(7 + i / 1000.0, qreal((i * 37) % 1000));
+    expected.clear();
+    expected << points.at(0) << points.at(27) << points.at(999);
+    QCOMPARE(expected.at(1).y(), qreal(999));
+    QCOMPARE(XYDecimator::decimate(points), expected);
+}
+
+void tst_XYChart::levelOfDetail()
+{
+    // Distinct y values, so that the extremes of every bucket are unique
+    QVector<QPointF> points;
+    for (int i = 0; i < 4096; i++)
+        points << QPointF(i, qreal((i * 7919) % 10007));
+
+    XYSeriesBuffer buffer;
+    buffer.setPoints(points);
+    QVERIFY(compareReducedPoints(buffer, 0));
+    QVERIFY(buffer.lod().reducedPoints(buffer, 0, 16 * 10 - 1, 10, qInf()).isEmpty());
+
+    // Appending and replacing update the pyramid in place
+    for (int i = 4096; i < 4196; i++)
+        buffer.append(QPointF(i, qreal((i * 7919) % 10007)));
+    buffer.replace(2000, QPointF(2000, 20000));
+    buffer.replace(2001, QPointF(2001, -1));
+    buffer.replace(4195, QPointF(4195, -2));
+    QVERIFY(compareReducedPoints(buffer, 0));
+
+    // Removing from the back and from the front keeps the absolute alignment
+    buffer.remove(buffer.count() - 50, 50);
+    QVERIFY(compareReducedPoints(buffer, 0));
+    buffer.remove(0, 300);
+    QVERIFY(compareReducedPoints(buffer, 300));
+
+    // Evicting from a full ring buffer advances the origin one point at a time
+    XYSeriesBuffer ring;
+    ring.setCapacity(2048);
+    ring.setPoints(points.mid(0, 2048));
+    QVERIFY(compareReducedPoints(ring, 0));
+    for (int i = 2048; i < 2348; i++)
+        QVERIFY(ring.append(points.at(i)));
+    QVERIFY(compareReducedPoints(ring, 300));
+
+    for (int i = 2348; i < 4096; i++)
+        ring.append(points.at(i));
+    QVERIFY(compareReducedPoints(ring, 2048));
+
+    // Once more points have been evicted than are left, the pyramid is rebuilt
+    ring.append(QPointF(4096, qreal((4096 * 7919) % 10007)));
+    QCOMPARE(ring.count(), 2048);
+    QCOMPARE(ring.at(0), points.at(2049));
+    QVERIFY(compareReducedPoints(ring, 0));
+
+    // Irregular x: dense runs of 500 points separated by sparse stretches of 12 points.
+    // Buckets reaching into a sparse stretch are wider than a pixel column and must be
+    // refined, down to single points, instead of merging the extremes of many columns.
+    QVector<QPointF> irregular;
+    qreal x = 1;
+    for (int i = 0; i < 4096; i++) {
+        x += i % 512 < 500 ? 0.01 : 50;
+        irregular << QPointF(x, qreal((i * 7919) % 10007));
+    }
+    XYSeriesBuffer sparse;
+    sparse.setPoints(irregular);
+    QVERIFY(compareReducedPoints(sparse, 0, 1));
+    const QVector<QPointF> reduced = sparse.lod().reducedPoints(sparse, 0, 4096, 100, 1);
+    QVERIFY(!reduced.isEmpty());
+    QVERIFY(reduced.count() < irregular.count());
+    QVERIFY(coversPoints(irregular, reduced, 1));
+
+    // On a log x axis the span of a bucket is measured in log units
+    QVERIFY(compareReducedPoints(sparse, 0, 0.001, 10));
+    const QVector<QPointF> logReduced = sparse.lod().reducedPoints(sparse, 0, 4096, 100, 0.001, 10);
+    QVERIFY(!logReduced.isEmpty());
+    QVERIFY(logReduced.count() < irregular.count());
+}
+
+void tst_XYChart::updateTransaction()
+{
+    QChartView view;
+    view.resize(400, 300);
+    LineSeries *series = new LineSeries;
+    for (int i = 0; i < 100; i++)
+        series->append(i, i % 10);
+    view.chart()->addSeries(series);
+    view.chart()->createDefaultAxes();
+    // The x range covers all points, so that the geometry is not windowed
+    QAbstractAxis *axisX = view.chart()->axes(Qt::Horizontal).first();
+    axisX->setRange(-10, 200);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    QVERIFY(compareGeometry(series));
+
+    // A domain change inside a transaction maps the points appended so far,
+    // the committed change must not add them a second time
+    series->beginUpdate();
+    for (int i = 100; i < 110; i++)
+        series->append(i, i % 10);
+    axisX->setRange(-10, 250);
+    series->endUpdate();
+    QVERIFY(compareGeometry(series));
+
+    // The same for removals
+    series->beginUpdate();
+    series->removePoints(0, 5);
+    axisX->setRange(-20, 250);
+    series->endUpdate();
+    QVERIFY(compareGeometry(series));
+
+    // Appending and removing from the front
+    series->beginUpdate();
+    series->append(110, 0);
+    series->append(111, 1);
+    series->removePoints(0, 2);
+    axisX->setRange(-20, 260);
+    series->endUpdate();
+    QVERIFY(compareGeometry(series));
+
+    // Single points
+    series->beginUpdate();
+    series->append(112, 2);
+    axisX->setRange(-20, 270);
+    series->endUpdate();
+    QVERIFY(compareGeometry(series));
+    series->beginUpdate();
+    series->remove(0);
+    axisX->setRange(-30, 270);
+    series->endUpdate();
+    QVERIFY(compareGeometry(series));
+
+    // Later changes outside of a transaction are applied incrementally again
+    series->append(113, 3);
+    series->replace(10, QPointF(15, 7));
+    series->remove(20);
+    QVERIFY(compareGeometry(series));
+}
+
+void tst_XYChart::logarithmicGaps()
+{
+    QChartView view;
+    view.resize(400, 300);
+    LineSeries *series = new LineSeries;
+    for (int i = 0; i < 100; i++)
+        series->append(i, i + 1);
+    view.chart()->addSeries(series);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(-10, 200);
+    QLogValueAxis *axisY = new QLogValueAxis;
+    axisY->setRange(0.5, 1000);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    QVERIFY(compareGeometry(series));
+
+    // Single non-positive values become gaps instead of clearing the geometry
+    series->append(100, 0);
+    QVERIFY(compareGeometry(series));
+    series->replace(50, QPointF(50, -3));
+    QVERIFY(compareGeometry(series));
+
+    // The geometry stays aligned with the series for later changes
+    series->replace(50, QPointF(50, 7));
+    series->append(101, 5);
+    series->insert(10, QPointF(9.5, 2));
+    series->remove(20);
+    QVERIFY(compareGeometry(series));
+}
+
+void tst_XYChart::intermediateGeometry()
+{
+    QChartView view;
+    view.resize(400, 300);
+    LineSeries *series = new LineSeries;
+    // Points are visible, so the geometry is not reduced and maps one to one to the series.
+    // Every other point is above the y range, so an index off by one flips every flag.
+    series->setPointsVisible(true);
+    QVector<QPointF> points;
+    for (int i = 0; i < 100000; i++)
+        points.append(QPointF(i, i % 2 ? 10 : 1000));
+    series->replace(points);
+    view.chart()->addSeries(series);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(1000, 2000);
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setRange(0, 100);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    QVERIFY(series->item()->firstIndex() > 0);
+    QVERIFY(compareGeometrySource(series));
+
+    // A removal while the background job runs shifts the live indices, the intermediate
+    // result is still shown and must be read against the snapshot it was calculated from
+    axisX->setRange(1000, 2100);
+    series->removePoints(0, 1);
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::sendPostedEvents(series->item(), QEvent::MetaCall);
+    QVERIFY(series->item()->geometrySource().revision() != series->buffer().revision());
+    QVERIFY(compareGeometrySource(series));
+
+    // The follow-up job brings the geometry to the live buffer
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::sendPostedEvents(series->item(), QEvent::MetaCall);
+    QCOMPARE(series->item()->geometrySource().revision(), series->buffer().revision());
+    QVERIFY(compareGeometrySource(series));
+}
+
+void tst_XYChart::parallelGeometry()
+{
+    // Enough threads for the chunks to be calculated concurrently; a single thread
+    // makes every calculation serial, which is the reference
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    const int parallelThreadCount = qMax(4, maxThreadCount);
+    pool->setMaxThreadCount(parallelThreadCount);
+
+    // Non-positive y values become gaps on the log axis, on both sides of chunk boundaries
+    const int chunk = XYGeometryWorkers::ChunkSize;
+    const int count = 3 * chunk + 123;
+    QVERIFY(XYGeometryWorkers::isParallel(count));
+    QVector<QPointF> points;
+    for (int i = 0; i < count; i++) {
+        const bool gap = i == chunk - 1 || i == chunk || i == 2 * chunk || i == 3 * chunk + 1;
+        points.append(QPointF(i, gap ? 0 : 1 + (i % 97) * 0.5));
+    }
+
+    XYDomain linear;
+    linear.setRange(-10, count + 10, -1, 60);
+    linear.setSize(QSizeF(640, 480));
+    XLogYDomain logarithmic;
+    logarithmic.setRange(-10, count + 10, 0.5, 60);
+    logarithmic.setSize(QSizeF(640, 480));
+    const AbstractDomain *domains[] = { &linear, &logarithmic };
+    const QXYSeries::StorageLayout layouts[] = {
+        QXYSeries::StorageLayoutPoints,
+        QXYSeries::StorageLayoutColumns,
+        QXYSeries::StorageLayoutUniformX
+    };
+
+    // Chunked geometry, both from the series and from a background job
+    for (QXYSeries::StorageLayout layout : layouts) {
+        LineSeries series;
+        series.setStorageLayout(layout);
+        series.replace(points);
+        for (const AbstractDomain *domain : domains) {
+            XYGeometryParameters parameters;
+            geometryParameters(*domain, parameters);
+
+            QVector<QPointF> parallel(count);
+            XYGeometryResult parallelResult;
+            QVERIFY(series.d()->calculateGeometryPoints(domain, 0, count, parallel.data()));
+            QVERIFY(XYGeometryJob::calculate(series.buffer(), parameters, parallelResult));
+
+            pool->setMaxThreadCount(1);
+            QVERIFY(!XYGeometryWorkers::isParallel(count));
+            QVector<QPointF> serial(count);
+            XYGeometryResult serialResult;
+            QVERIFY(series.d()->calculateGeometryPoints(domain, 0, count, serial.data()));
+            QVERIFY(XYGeometryJob::calculate(series.buffer(), parameters, serialResult));
+            pool->setMaxThreadCount(parallelThreadCount);
+
+            QVERIFY(sameGeometry(parallel, serial));
+            QVERIFY(sameGeometry(parallelResult.points, serialResult.points));
+            if (domain == &logarithmic) {
+                QVERIFY(qIsNaN(parallel.at(chunk).y()));
+                QVERIFY(qIsNaN(parallelResult.points.at(2 * chunk).y()));
+            }
+        }
+    }
+
+    // Spline control points, the x and y systems of long runs are solved concurrently
+    QVector<QPointF> splinePoints;
+    for (int i = 0; i < 2 * chunk + 300; i++)
+        splinePoints.append(QPointF(i, ((i * 7919) % 10007) * 0.01));
+    QVector<QPointF> gappedSplinePoints = splinePoints;
+    gappedSplinePoints[chunk + 100] = QPointF(chunk + 100, qQNaN());
+    for (const QVector<QPointF> &input : { splinePoints, gappedSplinePoints }) {
+        const QVector<QPointF> parallel = SplineChartItem::calculateControlPoints(input);
+        pool->setMaxThreadCount(1);
+        const QVector<QPointF> serial = SplineChartItem::calculateControlPoints(input);
+        pool->setMaxThreadCount(parallelThreadCount);
+        QVERIFY(sameGeometry(parallel, serial));
+    }
+
+    // Shape path: the outline is stroked in chunks, which must hit the same points as
+    // a single stroke. A long gap covers the first chunk boundary and a single one the
+    // second, the third boundary joins two chunk outlines.
+    QChartView view;
+    view.resize(400, 300);
+    LineSeries *series = new LineSeries;
+    const int lineCount = 3 * chunk + 2000;
+    QVector<QPointF> linePoints;
+    for (int i = 0; i < lineCount; i++) {
+        const bool gap = (i >= chunk - 400 && i < chunk + 3600) || i == 2 * chunk;
+        linePoints.append(QPointF(i, gap ? qQNaN() : i * 100.0 / lineCount));
+    }
+    series->replace(linePoints);
+    view.chart()->addSeries(series);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(-10, lineCount + 10);
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setRange(-10, 110);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+    connect(series, &QXYSeries::clicked, this, [](const QPointF &) {});
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+    pool->waitForDone();
+    QCoreApplication::processEvents();
+
+    LineChartItem *item = static_cast<LineChartItem *>(series->item());
+    const QVector<QPointF> pathPoints = item->pathPoints();
+    QCOMPARE(pathPoints.count(), lineCount);
+    const QPainterPath parallelShape = item->shape();
+
+    pool->setMaxThreadCount(1);
+    series->replace(linePoints);
+    pool->waitForDone();
+    QCoreApplication::processEvents();
+    QVERIFY(sameGeometry(item->pathPoints(), pathPoints));
+    const QPainterPath serialShape = item->shape();
+    pool->setMaxThreadCount(maxThreadCount);
+
+    QVector<int> probes;
+    for (int i = 0; i < lineCount; i += 250)
+        probes.append(i);
+    probes << chunk + 3600 << 2 * chunk - 1 << 2 * chunk + 1 << 3 * chunk - 1 << 3 * chunk;
+    for (int i : probes) {
+        const QPointF point = pathPoints.at(i);
+        if (qIsNaN(point.y()))
+            continue;
+        QVERIFY2(parallelShape.contains(point), qPrintable(QString::number(i)));
+        QVERIFY2(serialShape.contains(point), qPrintable(QString::number(i)));
+        const QPointF above = point - QPointF(0, 20);
+        QVERIFY(!parallelShape.contains(above));
+        QVERIFY(!serialShape.contains(above));
+    }
+
+    // Nothing is hit inside the long gap
+    bool ok;
+    const QPointF inGap = item->domain()->calculateGeometryPoint(
+                QPointF(chunk + 1600, (chunk + 1600) * 100.0 / lineCount), ok);
+    QVERIFY(ok);
+    QVERIFY(!parallelShape.contains(inGap));
+    QVERIFY(!serialShape.contains(inGap));
+}
+
+void tst_XYChart::lazyShape()
+{
+    QChartView view;
+    view.resize(400, 300);
+    LineSeries *series = new LineSeries;
+    series->setPen(QPen(Qt::black, 4));
+    for (int i = 0; i < 100; i++)
+        series->append(i, i % 2);
+    view.chart()->addSeries(series);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(-10, 110);
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setRange(-5, 15);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+
+    LineChartItem *item = static_cast<LineChartItem *>(series->item());
+    QPainterPathStroker stroker(series->pen());
+
+    // Nothing is connected to the interaction signals, so the item takes no part in hit testing
+    QVERIFY(item->shape().isEmpty());
+    QVERIFY(!item->boundingRect().isEmpty());
+    QVERIFY(item->boundingRect().contains(stroker.createStroke(item->path()).boundingRect()));
+
+    // Connecting clicked() builds the outline of the line on demand
+    QMetaObject::Connection clicked = connect(series, &QXYSeries::clicked, this, [](const QPointF &) {});
+    QPainterPath shape = item->shape();
+    QVERIFY(!shape.isEmpty());
+    QVector<QPointF> points = item->geometryPoints();
+    QCOMPARE(points.count(), series->count());
+    for (int i = 0; i < points.count(); i++) {
+        QVERIFY(shape.contains(points.at(i)));
+        if (i > 0)
+            QVERIFY(shape.contains((points.at(i - 1) + points.at(i)) / 2));
+    }
+    const QPointF oldPoint = points.at(50);
+    QVERIFY(!shape.contains(oldPoint - QPointF(0, 50)));
+
+    // Replacing the points rebuilds the outline at the new points
+    QVector<QPointF> replacement;
+    for (int i = 0; i < 100; i++)
+        replacement.append(QPointF(i, 10 + i % 2));
+    series->replace(replacement);
+    shape = item->shape();
+    points = item->geometryPoints();
+    QCOMPARE(points.count(), replacement.count());
+    for (const QPointF &point : points)
+        QVERIFY(shape.contains(point));
+    QVERIFY(!shape.contains(oldPoint));
+    QVERIFY(item->boundingRect().contains(stroker.createStroke(item->path()).boundingRect()));
+
+    // Only interaction receivers matter, hovered() counts as well
+    disconnect(clicked);
+    QVERIFY(item->shape().isEmpty());
+    connect(series, &QXYSeries::hovered, this, [](const QPointF &, bool) {});
+    QVERIFY(item->shape().contains(points.at(50)));
+}
+
+void tst_XYChart::polylineBatches()
+{
+    QChartView view;
+    view.resize(1000, 300);
+    LineSeries *series = new LineSeries;
+    QPen pen(Qt::black, 1);
+    pen.setCosmetic(true);
+    series->setPen(pen);
+    // A zigzag of more points than fit into one batch, with runs of points on one pixel
+    // and gaps on both sides of the first batch boundary
+    const int count = 2600;
+    QVector<QPointF> points;
+    for (int i = 0; i < count; i++) {
+        const bool gap = i == 1000 || i == 2040 || (i >= 2300 && i < 2303);
+        points.append(QPointF(i, gap ? qQNaN() : (i % 2 ? 2 : 8)));
+        if (i % 97 == 0) {
+            for (int j = 1; j < 6; j++)
+                points.append(QPointF(i, (i % 2 ? 2 : 8) + j * 1e-5));
+        }
+    }
+    series->replace(points);
+    view.chart()->addSeries(series);
+    QValueAxis *axisX = new QValueAxis;
+    axisX->setRange(-10, count + 10);
+    QValueAxis *axisY = new QValueAxis;
+    axisY->setRange(0, 10);
+    view.chart()->addAxis(axisX, Qt::AlignBottom);
+    view.chart()->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisX);
+    series->attachAxis(axisY);
+    view.show();
+    QTest::qWaitForWindowShown(&view);
+
+    LineChartItem *item = static_cast<LineChartItem *>(series->item());
+    QCOMPARE(item->pathPoints().count(), points.count());
+
+    // Stretch x so that every segment of the zigzag is a few pixels apart from the next
+    const qreal stretch = 10;
+    const QSizeF size = item->domain()->size();
+    QImage polylines(qCeil(size.width() * stretch) + 1, qCeil(size.height()) + 1, QImage::Format_RGB32);
+    QImage path(polylines.size(), QImage::Format_RGB32);
+    polylines.fill(Qt::white);
+    path.fill(Qt::white);
+
+    QPainter painter(&polylines);
+    painter.scale(stretch, 1);
+    QStyleOptionGraphicsItem option;
+    item->paint(&painter, &option, 0);
+    painter.end();
+
+    painter.begin(&path);
+    painter.scale(stretch, 1);
+    painter.setPen(pen);
+    painter.drawPath(item->path());
+    painter.end();
+
+    // Every pixel drawn by one must be drawn, at most one pixel away, by the other, so
+    // no segment is lost at batch boundaries and nothing is drawn across the gaps
+    const auto covered = [](const QImage &image, const QImage &reference) {
+        for (int y = 0; y < image.height(); y++) {
+            const QRgb *line = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+            for (int x = 0; x < image.width(); x++) {
+                if (qGray(line[x]) > 128)
+                    continue;
+                bool found = false;
+                for (int ry = qMax(0, y - 1); !found && ry <= qMin(reference.height() - 1, y + 1); ry++) {
+                    const QRgb *referenceLine = reinterpret_cast<const QRgb *>(reference.constScanLine(ry));
+                    for (int rx = qMax(0, x - 1); !found && rx <= qMin(reference.width() - 1, x + 1); rx++)
+                        found = qGray(referenceLine[rx]) <= 128;
+                }
+                if (!found) {
+                    qWarning() << "pixel" << x << y << "differs";
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    QVERIFY(covered(path, polylines));
+    QVERIFY(covered(polylines, path));
+}
+
+void tst_XYChart::pointLabels()
+{
+    QChartView view;
+    LineSeries *series = new LineSeries;
+    series->append(0, 0);
+    view.chart()->addSeries(series);
+    ChartPresenter *presenter = series->presenter();
+    QVERIFY(presenter);
+
+    QVector<QPointF> data;
+    for (int i = 0; i < 1000; i++)
+        data.append(QPointF(i, i * 2));
+    XYSeriesBuffer buffer;
+    buffer.setPoints(data);
+
+    LabelDevice device(400, 300);
+    QPainter painter(&device);
+    QStringList &texts = device.engine.texts;
+
+    // Geometry points 50 pixels apart, only the labels of the first nine reach into the device
+    // and only the points near it are formatted
+    QVector<QPointF> points;
+    for (int i = 0; i < data.count(); i++)
+        points.append(QPointF(i * 50, 150));
+    XYPointLabels labels;
+    labels.draw(&painter, presenter, buffer, points, 0, 5, QStringLiteral("@xPoint"));
+    QCOMPARE(texts.count(), 9);
+    QCOMPARE(texts.first(), QStringLiteral("0"));
+    QCOMPARE(texts.last(), QStringLiteral("8"));
+    QVERIFY(labels.cachedLabelCount() <= 11);
+    labels.draw(&painter, presenter, buffer, points, 0, 5, QStringLiteral("@xPoint"));
+    QVERIFY(labels.cachedLabelCount() <= 11);
+
+    // Labels overlapping a label already drawn are skipped
+    texts.clear();
+    labels.draw(&painter, presenter, buffer, QVector<QPointF>(100, QPointF(200, 150)), 0, 5,
+                QStringLiteral("@xPoint"));
+    QCOMPARE(texts, QStringList() << QStringLiteral("0"));
+
+    // The cache is kept while nothing changes and cleared when the format, the font or
+    // the data revision changes
+    QVector<QPointF> spaced;
+    for (int i = 0; i < 5; i++)
+        spaced.append(QPointF(50 + i * 70, 150));
+    XYPointLabels cache;
+    cache.draw(&painter, presenter, buffer, spaced, 0, 5, QStringLiteral("@xPoint"));
+    QCOMPARE(cache.cachedLabelCount(), 5);
+    cache.draw(&painter, presenter, buffer, spaced, 100, 5, QStringLiteral("@xPoint"));
+    QCOMPARE(cache.cachedLabelCount(), 10);
+    cache.draw(&painter, presenter, buffer, spaced, 200, 5, QStringLiteral("@yPoint"));
+    QCOMPARE(cache.cachedLabelCount(), 5);
+    QFont font = painter.font();
+    font.setPixelSize(30);
+    painter.setFont(font);
+    cache.draw(&painter, presenter, buffer, spaced, 300, 5, QStringLiteral("@yPoint"));
+    QCOMPARE(cache.cachedLabelCount(), 5);
+    buffer.replace(0, QPointF(0, -1));
+    cache.draw(&painter, presenter, buffer, spaced, 400, 5, QStringLiteral("@yPoint"));
+    QCOMPARE(cache.cachedLabelCount(), 5);
+
+    // A label with a three digit exponent, wider than those of most numbers, still reaches
+    // one pixel into the device from a point outside of it
+    texts.clear();
+    painter.setFont(QFont());
+    const QString text = presenter->numberToString(-1.23456e+123);
+    const int width = QFontMetrics(painter.font()).width(text);
+    XYSeriesBuffer wide;
+    wide.setPoints(QVector<QPointF>() << QPointF(0, -1.23456e+123));
+    XYPointLabels wideLabels;
+    wideLabels.draw(&painter, presenter, wide, QVector<QPointF>() << QPointF(1 - width / 2.0, 150),
+                    0, 5, QStringLiteral("@yPoint"));
+    QCOMPARE(texts, QStringList() << text);
+}
+
+QTEST_MAIN(tst_XYChart)
+#include "tst_xychart.moc"